@@ -0,0 +1,352 @@
+/*
+ * BinaryFormat.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#include "BinaryFormat.h"
+
+#define BINARY_FORMAT_MAGIC "T-REX-NN"
+#define BINARY_FORMAT_BYTE_ORDER_MARK 0x01020304
+#define BINARY_FORMAT_ALIGNMENT 64
+
+#define BINARY_FORMAT_CHECKSUM_OFFSET_BASIS UINT64_C(0xcbf29ce484222325)
+#define BINARY_FORMAT_CHECKSUM_PRIME UINT64_C(0x100000001b3)
+
+//64-bit FNV-1a applied to whole words
+uint64_t computeBinaryFormatChecksum(const uint64_t *wordArray, size_t numberOfWords)
+{
+	uint64_t checksum = BINARY_FORMAT_CHECKSUM_OFFSET_BASIS;
+
+	for (size_t i=0; i<numberOfWords; i++)
+	{
+		checksum ^= wordArray[i];
+		checksum *= BINARY_FORMAT_CHECKSUM_PRIME;
+	}
+
+	return checksum;
+}
+
+static void releaseMappedLayerRegion(void *layerRegion, size_t layerRegionSize)
+{
+	munmap(layerRegion, layerRegionSize);
+}
+
+static void releaseAllocatedLayerRegion(void *layerRegion, size_t layerRegionSize)
+{
+	(void) layerRegionSize;
+
+	free(layerRegion);
+}
+
+//Read exactly size bytes from the given offset of the file
+static bool readFileData(int fileDescriptor, void *buffer, size_t size, off_t offset)
+{
+	unsigned char *cursor = buffer;
+	bool isReadOk = true;
+
+	while ((size>0) && (isReadOk))
+	{
+		ssize_t result = pread(fileDescriptor, cursor, size, offset);
+
+		if (result<=0)
+		{
+			isReadOk = false;
+		}
+		else
+		{
+			cursor += result;
+			size -= (size_t) result;
+			offset += result;
+		}
+	}
+
+	return isReadOk;
+}
+
+//The hidden layer widths follow the header
+static inline uint64_t getLayerRegionMinimumOffset(uint32_t version, uint32_t numberOfHiddenLayers)
+{
+	uint64_t minimumOffset = sizeof(BinaryFormatHeader);
+
+	if (version>=BINARY_FORMAT_HIDDEN_LAYER_WIDTH_VERSION)
+		minimumOffset += sizeof(uint32_t) * (uint64_t) numberOfHiddenLayers;
+
+	return minimumOffset;
+}
+
+static bool isValidHeader(const BinaryFormatHeader *myHeader, off_t fileSize)
+{
+	bool isValid = (memcmp(myHeader->magic, BINARY_FORMAT_MAGIC, sizeof(myHeader->magic))==0) &&
+				   (myHeader->version>=1) && (myHeader->version<=BINARY_FORMAT_VERSION) &&
+				   (myHeader->byteOrderMark==BINARY_FORMAT_BYTE_ORDER_MARK) &&
+				   (myHeader->numberOfInputs>0) && (myHeader->numberOfInputs<=INT_MAX) &&
+				   (myHeader->numberOfHiddenLayers>0) && (myHeader->numberOfHiddenLayers<=INT_MAX) &&
+				   (myHeader->numberOfOutputs>0) && (myHeader->numberOfOutputs<=INT_MAX) &&
+				   ((myHeader->flags & ~(uint32_t) BINARY_FORMAT_KNOWN_FLAGS)==0) &&
+				   (myHeader->layerRegionOffset>=getLayerRegionMinimumOffset(myHeader->version, myHeader->numberOfHiddenLayers)) &&
+				   ((myHeader->layerRegionSize % sizeof(uint64_t))==0) &&
+				   (myHeader->layerRegionOffset<=(uint64_t) fileSize) &&
+				   (myHeader->layerRegionSize<=(uint64_t) fileSize - myHeader->layerRegionOffset);
+
+	return isValid;
+}
+
+bool isBinaryFormatFile(const char *filePath)
+{
+	bool isBinaryFormat = false;
+
+	if (filePath!=NULL)
+	{
+		size_t pathLength = strlen(filePath);
+		size_t extensionLength = strlen(BINARY_FORMAT_FILE_EXTENSION);
+
+		isBinaryFormat = (pathLength>=extensionLength) && (strcmp(filePath + pathLength - extensionLength, BINARY_FORMAT_FILE_EXTENSION)==0);
+	}
+
+	return isBinaryFormat;
+}
+
+/*The layer region is mapped copy-on-write, so the neural network is ready for inference without
+ *parsing or copying the weights, and only the pages changed by a mutation are copied*/
+NeuralNetworkErrorCode loadBinaryNeuralNetwork(const char *filePath, NeuralNetwork **myNeuralNetwork)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	BinaryFormatHeader myHeader;
+	struct stat fileStatus;
+
+	int fileDescriptor = -1;
+	void *layerRegion = NULL;
+	NeuralNetworkReleaseFunction releaseFunction = NULL;
+
+	uint32_t *storedWidthArray = NULL;
+	int *hiddenLayerWidthArray = NULL;
+
+	if ((filePath==NULL) || (myNeuralNetwork==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	//Open file
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		fileDescriptor = open(filePath, O_RDONLY);
+
+		if (fileDescriptor<0)
+			returnValue = NEURAL_NETWORK_FILE_LOAD_ERROR;
+	}
+
+	//Read header
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		if ((fstat(fileDescriptor, &fileStatus)!=0) || (!readFileData(fileDescriptor, &myHeader, sizeof(myHeader), 0)))
+			returnValue = NEURAL_NETWORK_FILE_LOAD_ERROR;
+		else if (!isValidHeader(&myHeader, fileStatus.st_size))
+			returnValue = NEURAL_NETWORK_FILE_FORMAT_ERROR;
+	}
+
+	//Read the hidden layer widths, a NULL width array gives hidden layers as wide as the input layer
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myHeader.version>=BINARY_FORMAT_HIDDEN_LAYER_WIDTH_VERSION))
+	{
+		storedWidthArray = malloc(sizeof(uint32_t) * myHeader.numberOfHiddenLayers);
+		hiddenLayerWidthArray = malloc(sizeof(int) * myHeader.numberOfHiddenLayers);
+
+		if ((storedWidthArray==NULL) || (hiddenLayerWidthArray==NULL))
+			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+		else if (!readFileData(fileDescriptor, storedWidthArray, sizeof(uint32_t) * myHeader.numberOfHiddenLayers, sizeof(BinaryFormatHeader)))
+			returnValue = NEURAL_NETWORK_FILE_LOAD_ERROR;
+
+		for (uint32_t i=0; (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (i<myHeader.numberOfHiddenLayers); i++)
+		{
+			if (storedWidthArray[i]>INT_MAX)
+				returnValue = NEURAL_NETWORK_FILE_FORMAT_ERROR;
+			else
+				hiddenLayerWidthArray[i] = (int) storedWidthArray[i];
+		}
+	}
+
+	//Map the layer region
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		long pageSize = sysconf(_SC_PAGESIZE);
+
+		if ((pageSize>0) && ((myHeader.layerRegionOffset % (uint64_t) pageSize)==0) && (myHeader.layerRegionSize>0))
+		{
+			layerRegion = mmap(NULL, myHeader.layerRegionSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileDescriptor, (off_t) myHeader.layerRegionOffset);
+
+			if (layerRegion==MAP_FAILED)
+				layerRegion = NULL;
+			else
+				releaseFunction = releaseMappedLayerRegion;
+		}
+	}
+
+	//Read the layer region if it can not be mapped
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (layerRegion==NULL))
+	{
+		size_t bufferSize = (myHeader.layerRegionSize + BINARY_FORMAT_ALIGNMENT - 1) / BINARY_FORMAT_ALIGNMENT * BINARY_FORMAT_ALIGNMENT;
+
+		layerRegion = aligned_alloc(BINARY_FORMAT_ALIGNMENT, (bufferSize>0) ? bufferSize : BINARY_FORMAT_ALIGNMENT);
+
+		if (layerRegion==NULL)
+			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+		else
+			releaseFunction = releaseAllocatedLayerRegion;
+
+		if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (!readFileData(fileDescriptor, layerRegion, myHeader.layerRegionSize, (off_t) myHeader.layerRegionOffset)))
+			returnValue = NEURAL_NETWORK_FILE_LOAD_ERROR;
+	}
+
+	//Check the weights
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		if (computeBinaryFormatChecksum(layerRegion, myHeader.layerRegionSize / sizeof(uint64_t))!=myHeader.checksum)
+			returnValue = NEURAL_NETWORK_FILE_CHECKSUM_ERROR;
+	}
+
+	//The neural network uses the layer region in place and releases it when it is destroyed
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		NeuralNetworkConnectivity connectivity = (myHeader.flags & BINARY_FORMAT_FLAG_SPARSE) ? NEURAL_NETWORK_CONNECTIVITY_SPARSE : NEURAL_NETWORK_CONNECTIVITY_DENSE;
+
+		returnValue = createNeuralNetworkFromLayerRegion(myNeuralNetwork, (int) myHeader.numberOfInputs, (int) myHeader.numberOfHiddenLayers, hiddenLayerWidthArray,
+														 (int) myHeader.numberOfOutputs, connectivity, layerRegion, myHeader.layerRegionSize, releaseFunction);
+	}
+
+	if ((returnValue!=NEURAL_NETWORK_RETURN_VALUE_OK) && (layerRegion!=NULL))
+		releaseFunction(layerRegion, myHeader.layerRegionSize);
+
+	//The neural network keeps its own copy of the hidden layer widths
+	free(storedWidthArray);
+	free(hiddenLayerWidthArray);
+
+	//The mapping is kept after the file is closed
+	if (fileDescriptor>=0)
+		close(fileDescriptor);
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode saveBinaryNeuralNetwork(const char *filePath, NeuralNetwork *myNeuralNetwork)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	static const unsigned char paddingArray[BINARY_FORMAT_PAGE_SIZE] = {0};
+
+	BinaryFormatHeader myHeader;
+	NeuronData *dummy;
+
+	const void *layerRegion = NULL;
+	size_t layerRegionSize = 0;
+
+	const int *hiddenLayerWidthArray = NULL;
+	uint32_t *storedWidthArray = NULL;
+
+	int numberOfInputs = 0;
+	int numberOfHiddenLayers = 0;
+	int numberOfOutputs = 0;
+
+	NeuralNetworkConnectivity connectivity = NEURAL_NETWORK_CONNECTIVITY_DENSE;
+
+	FILE *myFile = NULL;
+
+	if ((filePath==NULL) || (myNeuralNetwork==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	//Get the topology and the layer region
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getInputLayer(myNeuralNetwork, &dummy, &numberOfInputs);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getHiddenLayerWidthArray(myNeuralNetwork, &hiddenLayerWidthArray, &numberOfHiddenLayers);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getNeuralNetworkNumberOfOutputs(myNeuralNetwork, &numberOfOutputs);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getNeuralNetworkConnectivity(myNeuralNetwork, &connectivity);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getNeuralNetworkLayerRegion(myNeuralNetwork, &layerRegion, &layerRegionSize);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		storedWidthArray = malloc(sizeof(uint32_t) * numberOfHiddenLayers);
+
+		if (storedWidthArray==NULL)
+			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+		else
+		{
+			for (int i=0; i<numberOfHiddenLayers; i++)
+				storedWidthArray[i] = (uint32_t) hiddenLayerWidthArray[i];
+		}
+	}
+
+	//Create header
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		memset(&myHeader, 0, sizeof(myHeader));
+		memcpy(myHeader.magic, BINARY_FORMAT_MAGIC, sizeof(myHeader.magic));
+
+		myHeader.version = BINARY_FORMAT_VERSION;
+		myHeader.byteOrderMark = BINARY_FORMAT_BYTE_ORDER_MARK;
+		myHeader.numberOfInputs = (uint32_t) numberOfInputs;
+		myHeader.numberOfHiddenLayers = (uint32_t) numberOfHiddenLayers;
+		myHeader.numberOfOutputs = (uint32_t) numberOfOutputs;
+		myHeader.flags = (connectivity==NEURAL_NETWORK_CONNECTIVITY_SPARSE) ? BINARY_FORMAT_FLAG_SPARSE : 0;
+		//The layer region starts at the first page boundary after the hidden layer widths
+		myHeader.layerRegionOffset = (getLayerRegionMinimumOffset(BINARY_FORMAT_VERSION, numberOfHiddenLayers) + BINARY_FORMAT_PAGE_SIZE - 1) / BINARY_FORMAT_PAGE_SIZE * BINARY_FORMAT_PAGE_SIZE;
+		myHeader.layerRegionSize = layerRegionSize;
+		myHeader.checksum = computeBinaryFormatChecksum(layerRegion, layerRegionSize / sizeof(uint64_t));
+	}
+
+	//Create file
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		myFile = fopen(filePath, "wb");
+
+		if (myFile==NULL)
+			returnValue = NEURAL_NETWORK_FILE_SAVE_ERROR;
+	}
+
+	//Write the header and the hidden layer widths
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		if ((fwrite(&myHeader, sizeof(myHeader), 1, myFile)!=1) ||
+			(fwrite(storedWidthArray, sizeof(uint32_t), numberOfHiddenLayers, myFile)!=(size_t) numberOfHiddenLayers))
+
+			returnValue = NEURAL_NETWORK_FILE_SAVE_ERROR;
+	}
+
+	//Write the padding up to the layer region and the layer region
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		size_t paddingSize = myHeader.layerRegionOffset - getLayerRegionMinimumOffset(BINARY_FORMAT_VERSION, numberOfHiddenLayers);
+
+		while ((paddingSize>0) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK))
+		{
+			size_t chunkSize = (paddingSize<sizeof(paddingArray)) ? paddingSize : sizeof(paddingArray);
+
+			if (fwrite(paddingArray, chunkSize, 1, myFile)!=1)
+				returnValue = NEURAL_NETWORK_FILE_SAVE_ERROR;
+
+			paddingSize -= chunkSize;
+		}
+
+		if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (fwrite(layerRegion, layerRegionSize, 1, myFile)!=1))
+			returnValue = NEURAL_NETWORK_FILE_SAVE_ERROR;
+	}
+
+	//Close file
+	if (myFile!=NULL)
+	{
+		int result = fclose(myFile);
+
+		if ((result==EOF) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK))
+			returnValue = NEURAL_NETWORK_FILE_SAVE_ERROR;
+	}
+
+	free(storedWidthArray);
+
+	return returnValue;
+}
@@ -0,0 +1,58 @@
+/*
+ * BinaryFormat.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#ifndef SRC_DATA_TIER_BINARYFORMAT_H_
+#define SRC_DATA_TIER_BINARYFORMAT_H_
+
+#include "../logic_tier/NeuralNetwork.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define BINARY_FORMAT_FILE_EXTENSION ".trex"
+#define BINARY_FORMAT_VERSION 3
+
+//First version that stores the width of each hidden layer, the older files have hidden layers as wide as the input layer
+#define BINARY_FORMAT_HIDDEN_LAYER_WIDTH_VERSION 2
+
+//Header flags, the older files have no flags set
+#define BINARY_FORMAT_FLAG_SPARSE 0x1
+#define BINARY_FORMAT_KNOWN_FLAGS BINARY_FORMAT_FLAG_SPARSE
+
+/*The layer region starts at this offset, so it can be memory-mapped on systems with pages of up
+ *to this size. On systems with larger pages the layer region is read into memory instead*/
+#define BINARY_FORMAT_PAGE_SIZE 4096
+
+/*A binary model file holds a header, the number of neurons of each hidden layer as 32-bit values
+ *and the layer region of the neural network, which is the bit-packed weights of each neuron, layer
+ *by layer, with a small header per layer and neuron. The neurons of a sparse neural network also
+ *store their connections. All the values are stored in the byte order of
+ *the machine that saved the file. The checksum is computed over the layer region*/
+typedef struct
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t byteOrderMark;
+	uint32_t numberOfInputs;
+	uint32_t numberOfHiddenLayers;
+	uint32_t numberOfOutputs;
+	uint32_t flags;
+	uint64_t layerRegionOffset;
+	uint64_t layerRegionSize;
+	uint64_t checksum;
+} BinaryFormatHeader;
+
+uint64_t computeBinaryFormatChecksum(const uint64_t *wordArray, size_t numberOfWords);
+bool isBinaryFormatFile(const char *filePath);
+NeuralNetworkErrorCode loadBinaryNeuralNetwork(const char *filePath, NeuralNetwork **myNeuralNetwork);
+NeuralNetworkErrorCode saveBinaryNeuralNetwork(const char *filePath, NeuralNetwork *myNeuralNetwork);
+
+#endif /* SRC_DATA_TIER_BINARYFORMAT_H_ */
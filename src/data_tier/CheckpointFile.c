@@ -0,0 +1,308 @@
+/*
+ * CheckpointFile.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#include "CheckpointFile.h"
+
+#define CHECKPOINT_FILE_MAGIC "T-REX-CK"
+#define CHECKPOINT_FILE_BYTE_ORDER_MARK 0x01020304
+
+/*The buffer holds the checkpoint being written while isWritePending is true, and then it is only
+ *used by the thread. The other fields are only used with the mutex locked. The result of a failed
+ *write is returned by the next call to writeCheckpoint and by destroyCheckpointWriter*/
+typedef struct checkpointWriter
+{
+	char *filePath;
+	char *temporaryFilePath;
+	pthread_t thread;
+	pthread_mutex_t mutex;
+	pthread_cond_t writeRequestCondition;
+	unsigned char *buffer;
+	size_t bufferCapacity;
+	size_t checkpointSize;
+	bool isWritePending;
+	bool isShuttingDown;
+	NeuralNetworkErrorCode writeResult;
+} CheckpointWriter;
+
+/*The checkpoint is written to a temporary file that replaces the checkpoint file once it is complete,
+ *so a crash while writing leaves the previous checkpoint*/
+static NeuralNetworkErrorCode saveCheckpointFile(const char *filePath, const char *temporaryFilePath, const unsigned char *checkpoint, size_t checkpointSize)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	CheckpointFileHeader myHeader;
+
+	FILE *myFile = fopen(temporaryFilePath, "wb");
+
+	if (myFile==NULL)
+		returnValue = NEURAL_NETWORK_FILE_SAVE_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		memset(&myHeader, 0, sizeof(myHeader));
+		memcpy(myHeader.magic, CHECKPOINT_FILE_MAGIC, sizeof(myHeader.magic));
+
+		myHeader.version = CHECKPOINT_FILE_VERSION;
+		myHeader.byteOrderMark = CHECKPOINT_FILE_BYTE_ORDER_MARK;
+		myHeader.checkpointSize = checkpointSize;
+		myHeader.checksum = computeBinaryFormatChecksum((const uint64_t *) checkpoint, checkpointSize / sizeof(uint64_t));
+
+		if ((fwrite(&myHeader, sizeof(myHeader), 1, myFile)!=1) || (fwrite(checkpoint, checkpointSize, 1, myFile)!=1) ||
+			(fflush(myFile)==EOF) || (fsync(fileno(myFile))!=0))
+
+			returnValue = NEURAL_NETWORK_FILE_SAVE_ERROR;
+	}
+
+	if (myFile!=NULL)
+	{
+		int result = fclose(myFile);
+
+		if ((result==EOF) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK))
+			returnValue = NEURAL_NETWORK_FILE_SAVE_ERROR;
+	}
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (rename(temporaryFilePath, filePath)!=0))
+		returnValue = NEURAL_NETWORK_FILE_SAVE_ERROR;
+
+	if ((returnValue!=NEURAL_NETWORK_RETURN_VALUE_OK) && (myFile!=NULL))
+		remove(temporaryFilePath);
+
+	return returnValue;
+}
+
+static void *runCheckpointWriterThread(void *argument)
+{
+	CheckpointWriter *myWriter = argument;
+
+	pthread_mutex_lock(&(myWriter->mutex));
+
+	while ((!myWriter->isShuttingDown) || (myWriter->isWritePending))
+	{
+		if (myWriter->isWritePending)
+		{
+			pthread_mutex_unlock(&(myWriter->mutex));
+
+			NeuralNetworkErrorCode result = saveCheckpointFile(myWriter->filePath, myWriter->temporaryFilePath, myWriter->buffer, myWriter->checkpointSize);
+
+			pthread_mutex_lock(&(myWriter->mutex));
+
+			if (result!=NEURAL_NETWORK_RETURN_VALUE_OK)
+				myWriter->writeResult = result;
+
+			myWriter->isWritePending = false;
+		}
+		else
+		{
+			pthread_cond_wait(&(myWriter->writeRequestCondition), &(myWriter->mutex));
+		}
+	}
+
+	pthread_mutex_unlock(&(myWriter->mutex));
+
+	return NULL;
+}
+
+NeuralNetworkErrorCode createCheckpointWriter(CheckpointWriter **myWriter, const char *filePath)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myWriter==NULL) || (filePath==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		*myWriter = calloc(1, sizeof(CheckpointWriter));
+
+		if (*myWriter==NULL)
+			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		CheckpointWriter *newWriter = *myWriter;
+
+		size_t filePathLength = strlen(filePath);
+
+		newWriter->mutex = (pthread_mutex_t) PTHREAD_MUTEX_INITIALIZER;
+		newWriter->writeRequestCondition = (pthread_cond_t) PTHREAD_COND_INITIALIZER;
+		newWriter->writeResult = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+		newWriter->filePath = malloc(filePathLength + 1);
+		newWriter->temporaryFilePath = malloc(filePathLength + sizeof(CHECKPOINT_FILE_TEMPORARY_SUFFIX));
+
+		if ((newWriter->filePath==NULL) || (newWriter->temporaryFilePath==NULL))
+		{
+			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+		}
+		else
+		{
+			strcpy(newWriter->filePath, filePath);
+			strcpy(newWriter->temporaryFilePath, filePath);
+			strcat(newWriter->temporaryFilePath, CHECKPOINT_FILE_TEMPORARY_SUFFIX);
+		}
+	}
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (pthread_create(&((*myWriter)->thread), NULL, runCheckpointWriterThread, *myWriter)!=0))
+		returnValue = NEURAL_NETWORK_THREAD_ERROR;
+
+	//Release the partially created writer, whose thread was not created
+	if ((returnValue!=NEURAL_NETWORK_RETURN_VALUE_OK) && (returnValue!=NEURAL_NETWORK_NULL_POINTER_ERROR) && (*myWriter!=NULL))
+	{
+		free((*myWriter)->filePath);
+		free((*myWriter)->temporaryFilePath);
+		free(*myWriter);
+
+		*myWriter = NULL;
+	}
+
+	return returnValue;
+}
+
+//The checkpoint being written is completed before the thread stops
+NeuralNetworkErrorCode destroyCheckpointWriter(CheckpointWriter **myWriter)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myWriter==NULL) || (*myWriter==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		CheckpointWriter *oldWriter = *myWriter;
+
+		pthread_mutex_lock(&(oldWriter->mutex));
+		oldWriter->isShuttingDown = true;
+		pthread_cond_signal(&(oldWriter->writeRequestCondition));
+		pthread_mutex_unlock(&(oldWriter->mutex));
+
+		pthread_join(oldWriter->thread, NULL);
+
+		returnValue = oldWriter->writeResult;
+
+		pthread_mutex_destroy(&(oldWriter->mutex));
+		pthread_cond_destroy(&(oldWriter->writeRequestCondition));
+
+		free(oldWriter->filePath);
+		free(oldWriter->temporaryFilePath);
+		free(oldWriter->buffer);
+		free(oldWriter);
+
+		*myWriter = NULL;
+	}
+
+	return returnValue;
+}
+
+//Copy a checkpoint for the thread, unless the thread is still writing the previous one
+NeuralNetworkErrorCode writeCheckpoint(const void *checkpoint, size_t checkpointSize, void *checkpointData)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	CheckpointWriter *myWriter = checkpointData;
+
+	if ((checkpoint==NULL) || (myWriter==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else if ((checkpointSize==0) || ((checkpointSize % sizeof(uint64_t))!=0))
+		returnValue = NEURAL_NETWORK_CHECKPOINT_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		pthread_mutex_lock(&(myWriter->mutex));
+
+		returnValue = myWriter->writeResult;
+
+		if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (!myWriter->isWritePending) && (checkpointSize > myWriter->bufferCapacity))
+		{
+			unsigned char *newBuffer = realloc(myWriter->buffer, checkpointSize);
+
+			if (newBuffer==NULL)
+			{
+				returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+			}
+			else
+			{
+				myWriter->buffer = newBuffer;
+				myWriter->bufferCapacity = checkpointSize;
+			}
+		}
+
+		if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (!myWriter->isWritePending))
+		{
+			memcpy(myWriter->buffer, checkpoint, checkpointSize);
+
+			myWriter->checkpointSize = checkpointSize;
+			myWriter->isWritePending = true;
+
+			pthread_cond_signal(&(myWriter->writeRequestCondition));
+		}
+
+		pthread_mutex_unlock(&(myWriter->mutex));
+	}
+
+	return returnValue;
+}
+
+/*Load the checkpoint of a checkpoint file into a new buffer, which is released with free. The buffer
+ *is aligned for resumeEvolver*/
+NeuralNetworkErrorCode loadCheckpoint(const char *filePath, void **checkpoint, size_t *checkpointSize)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	CheckpointFileHeader myHeader;
+	struct stat myFileStatus;
+	unsigned char *newCheckpoint = NULL;
+
+	FILE *myFile = NULL;
+
+	if ((filePath==NULL) || (checkpoint==NULL) || (checkpointSize==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		myFile = fopen(filePath, "rb");
+
+		if ((myFile==NULL) || (fstat(fileno(myFile), &myFileStatus)!=0) || (fread(&myHeader, sizeof(myHeader), 1, myFile)!=1))
+			returnValue = NEURAL_NETWORK_FILE_LOAD_ERROR;
+	}
+
+	//The checkpoint must fill the rest of the file
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) &&
+		((memcmp(myHeader.magic, CHECKPOINT_FILE_MAGIC, sizeof(myHeader.magic))!=0) || (myHeader.version!=CHECKPOINT_FILE_VERSION) ||
+		 (myHeader.byteOrderMark!=CHECKPOINT_FILE_BYTE_ORDER_MARK) || (myHeader.checkpointSize==0) ||
+		 (myHeader.checkpointSize!=(uint64_t) myFileStatus.st_size - sizeof(myHeader)) || ((myHeader.checkpointSize % sizeof(uint64_t))!=0)))
+
+		returnValue = NEURAL_NETWORK_FILE_FORMAT_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		newCheckpoint = malloc((size_t) myHeader.checkpointSize);
+
+		if (newCheckpoint==NULL)
+			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+	}
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (fread(newCheckpoint, (size_t) myHeader.checkpointSize, 1, myFile)!=1))
+		returnValue = NEURAL_NETWORK_FILE_LOAD_ERROR;
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) &&
+		(computeBinaryFormatChecksum((const uint64_t *) newCheckpoint, (size_t) myHeader.checkpointSize / sizeof(uint64_t))!=myHeader.checksum))
+
+		returnValue = NEURAL_NETWORK_FILE_CHECKSUM_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		*checkpoint = newCheckpoint;
+		*checkpointSize = (size_t) myHeader.checkpointSize;
+	}
+	else
+		free(newCheckpoint);
+
+	if (myFile!=NULL)
+		fclose(myFile);
+
+	return returnValue;
+}
@@ -0,0 +1,44 @@
+/*
+ * CheckpointFile.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#ifndef SRC_DATA_TIER_CHECKPOINTFILE_H_
+#define SRC_DATA_TIER_CHECKPOINTFILE_H_
+
+#include "../logic_tier/NeuralNetwork.h"
+#include "BinaryFormat.h"
+
+#include <pthread.h>
+
+#define CHECKPOINT_FILE_VERSION 1
+
+//The checkpoint is written to this file first and then renamed over the previous checkpoint
+#define CHECKPOINT_FILE_TEMPORARY_SUFFIX ".tmp"
+
+/*A checkpoint file holds a header followed by a checkpoint of the evolver, whose size is a multiple of
+ *8 bytes. All the values are stored in the byte order of the machine that saved the file. The checksum
+ *is computed over the checkpoint*/
+typedef struct
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t byteOrderMark;
+	uint64_t checkpointSize;
+	uint64_t checksum;
+} CheckpointFileHeader;
+
+/*Background thread that stores the checkpoints of an evolver. writeCheckpoint is an evolver checkpoint
+ *function with the writer as checkpoint data: it copies the checkpoint and returns, and the thread
+ *writes the copy to the file. A checkpoint that arrives while the previous one is being written is
+ *dropped, so the evolver never waits for the disk*/
+typedef struct checkpointWriter CheckpointWriter;
+
+NeuralNetworkErrorCode createCheckpointWriter(CheckpointWriter **myWriter, const char *filePath);
+NeuralNetworkErrorCode destroyCheckpointWriter(CheckpointWriter **myWriter);
+NeuralNetworkErrorCode writeCheckpoint(const void *checkpoint, size_t checkpointSize, void *checkpointData);
+NeuralNetworkErrorCode loadCheckpoint(const char *filePath, void **checkpoint, size_t *checkpointSize);
+
+#endif /* SRC_DATA_TIER_CHECKPOINTFILE_H_ */
@@ -9,12 +9,14 @@
 
 #define NEURAL_NETWORK_JSON_NUMBER_OF_INPUTS_KEY "numberOfInputs"
 #define NEURAL_NETWORK_JSON_NUMBER_OF_HIDDEN_LAYERS_KEY "numberOfHiddenLayers"
+#define NEURAL_NETWORK_JSON_HIDDEN_LAYER_WIDTH_ARRAY_KEY "hiddenLayerWidthArray"
 #define NEURAL_NETWORK_JSON_NUMBER_OF_OUTPUTS_KEY "numberOfOutputs"
+#define NEURAL_NETWORK_JSON_IS_SPARSE_KEY "isSparse"
 #define NEURAL_NETWORK_JSON_HIDDEN_LAYER_ARRAY_KEY "hiddenLayerArray"
 #define NEURAL_NETWORK_JSON_OUTPUT_LAYER_KEY "outputLayer"
-#define NEURAL_NETWORK_JSON_MAX_LENGTH (pow(1024, 3))
+#define NEURAL_NETWORK_JSON_MEMBER_NAME_SIZE 64
 
-static NeuralNetworkErrorCode addNeuronWeights(Neuron *myNeuron, int numberOfInputs, JsonBuilder *myJsonBuilder)
+static NeuralNetworkErrorCode addNeuronWeights(Neuron *myNeuron, int numberOfInputs, JsonWriter *myJsonWriter)
 {
 	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
@@ -30,12 +32,7 @@ static NeuralNetworkErrorCode addNeuronWeights(Neuron *myNeuron, int numberOfInp
 	
 	//Begin weight array
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		myJsonBuilder = json_builder_begin_array(myJsonBuilder);
-
-		if (myJsonBuilder==NULL)
-			returnValue = NEURAL_NETWORK_JSON_GLIB_ERROR;
-	}
+		returnValue = beginJsonArray(myJsonWriter);
 
 	while ((inputNumber<numberOfInputs) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK))
 	{
@@ -45,29 +42,19 @@ static NeuralNetworkErrorCode addNeuronWeights(Neuron *myNeuron, int numberOfInp
 			returnValue = NEURAL_NETWORK_NEURON_ERROR;
 
 		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-		{
-			myJsonBuilder = json_builder_add_int_value(myJsonBuilder, myWeight);
-
-			if (myJsonBuilder==NULL)
-				returnValue = NEURAL_NETWORK_JSON_GLIB_ERROR;
-		}
+			returnValue = addJsonIntegerValue(myJsonWriter, myWeight);
 
 		inputNumber++;
 	}
 
 	//End weight array
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		myJsonBuilder = json_builder_end_array(myJsonBuilder);
-
-		if (myJsonBuilder==NULL)
-			returnValue = NEURAL_NETWORK_JSON_GLIB_ERROR;
-	}
+		returnValue = endJsonArray(myJsonWriter);
 
 	return returnValue;
 }
 
-static NeuralNetworkErrorCode addNeuralLayer(NeuralLayer *myNeuralLayer, int numberOfInputs, JsonBuilder *myJsonBuilder)
+static NeuralNetworkErrorCode addNeuralLayer(NeuralLayer *myNeuralLayer, int numberOfInputs, JsonWriter *myJsonWriter)
 {
 	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
@@ -81,12 +68,7 @@ static NeuralNetworkErrorCode addNeuralLayer(NeuralLayer *myNeuralLayer, int num
 
 	//Begin neuron array
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		myJsonBuilder = json_builder_begin_array(myJsonBuilder);
-
-		if (myJsonBuilder==NULL)
-			returnValue = NEURAL_NETWORK_JSON_GLIB_ERROR;
-	}
+		returnValue = beginJsonArray(myJsonWriter);
 
 	while ((neuronNumber<numberOfNeurons) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK))
 	{
@@ -95,7 +77,7 @@ static NeuralNetworkErrorCode addNeuralLayer(NeuralLayer *myNeuralLayer, int num
 		result = getNeuron(myNeuralLayer, neuronNumber, &myNeuron);
 
 		if (result==NEURON_RETURN_VALUE_OK)
-			returnValue = addNeuronWeights(myNeuron, numberOfInputs, myJsonBuilder);
+			returnValue = addNeuronWeights(myNeuron, numberOfInputs, myJsonWriter);
 		else
 			returnValue = NEURAL_NETWORK_NEURON_ERROR;
 
@@ -104,284 +86,425 @@ static NeuralNetworkErrorCode addNeuralLayer(NeuralLayer *myNeuralLayer, int num
 
 	//End neuron array
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		myJsonBuilder = json_builder_end_array(myJsonBuilder);
-
-		if (myJsonBuilder==NULL)
-			returnValue = NEURAL_NETWORK_JSON_GLIB_ERROR;
-	}
+		returnValue = endJsonArray(myJsonWriter);
 
 	return returnValue;
 }
 
-static NeuralNetworkErrorCode saveFile(char *filePath, JsonBuilder *myJsonBuilder)
+/*The weights of a dense neuron are written straight into its packed weight array, where a set bit
+ *is a positive weight. A disconnected weight (0) is only valid in a sparse neuron*/
+static NeuralNetworkErrorCode readNeuronWeights(Neuron *myNeuron, int numberOfInputs, JsonReader *myJsonReader)
 {
 	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
-	JsonGenerator *myJsonGenerator = NULL;
-	JsonNode *myRootNode = NULL;
+	uint64_t *packedWeightArray = NULL;
+	const uint64_t *connectionMask = NULL;
+	int numberOfWords = 0;
 
-	gchar *myJsonString = NULL;
+	int inputIndex = 0;
+	bool hasElement = true;
+
+	NeuronErrorCode result = getNeuronPackedWeights(myNeuron, &packedWeightArray, &numberOfWords);
 
-	//Create file
-	FILE *myFile = fopen(filePath, "w");
+	if (result==NEURON_RETURN_VALUE_OK)
+		result = getNeuronConnectionMask(myNeuron, &connectionMask);
 
-	if (myFile==NULL)
-		returnValue = NEURAL_NETWORK_FILE_SAVE_ERROR;
+	if ((result!=NEURON_RETURN_VALUE_OK) || (numberOfWords<NEURON_DATA_NUMBER_OF_WORDS(numberOfInputs)))
+		returnValue = NEURAL_NETWORK_NEURON_ERROR;
 
-	//Create json generator
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = beginReadingJsonArray(myJsonReader);
+
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (hasElement))
 	{
-		myJsonGenerator = json_generator_new();
+		long long inputWeight = 0;
 
-		myRootNode = json_builder_get_root(myJsonBuilder);
+		returnValue = hasJsonArrayElement(myJsonReader, &hasElement);
 
-		if (myRootNode!=NULL)
-			json_generator_set_root(myJsonGenerator, myRootNode);
-		else
-			returnValue = NEURAL_NETWORK_JSON_GLIB_ERROR;
+		if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (hasElement))
+		{
+			if (inputIndex==numberOfInputs)
+				returnValue = NEURAL_NETWORK_JSON_SCHEMA_ERROR;
+			else
+				returnValue = readJsonIntegerValue(myJsonReader, &inputWeight);
+		}
+
+		if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (hasElement))
+		{
+			uint64_t *word = &packedWeightArray[inputIndex / NEURON_DATA_BITS_PER_WORD];
+			uint64_t bit = UINT64_C(1) << (inputIndex % NEURON_DATA_BITS_PER_WORD);
+
+			if ((inputWeight!=NEURON_WEIGHT_POSITIVE) && (inputWeight!=NEURON_WEIGHT_NEGATIVE) &&
+				((inputWeight!=NEURON_WEIGHT_DISCONNECTED) || (connectionMask==NULL)))
+				returnValue = NEURAL_NETWORK_JSON_SCHEMA_ERROR;
+			else if (connectionMask!=NULL)
+			{
+				//setNeuronWeight keeps the connected word list of the sparse neuron up to date
+				if (setNeuronWeight(myNeuron, inputIndex, (NeuronWeight) inputWeight)!=NEURON_RETURN_VALUE_OK)
+					returnValue = NEURAL_NETWORK_NEURON_ERROR;
+			}
+			else if (inputWeight==NEURON_WEIGHT_POSITIVE)
+				*word |= bit;
+			else
+				*word &= ~bit;
+
+			inputIndex++;
+		}
 	}
 
-	//Create the json string and write it in the file
-	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		myJsonString = json_generator_to_data(myJsonGenerator, NULL);
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (inputIndex!=numberOfInputs))
+		returnValue = NEURAL_NETWORK_JSON_SCHEMA_ERROR;
 
-		int result = fputs(myJsonString, myFile);
+	return returnValue;
+}
 
-		if (result==EOF)
-			returnValue = NEURAL_NETWORK_FILE_SAVE_ERROR;
-	}
+static NeuralNetworkErrorCode readNeuralLayerWeights(NeuralLayer *myNeuralLayer, int numberOfInputs, int numberOfNeurons, JsonReader *myJsonReader)
+{
+	NeuralNetworkErrorCode returnValue = beginReadingJsonArray(myJsonReader);
 
-    //Close file
-    if (myFile != NULL)
-    {
-        int result = fclose(myFile);
+	int neuronIndex = 0;
+	bool hasElement = true;
+
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (hasElement))
+	{
+		returnValue = hasJsonArrayElement(myJsonReader, &hasElement);
 
-        if ((result == EOF) && (returnValue == NEURAL_NETWORK_RETURN_VALUE_OK))
-            returnValue = NEURAL_NETWORK_FILE_SAVE_ERROR;
-    }
+		if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (hasElement))
+		{
+			Neuron *myNeuron;
 
-    //Free memory
-    if (myRootNode != NULL)
-        json_node_free(myRootNode);
+			if (neuronIndex==numberOfNeurons)
+				returnValue = NEURAL_NETWORK_JSON_SCHEMA_ERROR;
+			else if (getNeuron(myNeuralLayer, neuronIndex, &myNeuron)!=NEURON_RETURN_VALUE_OK)
+				returnValue = NEURAL_NETWORK_NEURON_ERROR;
+			else
+				returnValue = readNeuronWeights(myNeuron, numberOfInputs, myJsonReader);
 
-    if (myJsonGenerator != NULL)
-        g_object_unref(myJsonGenerator);
+			neuronIndex++;
+		}
+	}
 
-    if (myJsonString != NULL)
-        g_free(myJsonString);
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (neuronIndex!=numberOfNeurons))
+		returnValue = NEURAL_NETWORK_JSON_SCHEMA_ERROR;
 
-    return returnValue;
+	return returnValue;
 }
 
-static NeuralNetworkErrorCode setNeuronWeights(Neuron *myNeuron, int numberOfInputs, JsonReader *myJsonReader)
+//Each hidden layer is fed by the previous one, the first one by the input layer
+static NeuralNetworkErrorCode readHiddenLayerArray(NeuralNetwork *myNeuralNetwork, int numberOfInputs, JsonReader *myJsonReader)
 {
-	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+	NeuralNetworkErrorCode returnValue = beginReadingJsonArray(myJsonReader);
 
-	int inputIndex = 0;
+	const int *hiddenLayerWidthArray = NULL;
+	int numberOfHiddenLayers = 0;
+	int numberOfLayerInputs = numberOfInputs;
+	int hiddenLayerIndex = 0;
+	bool hasElement = true;
 
-	while ((inputIndex < numberOfInputs) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK))
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getHiddenLayerWidthArray(myNeuralNetwork, &hiddenLayerWidthArray, &numberOfHiddenLayers);
+
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (hasElement))
 	{
-		json_reader_read_element(myJsonReader, inputIndex);
-		gint64 inputWeight = json_reader_get_int_value(myJsonReader);
-		json_reader_end_element(myJsonReader);
+		returnValue = hasJsonArrayElement(myJsonReader, &hasElement);
+
+		if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (hasElement))
+		{
+			NeuralLayer *myHiddenLayer;
 
-		NeuronErrorCode result = setNeuronWeight(myNeuron, inputIndex, inputWeight);
+			if (hiddenLayerIndex==numberOfHiddenLayers)
+				returnValue = NEURAL_NETWORK_JSON_SCHEMA_ERROR;
+			else
+				returnValue = getHiddenLayer(myNeuralNetwork, hiddenLayerIndex, &myHiddenLayer);
 
-		if (result!=NEURON_RETURN_VALUE_OK)
-			returnValue = NEURAL_NETWORK_NEURON_ERROR;
+			if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			{
+				returnValue = readNeuralLayerWeights(myHiddenLayer, numberOfLayerInputs, hiddenLayerWidthArray[hiddenLayerIndex], myJsonReader);
+				numberOfLayerInputs = hiddenLayerWidthArray[hiddenLayerIndex];
+			}
 
-		inputIndex++;
+			hiddenLayerIndex++;
+		}
 	}
 
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (hiddenLayerIndex!=numberOfHiddenLayers))
+		returnValue = NEURAL_NETWORK_JSON_SCHEMA_ERROR;
+
 	return returnValue;
 }
 
-static NeuralNetworkErrorCode setNeuralLayerWeights(NeuralLayer *myNeuralLayer, int numberOfInputs, int numberOfNeurons, JsonReader *myJsonReader)
+//Read a member of the topology, each one can appear only once
+static NeuralNetworkErrorCode readTopologyMember(JsonReader *myJsonReader, bool *isSet, int *value)
 {
 	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
-	int neuronIndex = 0;
+	long long memberValue = 0;
+
+	if (*isSet)
+		returnValue = NEURAL_NETWORK_JSON_SCHEMA_ERROR;
+	else
+		returnValue = readJsonIntegerValue(myJsonReader, &memberValue);
 
-	while ((neuronIndex < numberOfNeurons) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK))
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && ((memberValue < INT_MIN) || (memberValue > INT_MAX)))
+		returnValue = NEURAL_NETWORK_JSON_SCHEMA_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
 	{
-		Neuron *myNeuron;
+		*value = (int) memberValue;
+		*isSet = true;
+	}
 
-		NeuronErrorCode result = getNeuron(myNeuralLayer, neuronIndex, &myNeuron);
+	return returnValue;
+}
 
-		if (result==NEURON_RETURN_VALUE_OK)
+//The array of hidden layer widths is optional, without it every hidden layer is as wide as the input layer
+static NeuralNetworkErrorCode readHiddenLayerWidthArray(JsonReader *myJsonReader, int **hiddenLayerWidthArray, int *numberOfWidths)
+{
+	NeuralNetworkErrorCode returnValue = beginReadingJsonArray(myJsonReader);
+
+	int capacity = 0;
+	bool hasElement = true;
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (*hiddenLayerWidthArray!=NULL))
+		returnValue = NEURAL_NETWORK_JSON_SCHEMA_ERROR;
+
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (hasElement))
+	{
+		returnValue = hasJsonArrayElement(myJsonReader, &hasElement);
+
+		//The array grows as the widths are read, so it does not depend on the order of the topology members
+		if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (hasElement) && (*numberOfWidths==capacity))
 		{
-			json_reader_read_element(myJsonReader, neuronIndex);
-			returnValue = setNeuronWeights(myNeuron, numberOfInputs, myJsonReader);
-			json_reader_end_element(myJsonReader);
+			int *newWidthArray = NULL;
+
+			if (capacity<=INT_MAX/2)
+				newWidthArray = realloc(*hiddenLayerWidthArray, sizeof(int) * ((capacity==0) ? 1 : capacity * 2));
+
+			if (newWidthArray==NULL)
+			{
+				returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+			}
+			else
+			{
+				*hiddenLayerWidthArray = newWidthArray;
+				capacity = (capacity==0) ? 1 : capacity * 2;
+			}
 		}
-		else
-			returnValue = NEURAL_NETWORK_NEURON_ERROR;
 
-		neuronIndex++;
+		if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (hasElement))
+		{
+			bool isSet = false;
+
+			returnValue = readTopologyMember(myJsonReader, &isSet, &((*hiddenLayerWidthArray)[*numberOfWidths]));
+
+			(*numberOfWidths)++;
+		}
 	}
 
+	//Every neural network has at least one hidden layer, so an empty width array is not valid
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (*hiddenLayerWidthArray==NULL))
+		returnValue = NEURAL_NETWORK_JSON_SCHEMA_ERROR;
+
 	return returnValue;
 }
 
-NeuralNetworkErrorCode loadNeuralNetwork(char *filePath, NeuralNetwork **myNeuralNetwork)
+/*The weights are read in a single pass, so the neural network is created when the first layer is
+ *found and the whole topology must come before the layers, as saveNeuralNetwork writes it*/
+static NeuralNetworkErrorCode prepareJsonNeuralNetwork(NeuralNetwork **myNeuralNetwork, bool isTopologySet, int numberOfInputs, int numberOfHiddenLayers,
+													   const int *hiddenLayerWidthArray, int numberOfWidths, int numberOfOutputs, bool isSparse)
 {
 	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
-	FILE *myFile = NULL;
+	if (*myNeuralNetwork==NULL)
+	{
+		if (!isTopologySet)
+			returnValue = NEURAL_NETWORK_JSON_SCHEMA_ERROR;
+		else if ((hiddenLayerWidthArray!=NULL) && (numberOfWidths!=numberOfHiddenLayers))
+			returnValue = NEURAL_NETWORK_JSON_SCHEMA_ERROR;
+		else
+			returnValue = createNeuralNetworkWithTopology(myNeuralNetwork, numberOfInputs, numberOfHiddenLayers, hiddenLayerWidthArray, numberOfOutputs,
+														  isSparse ? NEURAL_NETWORK_CONNECTIVITY_SPARSE : NEURAL_NETWORK_CONNECTIVITY_DENSE);
+	}
 
-	gchar *myJsonString = NULL;
+	return returnValue;
+}
+
+/*The file is read through a buffer of fixed size and the weights are stored as they are parsed, so
+ *loading a neural network needs no more memory than the neural network itself. Members out of the
+ *schema are skipped. On a syntax or schema error the position of the reader is returned*/
+static NeuralNetworkErrorCode loadJsonNeuralNetwork(char *filePath, NeuralNetwork **myNeuralNetwork, int *errorLine, int *errorColumn)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
-	JsonParser *myJsonParser = NULL;
 	JsonReader *myJsonReader = NULL;
 
+	char memberName[NEURAL_NETWORK_JSON_MEMBER_NAME_SIZE];
+
 	int numberOfInputs = 0;
 	int numberOfHiddenLayers = 0;
 	int numberOfOutputs = 0;
-	int hiddenLayerIndex = 0;
 
-	if ((filePath==NULL) || (myNeuralNetwork==NULL))
-		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	int *hiddenLayerWidthArray = NULL;
+	int numberOfWidths = 0;
 
-	//Allocate memory
-	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		myJsonString = malloc(NEURAL_NETWORK_JSON_MAX_LENGTH);
+	bool isNumberOfInputsSet = false;
+	bool isNumberOfHiddenLayersSet = false;
+	bool isNumberOfOutputsSet = false;
+	bool isSparse = false;
+	bool isSparseSet = false;
+	bool isHiddenLayerArraySet = false;
+	bool isOutputLayerSet = false;
+	bool isObjectEnd = false;
 
-		if (myJsonString==NULL)
-			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
-	}
+	if ((filePath==NULL) || (myNeuralNetwork==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else
+		*myNeuralNetwork = NULL;
 
 	//Open file
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		myFile = fopen(filePath, "r");
+		returnValue = createJsonReader(&myJsonReader, filePath);
 
-		if (myFile==NULL)
-			returnValue = NEURAL_NETWORK_FILE_LOAD_ERROR;
-	}
-
-	//Read json string
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		char* result = fgets(myJsonString, NEURAL_NETWORK_JSON_MAX_LENGTH, myFile);
+		returnValue = beginReadingJsonObject(myJsonReader);
 
-		if (result==NULL)
-			returnValue = NEURAL_NETWORK_FILE_LOAD_ERROR;
-	}
-
-	//Parse json string
-	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	//Read members
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (!isObjectEnd))
 	{
-	    myJsonParser = json_parser_new();
-		gboolean result = json_parser_load_from_data(myJsonParser, myJsonString, -1, NULL);
+		returnValue = readJsonMemberName(myJsonReader, memberName, sizeof(memberName), &isObjectEnd);
 
-		if (!result)
-			returnValue = NEURAL_NETWORK_JSON_GLIB_ERROR;
+		if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (!isObjectEnd))
+		{
+			bool isTopologySet = isNumberOfInputsSet && isNumberOfHiddenLayersSet && isNumberOfOutputsSet;
+
+			if (strcmp(memberName, NEURAL_NETWORK_JSON_NUMBER_OF_INPUTS_KEY)==0)
+			{
+				returnValue = readTopologyMember(myJsonReader, &isNumberOfInputsSet, &numberOfInputs);
+			}
+			else if (strcmp(memberName, NEURAL_NETWORK_JSON_NUMBER_OF_HIDDEN_LAYERS_KEY)==0)
+			{
+				returnValue = readTopologyMember(myJsonReader, &isNumberOfHiddenLayersSet, &numberOfHiddenLayers);
+			}
+			else if (strcmp(memberName, NEURAL_NETWORK_JSON_NUMBER_OF_OUTPUTS_KEY)==0)
+			{
+				returnValue = readTopologyMember(myJsonReader, &isNumberOfOutputsSet, &numberOfOutputs);
+			}
+			else if (strcmp(memberName, NEURAL_NETWORK_JSON_HIDDEN_LAYER_WIDTH_ARRAY_KEY)==0)
+			{
+				//The widths are part of the topology, so they can not come after the layers
+				if (*myNeuralNetwork!=NULL)
+					returnValue = NEURAL_NETWORK_JSON_SCHEMA_ERROR;
+				else
+					returnValue = readHiddenLayerWidthArray(myJsonReader, &hiddenLayerWidthArray, &numberOfWidths);
+			}
+			else if (strcmp(memberName, NEURAL_NETWORK_JSON_IS_SPARSE_KEY)==0)
+			{
+				//The connectivity is optional and it is part of the topology too
+				if ((*myNeuralNetwork!=NULL) || (isSparseSet))
+					returnValue = NEURAL_NETWORK_JSON_SCHEMA_ERROR;
+				else
+					returnValue = readJsonBooleanValue(myJsonReader, &isSparse);
+
+				isSparseSet = true;
+			}
+			else if (strcmp(memberName, NEURAL_NETWORK_JSON_HIDDEN_LAYER_ARRAY_KEY)==0)
+			{
+				if (isHiddenLayerArraySet)
+					returnValue = NEURAL_NETWORK_JSON_SCHEMA_ERROR;
+				else
+					returnValue = prepareJsonNeuralNetwork(myNeuralNetwork, isTopologySet, numberOfInputs, numberOfHiddenLayers, hiddenLayerWidthArray, numberOfWidths, numberOfOutputs, isSparse);
+
+				if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+					returnValue = readHiddenLayerArray(*myNeuralNetwork, numberOfInputs, myJsonReader);
+
+				isHiddenLayerArraySet = true;
+			}
+			else if (strcmp(memberName, NEURAL_NETWORK_JSON_OUTPUT_LAYER_KEY)==0)
+			{
+				NeuralLayer *myOutputLayer;
+				const int *networkWidthArray;
+				int dummy;
+
+				if (isOutputLayerSet)
+					returnValue = NEURAL_NETWORK_JSON_SCHEMA_ERROR;
+				else
+					returnValue = prepareJsonNeuralNetwork(myNeuralNetwork, isTopologySet, numberOfInputs, numberOfHiddenLayers, hiddenLayerWidthArray, numberOfWidths, numberOfOutputs, isSparse);
+
+				if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+					returnValue = getOutputLayer(*myNeuralNetwork, &myOutputLayer, &dummy);
+
+				//The output layer is fed by the last hidden layer
+				if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+					returnValue = getHiddenLayerWidthArray(*myNeuralNetwork, &networkWidthArray, &dummy);
+
+				if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+					returnValue = readNeuralLayerWeights(myOutputLayer, networkWidthArray[numberOfHiddenLayers - 1], numberOfOutputs, myJsonReader);
+
+				isOutputLayerSet = true;
+			}
+			else
+				returnValue = skipJsonValue(myJsonReader);
+		}
 	}
 
-	//Create Json Reader
-	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		myJsonReader = json_reader_new(json_parser_get_root(myJsonParser));
-
-		if (myJsonReader==NULL)
-			returnValue = NEURAL_NETWORK_JSON_GLIB_ERROR;
-	}
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && ((!isHiddenLayerArraySet) || (!isOutputLayerSet)))
+		returnValue = NEURAL_NETWORK_JSON_SCHEMA_ERROR;
 
-	//Create neural network
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		//Get number of inputs
-		json_reader_read_member(myJsonReader, NEURAL_NETWORK_JSON_NUMBER_OF_INPUTS_KEY);
-		numberOfInputs = json_reader_get_int_value(myJsonReader);
-		json_reader_end_member(myJsonReader);
-
-		//Get number of hidden layers
-		json_reader_read_member(myJsonReader, NEURAL_NETWORK_JSON_NUMBER_OF_HIDDEN_LAYERS_KEY);
-		numberOfHiddenLayers = json_reader_get_int_value(myJsonReader);
-		json_reader_end_member(myJsonReader);
-
-		//Get number of outputs
-		json_reader_read_member(myJsonReader, NEURAL_NETWORK_JSON_NUMBER_OF_OUTPUTS_KEY);
-		numberOfOutputs = json_reader_get_int_value(myJsonReader);
-		json_reader_end_member(myJsonReader);
-
-		returnValue = createNeuralNetwork(myNeuralNetwork, numberOfInputs, numberOfHiddenLayers, numberOfOutputs);
-	}
-
-	json_reader_read_member(myJsonReader, NEURAL_NETWORK_JSON_HIDDEN_LAYER_ARRAY_KEY);
+		returnValue = endReadingJsonDocument(myJsonReader);
 
-	//Set weights of hidden layers
-	while ((hiddenLayerIndex<numberOfHiddenLayers) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK))
+	//Get error position
+	if (((returnValue==NEURAL_NETWORK_JSON_SYNTAX_ERROR) || (returnValue==NEURAL_NETWORK_JSON_SCHEMA_ERROR)) && (myJsonReader!=NULL))
 	{
-		NeuralLayer *myHiddenLayer;
+		int line = 0;
+		int column = 0;
 
-		returnValue = getHiddenLayer(*myNeuralNetwork, hiddenLayerIndex, &myHiddenLayer);
+		getJsonReaderPosition(myJsonReader, &line, &column);
 
-		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-		{
-			json_reader_read_element(myJsonReader, hiddenLayerIndex);
-			returnValue = setNeuralLayerWeights(myHiddenLayer, numberOfInputs, numberOfInputs, myJsonReader);
-			json_reader_end_element(myJsonReader);
-		}
+		if (errorLine!=NULL)
+			*errorLine = line;
 
-		hiddenLayerIndex++;
+		if (errorColumn!=NULL)
+			*errorColumn = column;
 	}
 
-	json_reader_end_member(myJsonReader);
-
-	//Set weights of output layer
-	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	//Close file
+	if (myJsonReader!=NULL)
 	{
-		NeuralLayer *myOutputLayer;
-
-		int dummy;
-
-		returnValue = getOutputLayer(*myNeuralNetwork, &myOutputLayer, &dummy);
+		NeuralNetworkErrorCode result = destroyJsonReader(&myJsonReader);
 
 		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-		{
-			json_reader_read_member(myJsonReader, NEURAL_NETWORK_JSON_OUTPUT_LAYER_KEY);
-			returnValue = setNeuralLayerWeights(myOutputLayer, numberOfInputs, numberOfOutputs, myJsonReader);
-			json_reader_end_member(myJsonReader);
-		}
+			returnValue = result;
 	}
 
-    //Close file
-    if (myFile != NULL)
-    {
-        int result = fclose(myFile);
-
-        if ((result == EOF) && (returnValue == NEURAL_NETWORK_RETURN_VALUE_OK))
-            returnValue = NEURAL_NETWORK_FILE_LOAD_ERROR;
-    }
-
-    //Free memory
-    free(myJsonString);
-
-    if (myJsonReader != NULL)
-        g_object_unref(myJsonReader);
+	if ((returnValue!=NEURAL_NETWORK_RETURN_VALUE_OK) && (myNeuralNetwork!=NULL) && (*myNeuralNetwork!=NULL))
+		destroyNeuralNetwork(myNeuralNetwork);
 
-    if (myJsonParser != NULL)
-        g_object_unref(myJsonParser);
+	//The neural network keeps its own copy of the hidden layer widths
+	free(hiddenLayerWidthArray);
 
-    return returnValue;
+	return returnValue;
 }
 
-NeuralNetworkErrorCode saveNeuralNetwork(char *filePath, NeuralNetwork *myNeuralNetwork)
+/*The json document is written to the file while the neural layers are walked, so saving a neural
+ *network uses the same memory whatever its size*/
+static NeuralNetworkErrorCode saveJsonNeuralNetwork(char *filePath, NeuralNetwork *myNeuralNetwork)
 {
 	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
-	JsonBuilder *myJsonBuilder = NULL;
+	JsonWriter *myJsonWriter = NULL;
 
 	NeuralLayer *myHiddenLayer;
 	NeuralLayer *myOutputLayer;
 
+	const int *hiddenLayerWidthArray = NULL;
+
+	NeuralNetworkConnectivity connectivity = NEURAL_NETWORK_CONNECTIVITY_DENSE;
+
 	int numberOfInputs = 0;
 	int numberOfHiddenLayers = 0;
 	int numberOfOutputs = 0;
+	int numberOfLayerInputs = 0;
 	int hiddenLayerIndex = 0;
 
 	if ((filePath==NULL) || (myNeuralNetwork==NULL))
@@ -395,146 +518,133 @@ NeuralNetworkErrorCode saveNeuralNetwork(char *filePath, NeuralNetwork *myNeural
 		returnValue = getInputLayer(myNeuralNetwork, &dummy, &numberOfInputs);
 	}
 
-	//Get number of hidden layers
+	//Get number of hidden layers and their widths
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-		returnValue = getNumberOfHiddenLayers(myNeuralNetwork, &numberOfHiddenLayers);
+		returnValue = getHiddenLayerWidthArray(myNeuralNetwork, &hiddenLayerWidthArray, &numberOfHiddenLayers);
 
-	//Get number of outputs and output layer
+	//Get number of outputs
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-		returnValue = getOutputLayer(myNeuralNetwork, &myOutputLayer, &numberOfOutputs);
+		returnValue = getNeuralNetworkNumberOfOutputs(myNeuralNetwork, &numberOfOutputs);
 
-	//Create json builder
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		myJsonBuilder = json_builder_new();
-		myJsonBuilder = json_builder_begin_object(myJsonBuilder);
-
-		if (myJsonBuilder==NULL)
-			returnValue = NEURAL_NETWORK_JSON_GLIB_ERROR;
-	}
+		returnValue = getNeuralNetworkConnectivity(myNeuralNetwork, &connectivity);
 
-	//Add number of inputs key
+	//Create json writer
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		myJsonBuilder = json_builder_set_member_name(myJsonBuilder, NEURAL_NETWORK_JSON_NUMBER_OF_INPUTS_KEY);
-
-		if (myJsonBuilder==NULL)
-			returnValue = NEURAL_NETWORK_JSON_GLIB_ERROR;
-	}
+		returnValue = createJsonWriter(&myJsonWriter, filePath);
 
-	//Add number of inputs value
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		myJsonBuilder = json_builder_add_int_value(myJsonBuilder, numberOfInputs);
-
-		if (myJsonBuilder==NULL)
-			returnValue = NEURAL_NETWORK_JSON_GLIB_ERROR;
-	}
+		returnValue = beginJsonObject(myJsonWriter);
 
-	//Add number of hidden layers key
+	//Add topology
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		myJsonBuilder = json_builder_set_member_name(myJsonBuilder, NEURAL_NETWORK_JSON_NUMBER_OF_HIDDEN_LAYERS_KEY);
-
-		if (myJsonBuilder==NULL)
-			returnValue = NEURAL_NETWORK_JSON_GLIB_ERROR;
-	}
+		returnValue = addJsonIntegerMember(myJsonWriter, NEURAL_NETWORK_JSON_NUMBER_OF_INPUTS_KEY, numberOfInputs);
 
-	//Add number of hidden layers value
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		myJsonBuilder = json_builder_add_int_value(myJsonBuilder, numberOfHiddenLayers);
+		returnValue = addJsonIntegerMember(myJsonWriter, NEURAL_NETWORK_JSON_NUMBER_OF_HIDDEN_LAYERS_KEY, numberOfHiddenLayers);
 
-		if (myJsonBuilder==NULL)
-			returnValue = NEURAL_NETWORK_JSON_GLIB_ERROR;
-	}
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = setJsonMemberName(myJsonWriter, NEURAL_NETWORK_JSON_HIDDEN_LAYER_WIDTH_ARRAY_KEY);
 
-	//Add number of outputs key
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		myJsonBuilder = json_builder_set_member_name(myJsonBuilder, NEURAL_NETWORK_JSON_NUMBER_OF_OUTPUTS_KEY);
+		returnValue = beginJsonArray(myJsonWriter);
 
-		if (myJsonBuilder==NULL)
-			returnValue = NEURAL_NETWORK_JSON_GLIB_ERROR;
-	}
+	for (int i=0; (i<numberOfHiddenLayers) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK); i++)
+		returnValue = addJsonIntegerValue(myJsonWriter, hiddenLayerWidthArray[i]);
 
-	//Add number of outputs value
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		myJsonBuilder = json_builder_add_int_value(myJsonBuilder, numberOfOutputs);
-
-		if (myJsonBuilder==NULL)
-			returnValue = NEURAL_NETWORK_JSON_GLIB_ERROR;
-	}
+		returnValue = endJsonArray(myJsonWriter);
 
-	//Add hidden layer array key
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		myJsonBuilder = json_builder_set_member_name(myJsonBuilder, NEURAL_NETWORK_JSON_HIDDEN_LAYER_ARRAY_KEY);
+		returnValue = addJsonIntegerMember(myJsonWriter, NEURAL_NETWORK_JSON_NUMBER_OF_OUTPUTS_KEY, numberOfOutputs);
 
-		if (myJsonBuilder==NULL)
-			returnValue = NEURAL_NETWORK_JSON_GLIB_ERROR;
-	}
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonBooleanMember(myJsonWriter, NEURAL_NETWORK_JSON_IS_SPARSE_KEY, connectivity==NEURAL_NETWORK_CONNECTIVITY_SPARSE);
 
 	//Begin hidden layer array
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		myJsonBuilder = json_builder_begin_array(myJsonBuilder);
+		returnValue = setJsonMemberName(myJsonWriter, NEURAL_NETWORK_JSON_HIDDEN_LAYER_ARRAY_KEY);
 
-		if (myJsonBuilder==NULL)
-			returnValue = NEURAL_NETWORK_JSON_GLIB_ERROR;
-	}
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = beginJsonArray(myJsonWriter);
+
+	//Add hidden layers, each one fed by the previous one
+	numberOfLayerInputs = numberOfInputs;
 
-	//Add hidden layers
 	while ((hiddenLayerIndex<numberOfHiddenLayers) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK))
 	{
 		returnValue = getHiddenLayer(myNeuralNetwork, hiddenLayerIndex, &myHiddenLayer);
 
 		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-		    returnValue = addNeuralLayer(myHiddenLayer, numberOfInputs, myJsonBuilder);
+		    returnValue = addNeuralLayer(myHiddenLayer, numberOfLayerInputs, myJsonWriter);
 
+		numberOfLayerInputs = hiddenLayerWidthArray[hiddenLayerIndex];
 		hiddenLayerIndex++;
 	}
 
 	//End hidden layer array
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		myJsonBuilder = json_builder_end_array(myJsonBuilder);
+		returnValue = endJsonArray(myJsonWriter);
 
-		if (myJsonBuilder==NULL)
-			returnValue = NEURAL_NETWORK_JSON_GLIB_ERROR;
-	}
-
-	//Set output layer key
+	//Add output layer
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		myJsonBuilder = json_builder_set_member_name(myJsonBuilder, NEURAL_NETWORK_JSON_OUTPUT_LAYER_KEY);
+		returnValue = setJsonMemberName(myJsonWriter, NEURAL_NETWORK_JSON_OUTPUT_LAYER_KEY);
 
-		if (myJsonBuilder==NULL)
-			returnValue = NEURAL_NETWORK_JSON_GLIB_ERROR;
-	}
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getOutputLayer(myNeuralNetwork, &myOutputLayer, &numberOfOutputs);
 
-	//Add output layer
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-		returnValue = addNeuralLayer(myOutputLayer, numberOfInputs, myJsonBuilder);
+		returnValue = addNeuralLayer(myOutputLayer, numberOfLayerInputs, myJsonWriter);
 
-	//End json builder
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = endJsonObject(myJsonWriter);
+
+	//Write the rest of the document and close the file
+	if (myJsonWriter!=NULL)
 	{
-		myJsonBuilder = json_builder_end_object(myJsonBuilder);
+		NeuralNetworkErrorCode result = destroyJsonWriter(&myJsonWriter);
 
-		if (myJsonBuilder==NULL)
-			returnValue = NEURAL_NETWORK_JSON_GLIB_ERROR;
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			returnValue = result;
 	}
 
-	//Save the json in the file
-	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-		returnValue = saveFile(filePath, myJsonBuilder);
+	return returnValue;
+}
 
-	//Free memory
-	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-		g_object_unref(myJsonBuilder);
+//Files with the binary format extension are memory-mapped, any other file is read as json
+NeuralNetworkErrorCode loadNeuralNetwork(char *filePath, NeuralNetwork **myNeuralNetwork)
+{
+	return loadNeuralNetworkWithErrorPosition(filePath, myNeuralNetwork, NULL, NULL);
+}
+
+/*The line and the column, which can be NULL, are set where a json file stops matching the json
+ *syntax or the schema of a neural network, and to 0 on any other result*/
+NeuralNetworkErrorCode loadNeuralNetworkWithErrorPosition(char *filePath, NeuralNetwork **myNeuralNetwork, int *errorLine, int *errorColumn)
+{
+	NeuralNetworkErrorCode returnValue;
+
+	if (errorLine!=NULL)
+		*errorLine = 0;
+
+	if (errorColumn!=NULL)
+		*errorColumn = 0;
+
+	if (isBinaryFormatFile(filePath))
+		returnValue = loadBinaryNeuralNetwork(filePath, myNeuralNetwork);
+	else
+		returnValue = loadJsonNeuralNetwork(filePath, myNeuralNetwork, errorLine, errorColumn);
 
 	return returnValue;
 }
 
+NeuralNetworkErrorCode saveNeuralNetwork(char *filePath, NeuralNetwork *myNeuralNetwork)
+{
+	NeuralNetworkErrorCode returnValue;
+
+	if (isBinaryFormatFile(filePath))
+		returnValue = saveBinaryNeuralNetwork(filePath, myNeuralNetwork);
+	else
+		returnValue = saveJsonNeuralNetwork(filePath, myNeuralNetwork);
+
+	return returnValue;
+}
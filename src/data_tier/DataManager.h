@@ -9,14 +9,17 @@
 #define SRC_DATA_TIER_DATAMANAGER_H_
 
 #include "../logic_tier/NeuralNetwork.h"
+#include "BinaryFormat.h"
+#include "CheckpointFile.h"
+#include "JsonReader.h"
+#include "JsonWriter.h"
+#include "LineageJournal.h"
 
 #include <stdio.h>
 #include <string.h>
-#include <math.h>
-#include <json-glib/json-glib.h>
-#include <json-glib/json-gobject.h>
 
 NeuralNetworkErrorCode loadNeuralNetwork(char *filePath, NeuralNetwork **myNeuralNetwork);
+NeuralNetworkErrorCode loadNeuralNetworkWithErrorPosition(char *filePath, NeuralNetwork **myNeuralNetwork, int *errorLine, int *errorColumn);
 NeuralNetworkErrorCode saveNeuralNetwork(char *filePath, NeuralNetwork *myNeuralNetwork);
 
 #endif /* SRC_DATA_TIER_DATAMANAGER_H_ */
@@ -0,0 +1,620 @@
+/*
+ * JsonReader.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#include "JsonReader.h"
+
+#define JSON_READER_END_OF_FILE -1
+
+/*The reader remembers whether each open object or array already has a value, so it knows whether
+ *a comma must come before the next one. The position is the line and the column of the next
+ *character, both starting at 1*/
+typedef struct jsonReader
+{
+	int fileDescriptor;
+	bool isReadOk;
+	int line;
+	int column;
+	int depth;
+	bool hasValueArray[JSON_READER_MAXIMUM_DEPTH];
+	size_t length;
+	size_t offset;
+	unsigned char buffer[JSON_READER_BUFFER_SIZE];
+} JsonReader;
+
+static void fillJsonReader(JsonReader *myJsonReader)
+{
+	ssize_t result;
+
+	do
+	{
+		result = read(myJsonReader->fileDescriptor, myJsonReader->buffer, JSON_READER_BUFFER_SIZE);
+	} while ((result<0) && (errno==EINTR));
+
+	if (result<0)
+		myJsonReader->isReadOk = false;
+
+	myJsonReader->length = (result>0) ? (size_t) result : 0;
+	myJsonReader->offset = 0;
+}
+
+static inline int peekJsonCharacter(JsonReader *myJsonReader)
+{
+	if ((myJsonReader->offset==myJsonReader->length) && (myJsonReader->isReadOk))
+		fillJsonReader(myJsonReader);
+
+	return (myJsonReader->offset < myJsonReader->length) ? myJsonReader->buffer[myJsonReader->offset] : JSON_READER_END_OF_FILE;
+}
+
+static inline int readJsonCharacter(JsonReader *myJsonReader)
+{
+	int character = peekJsonCharacter(myJsonReader);
+
+	if (character!=JSON_READER_END_OF_FILE)
+	{
+		myJsonReader->offset++;
+
+		if (character=='\n')
+		{
+			myJsonReader->line++;
+			myJsonReader->column = 1;
+		}
+		else
+			myJsonReader->column++;
+	}
+
+	return character;
+}
+
+static inline void skipJsonWhitespace(JsonReader *myJsonReader)
+{
+	int character = peekJsonCharacter(myJsonReader);
+
+	while ((character==' ') || (character=='\t') || (character=='\n') || (character=='\r'))
+	{
+		readJsonCharacter(myJsonReader);
+		character = peekJsonCharacter(myJsonReader);
+	}
+}
+
+//A document that ends because the file can not be read is a load error, not a syntax error
+static inline NeuralNetworkErrorCode getSyntaxErrorCode(const JsonReader *myJsonReader)
+{
+	return (myJsonReader->isReadOk) ? NEURAL_NETWORK_JSON_SYNTAX_ERROR : NEURAL_NETWORK_FILE_LOAD_ERROR;
+}
+
+static NeuralNetworkErrorCode expectJsonCharacter(JsonReader *myJsonReader, int expectedCharacter)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if (peekJsonCharacter(myJsonReader)==expectedCharacter)
+		readJsonCharacter(myJsonReader);
+	else
+		returnValue = getSyntaxErrorCode(myJsonReader);
+
+	return returnValue;
+}
+
+static NeuralNetworkErrorCode openJsonContainer(JsonReader *myJsonReader, char openingCharacter)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if (myJsonReader==NULL)
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		skipJsonWhitespace(myJsonReader);
+
+		if (myJsonReader->depth==JSON_READER_MAXIMUM_DEPTH)
+			returnValue = NEURAL_NETWORK_JSON_SYNTAX_ERROR;
+		else
+			returnValue = expectJsonCharacter(myJsonReader, openingCharacter);
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		myJsonReader->hasValueArray[myJsonReader->depth] = false;
+		myJsonReader->depth++;
+	}
+
+	return returnValue;
+}
+
+/*Move to the next value of the innermost object or array: either the closing character is found,
+ *which closes the container, or a comma is read if a value was already read*/
+static NeuralNetworkErrorCode nextJsonContainerValue(JsonReader *myJsonReader, char closingCharacter, bool *hasValue)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myJsonReader==NULL) || (hasValue==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else if (myJsonReader->depth==0)
+		returnValue = NEURAL_NETWORK_JSON_SYNTAX_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		skipJsonWhitespace(myJsonReader);
+
+		if (peekJsonCharacter(myJsonReader)==closingCharacter)
+		{
+			readJsonCharacter(myJsonReader);
+			myJsonReader->depth--;
+
+			*hasValue = false;
+		}
+		else
+		{
+			if (myJsonReader->hasValueArray[myJsonReader->depth - 1])
+			{
+				returnValue = expectJsonCharacter(myJsonReader, ',');
+				skipJsonWhitespace(myJsonReader);
+			}
+
+			myJsonReader->hasValueArray[myJsonReader->depth - 1] = true;
+
+			*hasValue = true;
+		}
+	}
+
+	return returnValue;
+}
+
+static NeuralNetworkErrorCode readJsonHexDigit(JsonReader *myJsonReader, unsigned int *codePoint)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	int character = readJsonCharacter(myJsonReader);
+
+	if ((character>='0') && (character<='9'))
+		*codePoint = (*codePoint << 4) | (unsigned int) (character - '0');
+	else if ((character>='a') && (character<='f'))
+		*codePoint = (*codePoint << 4) | (unsigned int) (character - 'a' + 10);
+	else if ((character>='A') && (character<='F'))
+		*codePoint = (*codePoint << 4) | (unsigned int) (character - 'A' + 10);
+	else
+		returnValue = getSyntaxErrorCode(myJsonReader);
+
+	return returnValue;
+}
+
+/*Read a string into the buffer, or skip it if the buffer is NULL. Escaped characters out of the
+ *ASCII range are not decoded, and a string that does not fit in the buffer is returned empty, so
+ *it never matches a member name of the schema*/
+static NeuralNetworkErrorCode readJsonString(JsonReader *myJsonReader, char *buffer, size_t bufferSize)
+{
+	NeuralNetworkErrorCode returnValue = expectJsonCharacter(myJsonReader, '"');
+
+	size_t length = 0;
+	bool isTruncated = (buffer!=NULL) && (bufferSize==0);
+	bool isStringEnd = false;
+
+	while ((!isStringEnd) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK))
+	{
+		int character = readJsonCharacter(myJsonReader);
+
+		if (character=='"')
+		{
+			isStringEnd = true;
+		}
+		else if ((character==JSON_READER_END_OF_FILE) || (character < 0x20))
+		{
+			returnValue = getSyntaxErrorCode(myJsonReader);
+		}
+		else if (character=='\\')
+		{
+			character = readJsonCharacter(myJsonReader);
+
+			switch (character)
+			{
+				case '"':
+				case '\\':
+				case '/':
+					break;
+
+				case 'b':
+					character = '\b';
+					break;
+
+				case 'f':
+					character = '\f';
+					break;
+
+				case 'n':
+					character = '\n';
+					break;
+
+				case 'r':
+					character = '\r';
+					break;
+
+				case 't':
+					character = '\t';
+					break;
+
+				case 'u':
+				{
+					unsigned int codePoint = 0;
+
+					for (int i=0; (i<4) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK); i++)
+						returnValue = readJsonHexDigit(myJsonReader, &codePoint);
+
+					character = (codePoint < 0x80) ? (int) codePoint : '?';
+					break;
+				}
+
+				default:
+					returnValue = getSyntaxErrorCode(myJsonReader);
+			}
+		}
+
+		if ((!isStringEnd) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (buffer!=NULL))
+		{
+			if (length + 1 < bufferSize)
+				buffer[length++] = (char) character;
+			else
+				isTruncated = true;
+		}
+	}
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (buffer!=NULL) && (bufferSize>0))
+		buffer[isTruncated ? 0 : length] = '\0';
+
+	return returnValue;
+}
+
+static NeuralNetworkErrorCode readJsonDigits(JsonReader *myJsonReader)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	int character = peekJsonCharacter(myJsonReader);
+
+	if ((character<'0') || (character>'9'))
+		returnValue = getSyntaxErrorCode(myJsonReader);
+
+	while ((character>='0') && (character<='9'))
+	{
+		readJsonCharacter(myJsonReader);
+		character = peekJsonCharacter(myJsonReader);
+	}
+
+	return returnValue;
+}
+
+//Skip a number with any fraction and exponent
+static NeuralNetworkErrorCode skipJsonNumber(JsonReader *myJsonReader)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if (peekJsonCharacter(myJsonReader)=='-')
+		readJsonCharacter(myJsonReader);
+
+	if (peekJsonCharacter(myJsonReader)=='0')
+		readJsonCharacter(myJsonReader);
+	else
+		returnValue = readJsonDigits(myJsonReader);
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (peekJsonCharacter(myJsonReader)=='.'))
+	{
+		readJsonCharacter(myJsonReader);
+		returnValue = readJsonDigits(myJsonReader);
+	}
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && ((peekJsonCharacter(myJsonReader)=='e') || (peekJsonCharacter(myJsonReader)=='E')))
+	{
+		readJsonCharacter(myJsonReader);
+
+		if ((peekJsonCharacter(myJsonReader)=='+') || (peekJsonCharacter(myJsonReader)=='-'))
+			readJsonCharacter(myJsonReader);
+
+		returnValue = readJsonDigits(myJsonReader);
+	}
+
+	return returnValue;
+}
+
+static NeuralNetworkErrorCode skipJsonLiteral(JsonReader *myJsonReader, const char *literal)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	for (const char *cursor = literal; (*cursor!='\0') && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK); cursor++)
+		returnValue = expectJsonCharacter(myJsonReader, *cursor);
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode createJsonReader(JsonReader **myJsonReader, const char *filePath)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myJsonReader==NULL) || (filePath==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		*myJsonReader = malloc(sizeof(JsonReader));
+
+		if (*myJsonReader==NULL)
+			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+	}
+
+	//Open file
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		(*myJsonReader)->fileDescriptor = open(filePath, O_RDONLY);
+		(*myJsonReader)->isReadOk = true;
+		(*myJsonReader)->line = 1;
+		(*myJsonReader)->column = 1;
+		(*myJsonReader)->depth = 0;
+		(*myJsonReader)->length = 0;
+		(*myJsonReader)->offset = 0;
+
+		if ((*myJsonReader)->fileDescriptor<0)
+		{
+			free(*myJsonReader);
+			*myJsonReader = NULL;
+
+			returnValue = NEURAL_NETWORK_FILE_LOAD_ERROR;
+		}
+	}
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode destroyJsonReader(JsonReader **myJsonReader)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myJsonReader==NULL) || (*myJsonReader==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		if (close((*myJsonReader)->fileDescriptor)!=0)
+			returnValue = NEURAL_NETWORK_FILE_LOAD_ERROR;
+
+		free(*myJsonReader);
+		*myJsonReader = NULL;
+	}
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode getJsonReaderPosition(const JsonReader *myJsonReader, int *line, int *column)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myJsonReader==NULL) || (line==NULL) || (column==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		*line = myJsonReader->line;
+		*column = myJsonReader->column;
+	}
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode beginReadingJsonObject(JsonReader *myJsonReader)
+{
+	return openJsonContainer(myJsonReader, '{');
+}
+
+/*Read the name of the next member of the innermost object and the colon after it. When the end of
+ *the object is found instead, isObjectEnd is set and the object is closed. The member name can be
+ *NULL to skip it*/
+NeuralNetworkErrorCode readJsonMemberName(JsonReader *myJsonReader, char *memberName, size_t memberNameSize, bool *isObjectEnd)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	bool hasMember = false;
+
+	if (isObjectEnd==NULL)
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else
+		returnValue = nextJsonContainerValue(myJsonReader, '}', &hasMember);
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (hasMember))
+		returnValue = readJsonString(myJsonReader, memberName, memberNameSize);
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (hasMember))
+	{
+		skipJsonWhitespace(myJsonReader);
+		returnValue = expectJsonCharacter(myJsonReader, ':');
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		*isObjectEnd = !hasMember;
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode beginReadingJsonArray(JsonReader *myJsonReader)
+{
+	return openJsonContainer(myJsonReader, '[');
+}
+
+//Tell whether the innermost array has one more element, the array is closed when it has no more
+NeuralNetworkErrorCode hasJsonArrayElement(JsonReader *myJsonReader, bool *hasElement)
+{
+	return nextJsonContainerValue(myJsonReader, ']', hasElement);
+}
+
+/*A number with a fraction or an exponent is valid json but not an integer, so it is reported as a
+ *schema error like an integer out of range*/
+NeuralNetworkErrorCode readJsonIntegerValue(JsonReader *myJsonReader, long long *value)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	long long magnitude = 0;
+	bool isNegative = false;
+
+	if ((myJsonReader==NULL) || (value==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		skipJsonWhitespace(myJsonReader);
+
+		if (peekJsonCharacter(myJsonReader)=='-')
+		{
+			readJsonCharacter(myJsonReader);
+			isNegative = true;
+		}
+
+		//Leading zeros are not allowed
+		if (peekJsonCharacter(myJsonReader)=='0')
+		{
+			readJsonCharacter(myJsonReader);
+
+			if ((peekJsonCharacter(myJsonReader)>='0') && (peekJsonCharacter(myJsonReader)<='9'))
+				returnValue = getSyntaxErrorCode(myJsonReader);
+		}
+		else if ((peekJsonCharacter(myJsonReader)<'1') || (peekJsonCharacter(myJsonReader)>'9'))
+		{
+			returnValue = getSyntaxErrorCode(myJsonReader);
+		}
+	}
+
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (peekJsonCharacter(myJsonReader)>='0') && (peekJsonCharacter(myJsonReader)<='9'))
+	{
+		int digit = readJsonCharacter(myJsonReader) - '0';
+
+		if (magnitude > (LLONG_MAX - digit) / 10)
+			returnValue = NEURAL_NETWORK_JSON_SCHEMA_ERROR;
+		else
+			magnitude = magnitude * 10 + digit;
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		int character = peekJsonCharacter(myJsonReader);
+
+		if ((character=='.') || (character=='e') || (character=='E'))
+			returnValue = NEURAL_NETWORK_JSON_SCHEMA_ERROR;
+		else
+			*value = isNegative ? -magnitude : magnitude;
+	}
+
+	return returnValue;
+}
+
+//A valid value of another type is a schema error, like a number that is not an integer
+NeuralNetworkErrorCode readJsonBooleanValue(JsonReader *myJsonReader, bool *value)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myJsonReader==NULL) || (value==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		skipJsonWhitespace(myJsonReader);
+
+		int character = peekJsonCharacter(myJsonReader);
+
+		if (character=='t')
+		{
+			returnValue = skipJsonLiteral(myJsonReader, "true");
+			*value = true;
+		}
+		else if (character=='f')
+		{
+			returnValue = skipJsonLiteral(myJsonReader, "false");
+			*value = false;
+		}
+		else
+		{
+			returnValue = skipJsonValue(myJsonReader);
+
+			if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+				returnValue = NEURAL_NETWORK_JSON_SCHEMA_ERROR;
+		}
+	}
+
+	return returnValue;
+}
+
+//Skip a value of any type, objects and arrays are skipped with all their content
+NeuralNetworkErrorCode skipJsonValue(JsonReader *myJsonReader)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if (myJsonReader==NULL)
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		skipJsonWhitespace(myJsonReader);
+
+		int character = peekJsonCharacter(myJsonReader);
+		bool hasValue = true;
+
+		if (character=='{')
+		{
+			returnValue = beginReadingJsonObject(myJsonReader);
+
+			while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (hasValue))
+			{
+				bool isObjectEnd = false;
+
+				returnValue = readJsonMemberName(myJsonReader, NULL, 0, &isObjectEnd);
+				hasValue = !isObjectEnd;
+
+				if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (hasValue))
+					returnValue = skipJsonValue(myJsonReader);
+			}
+		}
+		else if (character=='[')
+		{
+			returnValue = beginReadingJsonArray(myJsonReader);
+
+			while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (hasValue))
+			{
+				returnValue = hasJsonArrayElement(myJsonReader, &hasValue);
+
+				if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (hasValue))
+					returnValue = skipJsonValue(myJsonReader);
+			}
+		}
+		else if (character=='"')
+			returnValue = readJsonString(myJsonReader, NULL, 0);
+		else if ((character=='-') || ((character>='0') && (character<='9')))
+			returnValue = skipJsonNumber(myJsonReader);
+		else if (character=='t')
+			returnValue = skipJsonLiteral(myJsonReader, "true");
+		else if (character=='f')
+			returnValue = skipJsonLiteral(myJsonReader, "false");
+		else if (character=='n')
+			returnValue = skipJsonLiteral(myJsonReader, "null");
+		else
+			returnValue = getSyntaxErrorCode(myJsonReader);
+	}
+
+	return returnValue;
+}
+
+//Check that nothing but whitespace follows the root value
+NeuralNetworkErrorCode endReadingJsonDocument(JsonReader *myJsonReader)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if (myJsonReader==NULL)
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		skipJsonWhitespace(myJsonReader);
+
+		if (!myJsonReader->isReadOk)
+			returnValue = NEURAL_NETWORK_FILE_LOAD_ERROR;
+		else if ((myJsonReader->depth!=0) || (peekJsonCharacter(myJsonReader)!=JSON_READER_END_OF_FILE))
+			returnValue = NEURAL_NETWORK_JSON_SYNTAX_ERROR;
+	}
+
+	return returnValue;
+}
@@ -0,0 +1,40 @@
+/*
+ * JsonReader.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#ifndef SRC_DATA_TIER_JSONREADER_H_
+#define SRC_DATA_TIER_JSONREADER_H_
+
+#include "../logic_tier/NeuralNetwork.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define JSON_READER_BUFFER_SIZE 65536
+#define JSON_READER_MAXIMUM_DEPTH 64
+
+/*Streaming json reader: the document is read in a single pass through a buffer of fixed size, so
+ *the memory used does not depend on the size of the file. Any whitespace and line breaks are
+ *accepted between the tokens. The reader keeps the line and the column of the last character read,
+ *which tell where a syntax error was found*/
+typedef struct jsonReader JsonReader;
+
+NeuralNetworkErrorCode createJsonReader(JsonReader **myJsonReader, const char *filePath);
+NeuralNetworkErrorCode destroyJsonReader(JsonReader **myJsonReader);
+NeuralNetworkErrorCode getJsonReaderPosition(const JsonReader *myJsonReader, int *line, int *column);
+NeuralNetworkErrorCode beginReadingJsonObject(JsonReader *myJsonReader);
+NeuralNetworkErrorCode readJsonMemberName(JsonReader *myJsonReader, char *memberName, size_t memberNameSize, bool *isObjectEnd);
+NeuralNetworkErrorCode beginReadingJsonArray(JsonReader *myJsonReader);
+NeuralNetworkErrorCode hasJsonArrayElement(JsonReader *myJsonReader, bool *hasElement);
+NeuralNetworkErrorCode readJsonIntegerValue(JsonReader *myJsonReader, long long *value);
+NeuralNetworkErrorCode readJsonBooleanValue(JsonReader *myJsonReader, bool *value);
+NeuralNetworkErrorCode skipJsonValue(JsonReader *myJsonReader);
+NeuralNetworkErrorCode endReadingJsonDocument(JsonReader *myJsonReader);
+
+#endif /* SRC_DATA_TIER_JSONREADER_H_ */
@@ -0,0 +1,365 @@
+/*
+ * JsonWriter.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#include "JsonWriter.h"
+
+#define JSON_WRITER_FILE_MODE 0666
+
+//Longest decimal representation of a long long value, with its sign
+#define JSON_WRITER_MAXIMUM_INTEGER_LENGTH 20
+
+//Significant digits of a real value, enough to tell apart any two measurements
+#define JSON_WRITER_REAL_PRECISION 15
+#define JSON_WRITER_MAXIMUM_REAL_LENGTH 32
+
+/*The writer remembers whether each open object or array already has a value, so it knows where to
+ *write the commas. A value that follows a member name is written without comma*/
+typedef struct jsonWriter
+{
+	int fileDescriptor;
+	bool isWriteOk;
+	int depth;
+	bool hasValueArray[JSON_WRITER_MAXIMUM_DEPTH];
+	bool isMemberNameSet;
+	size_t length;
+	char buffer[JSON_WRITER_BUFFER_SIZE];
+} JsonWriter;
+
+static void flushJsonWriter(JsonWriter *myJsonWriter)
+{
+	size_t offset = 0;
+
+	while ((offset < myJsonWriter->length) && (myJsonWriter->isWriteOk))
+	{
+		ssize_t result = write(myJsonWriter->fileDescriptor, myJsonWriter->buffer + offset, myJsonWriter->length - offset);
+
+		if (result<=0)
+			myJsonWriter->isWriteOk = false;
+		else
+			offset += (size_t) result;
+	}
+
+	myJsonWriter->length = 0;
+}
+
+static inline void writeJsonCharacter(JsonWriter *myJsonWriter, char character)
+{
+	if (myJsonWriter->length==JSON_WRITER_BUFFER_SIZE)
+		flushJsonWriter(myJsonWriter);
+
+	myJsonWriter->buffer[myJsonWriter->length++] = character;
+}
+
+//Quotes, backslashes and control characters are escaped
+static void writeJsonString(JsonWriter *myJsonWriter, const char *text)
+{
+	static const char hexDigitArray[] = "0123456789abcdef";
+
+	writeJsonCharacter(myJsonWriter, '"');
+
+	for (const char *cursor = text; *cursor!='\0'; cursor++)
+	{
+		unsigned char character = (unsigned char) *cursor;
+
+		if ((character=='"') || (character=='\\'))
+		{
+			writeJsonCharacter(myJsonWriter, '\\');
+			writeJsonCharacter(myJsonWriter, (char) character);
+		}
+		else if (character < 0x20)
+		{
+			writeJsonCharacter(myJsonWriter, '\\');
+			writeJsonCharacter(myJsonWriter, 'u');
+			writeJsonCharacter(myJsonWriter, '0');
+			writeJsonCharacter(myJsonWriter, '0');
+			writeJsonCharacter(myJsonWriter, hexDigitArray[character >> 4]);
+			writeJsonCharacter(myJsonWriter, hexDigitArray[character & 0xF]);
+		}
+		else
+			writeJsonCharacter(myJsonWriter, (char) character);
+	}
+
+	writeJsonCharacter(myJsonWriter, '"');
+}
+
+//Write the comma that separates a new value from the previous value of the same object or array
+static NeuralNetworkErrorCode beginJsonValue(JsonWriter *myJsonWriter)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if (myJsonWriter==NULL)
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		if (myJsonWriter->isMemberNameSet)
+		{
+			myJsonWriter->isMemberNameSet = false;
+		}
+		else if (myJsonWriter->depth > 0)
+		{
+			if (myJsonWriter->hasValueArray[myJsonWriter->depth - 1])
+				writeJsonCharacter(myJsonWriter, ',');
+
+			myJsonWriter->hasValueArray[myJsonWriter->depth - 1] = true;
+		}
+	}
+
+	return returnValue;
+}
+
+static NeuralNetworkErrorCode openJsonContainer(JsonWriter *myJsonWriter, char openingCharacter)
+{
+	NeuralNetworkErrorCode returnValue = beginJsonValue(myJsonWriter);
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myJsonWriter->depth==JSON_WRITER_MAXIMUM_DEPTH))
+		returnValue = NEURAL_NETWORK_FILE_SAVE_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		writeJsonCharacter(myJsonWriter, openingCharacter);
+
+		myJsonWriter->hasValueArray[myJsonWriter->depth] = false;
+		myJsonWriter->depth++;
+	}
+
+	return returnValue;
+}
+
+static NeuralNetworkErrorCode closeJsonContainer(JsonWriter *myJsonWriter, char closingCharacter)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if (myJsonWriter==NULL)
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else if ((myJsonWriter->depth==0) || (myJsonWriter->isMemberNameSet))
+		returnValue = NEURAL_NETWORK_FILE_SAVE_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		writeJsonCharacter(myJsonWriter, closingCharacter);
+		myJsonWriter->depth--;
+	}
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode createJsonWriter(JsonWriter **myJsonWriter, const char *filePath)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myJsonWriter==NULL) || (filePath==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		*myJsonWriter = calloc(1, sizeof(JsonWriter));
+
+		if (*myJsonWriter==NULL)
+			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+	}
+
+	//Create file
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		(*myJsonWriter)->fileDescriptor = open(filePath, O_WRONLY | O_CREAT | O_TRUNC, JSON_WRITER_FILE_MODE);
+		(*myJsonWriter)->isWriteOk = true;
+
+		if ((*myJsonWriter)->fileDescriptor<0)
+		{
+			free(*myJsonWriter);
+			*myJsonWriter = NULL;
+
+			returnValue = NEURAL_NETWORK_FILE_SAVE_ERROR;
+		}
+	}
+
+	return returnValue;
+}
+
+//Write the buffered text and close the file, the result tells whether the whole document was saved
+NeuralNetworkErrorCode destroyJsonWriter(JsonWriter **myJsonWriter)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myJsonWriter==NULL) || (*myJsonWriter==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		JsonWriter *oldJsonWriter = *myJsonWriter;
+
+		flushJsonWriter(oldJsonWriter);
+
+		if ((close(oldJsonWriter->fileDescriptor)!=0) || (!oldJsonWriter->isWriteOk))
+			returnValue = NEURAL_NETWORK_FILE_SAVE_ERROR;
+
+		free(oldJsonWriter);
+		*myJsonWriter = NULL;
+	}
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode beginJsonObject(JsonWriter *myJsonWriter)
+{
+	return openJsonContainer(myJsonWriter, '{');
+}
+
+NeuralNetworkErrorCode endJsonObject(JsonWriter *myJsonWriter)
+{
+	return closeJsonContainer(myJsonWriter, '}');
+}
+
+NeuralNetworkErrorCode beginJsonArray(JsonWriter *myJsonWriter)
+{
+	return openJsonContainer(myJsonWriter, '[');
+}
+
+NeuralNetworkErrorCode endJsonArray(JsonWriter *myJsonWriter)
+{
+	return closeJsonContainer(myJsonWriter, ']');
+}
+
+NeuralNetworkErrorCode setJsonMemberName(JsonWriter *myJsonWriter, const char *memberName)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if (memberName==NULL)
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else
+		returnValue = beginJsonValue(myJsonWriter);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		writeJsonString(myJsonWriter, memberName);
+		writeJsonCharacter(myJsonWriter, ':');
+
+		myJsonWriter->isMemberNameSet = true;
+	}
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode addJsonStringValue(JsonWriter *myJsonWriter, const char *value)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if (value==NULL)
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else
+		returnValue = beginJsonValue(myJsonWriter);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		writeJsonString(myJsonWriter, value);
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode addJsonIntegerValue(JsonWriter *myJsonWriter, long long value)
+{
+	NeuralNetworkErrorCode returnValue = beginJsonValue(myJsonWriter);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		char digitArray[JSON_WRITER_MAXIMUM_INTEGER_LENGTH];
+		int numberOfDigits = 0;
+
+		//The digits are computed on the magnitude as unsigned, so LLONG_MIN does not overflow
+		unsigned long long magnitude = (value < 0) ? 0ULL - (unsigned long long) value : (unsigned long long) value;
+
+		if (value < 0)
+			writeJsonCharacter(myJsonWriter, '-');
+
+		do
+		{
+			digitArray[numberOfDigits++] = (char) ('0' + magnitude % 10);
+			magnitude /= 10;
+		} while (magnitude > 0);
+
+		while (numberOfDigits > 0)
+			writeJsonCharacter(myJsonWriter, digitArray[--numberOfDigits]);
+	}
+
+	return returnValue;
+}
+
+//Json has no representation for infinity and NaN, so they are written as null
+NeuralNetworkErrorCode addJsonRealValue(JsonWriter *myJsonWriter, double value)
+{
+	NeuralNetworkErrorCode returnValue = beginJsonValue(myJsonWriter);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		char digitArray[JSON_WRITER_MAXIMUM_REAL_LENGTH];
+
+		if (isfinite(value))
+			snprintf(digitArray, sizeof(digitArray), "%.*g", JSON_WRITER_REAL_PRECISION, value);
+		else
+			snprintf(digitArray, sizeof(digitArray), "null");
+
+		for (const char *cursor = digitArray; *cursor!='\0'; cursor++)
+			writeJsonCharacter(myJsonWriter, *cursor);
+	}
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode addJsonBooleanValue(JsonWriter *myJsonWriter, bool value)
+{
+	NeuralNetworkErrorCode returnValue = beginJsonValue(myJsonWriter);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		for (const char *cursor = value ? "true" : "false"; *cursor!='\0'; cursor++)
+			writeJsonCharacter(myJsonWriter, *cursor);
+	}
+
+	return returnValue;
+}
+
+//Add a member with a value to the current json object
+
+NeuralNetworkErrorCode addJsonIntegerMember(JsonWriter *myJsonWriter, const char *memberName, long long value)
+{
+	NeuralNetworkErrorCode returnValue = setJsonMemberName(myJsonWriter, memberName);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonIntegerValue(myJsonWriter, value);
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode addJsonRealMember(JsonWriter *myJsonWriter, const char *memberName, double value)
+{
+	NeuralNetworkErrorCode returnValue = setJsonMemberName(myJsonWriter, memberName);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonRealValue(myJsonWriter, value);
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode addJsonStringMember(JsonWriter *myJsonWriter, const char *memberName, const char *value)
+{
+	NeuralNetworkErrorCode returnValue = setJsonMemberName(myJsonWriter, memberName);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonStringValue(myJsonWriter, value);
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode addJsonBooleanMember(JsonWriter *myJsonWriter, const char *memberName, bool value)
+{
+	NeuralNetworkErrorCode returnValue = setJsonMemberName(myJsonWriter, memberName);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonBooleanValue(myJsonWriter, value);
+
+	return returnValue;
+}
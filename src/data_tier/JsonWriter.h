@@ -0,0 +1,43 @@
+/*
+ * JsonWriter.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#ifndef SRC_DATA_TIER_JSONWRITER_H_
+#define SRC_DATA_TIER_JSONWRITER_H_
+
+#include "../logic_tier/NeuralNetwork.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <math.h>
+
+#define JSON_WRITER_BUFFER_SIZE 65536
+#define JSON_WRITER_MAXIMUM_DEPTH 16
+
+/*Streaming json writer: the values are written to the file as they are added, through a buffer of
+ *fixed size, so the memory used does not depend on the size of the document. The output is compact
+ *json without spaces or line breaks*/
+typedef struct jsonWriter JsonWriter;
+
+NeuralNetworkErrorCode createJsonWriter(JsonWriter **myJsonWriter, const char *filePath);
+NeuralNetworkErrorCode destroyJsonWriter(JsonWriter **myJsonWriter);
+NeuralNetworkErrorCode beginJsonObject(JsonWriter *myJsonWriter);
+NeuralNetworkErrorCode endJsonObject(JsonWriter *myJsonWriter);
+NeuralNetworkErrorCode beginJsonArray(JsonWriter *myJsonWriter);
+NeuralNetworkErrorCode endJsonArray(JsonWriter *myJsonWriter);
+NeuralNetworkErrorCode setJsonMemberName(JsonWriter *myJsonWriter, const char *memberName);
+NeuralNetworkErrorCode addJsonIntegerValue(JsonWriter *myJsonWriter, long long value);
+NeuralNetworkErrorCode addJsonRealValue(JsonWriter *myJsonWriter, double value);
+NeuralNetworkErrorCode addJsonStringValue(JsonWriter *myJsonWriter, const char *value);
+NeuralNetworkErrorCode addJsonBooleanValue(JsonWriter *myJsonWriter, bool value);
+NeuralNetworkErrorCode addJsonIntegerMember(JsonWriter *myJsonWriter, const char *memberName, long long value);
+NeuralNetworkErrorCode addJsonRealMember(JsonWriter *myJsonWriter, const char *memberName, double value);
+NeuralNetworkErrorCode addJsonStringMember(JsonWriter *myJsonWriter, const char *memberName, const char *value);
+NeuralNetworkErrorCode addJsonBooleanMember(JsonWriter *myJsonWriter, const char *memberName, bool value);
+
+#endif /* SRC_DATA_TIER_JSONWRITER_H_ */
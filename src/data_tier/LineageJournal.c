@@ -0,0 +1,467 @@
+/*
+ * LineageJournal.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#include "LineageJournal.h"
+
+#define LINEAGE_JOURNAL_MAGIC "T-REX-LJ"
+#define LINEAGE_JOURNAL_BYTE_ORDER_MARK 0x01020304
+
+//A variable-length integer stores 7 bits per byte, the high bit is set in every byte but the last one
+#define VARIABLE_LENGTH_INTEGER_BITS 7
+#define VARIABLE_LENGTH_INTEGER_MAXIMUM_SIZE 10
+
+//Every flip is stored in three variable-length integers of at least one byte each
+#define LINEAGE_JOURNAL_MINIMUM_FLIP_SIZE 3
+#define LINEAGE_JOURNAL_MAXIMUM_FLIP_SIZE (3 * VARIABLE_LENGTH_INTEGER_MAXIMUM_SIZE)
+
+//The buffer holds the flips of the entry being written
+typedef struct lineageJournal
+{
+	FILE *file;
+	unsigned char *buffer;
+	size_t bufferCapacity;
+} LineageJournal;
+
+static size_t encodeVariableLengthInteger(uint64_t value, unsigned char *buffer)
+{
+	size_t size = 0;
+
+	while (value >= 0x80)
+	{
+		buffer[size++] = (unsigned char) (value | 0x80);
+		value >>= VARIABLE_LENGTH_INTEGER_BITS;
+	}
+
+	buffer[size++] = (unsigned char) value;
+
+	return size;
+}
+
+//Read a variable-length integer not higher than maximumValue, the position is moved after it
+static bool decodeVariableLengthInteger(const unsigned char *buffer, size_t bufferSize, size_t *position, uint64_t maximumValue, uint64_t *value)
+{
+	bool isValid = false;
+	bool isLastByte = false;
+
+	int shift = 0;
+
+	*value = 0;
+
+	while ((!isLastByte) && (*position < bufferSize) && (shift < VARIABLE_LENGTH_INTEGER_MAXIMUM_SIZE * VARIABLE_LENGTH_INTEGER_BITS))
+	{
+		unsigned char byte = buffer[(*position)++];
+
+		*value |= (uint64_t) (byte & 0x7F) << shift;
+		shift += VARIABLE_LENGTH_INTEGER_BITS;
+
+		isLastByte = (byte & 0x80)==0;
+	}
+
+	if (isLastByte && (*value <= maximumValue))
+		isValid = true;
+
+	return isValid;
+}
+
+static NeuralNetworkErrorCode decodeFlips(const unsigned char *flipData, size_t flipDataSize, NeuralNetworkWeightFlip *flipArray, int numberOfFlips)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	size_t position = 0;
+	int i = 0;
+
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (i < numberOfFlips))
+	{
+		uint64_t layerIndex, neuronIndex, weightCode;
+
+		if (decodeVariableLengthInteger(flipData, flipDataSize, &position, INT_MAX, &layerIndex) &&
+			decodeVariableLengthInteger(flipData, flipDataSize, &position, INT_MAX, &neuronIndex) &&
+			decodeVariableLengthInteger(flipData, flipDataSize, &position, 3 * (uint64_t) INT_MAX + 2, &weightCode))
+		{
+			flipArray[i].layerIndex = (int) layerIndex;
+			flipArray[i].neuronIndex = (int) neuronIndex;
+			flipArray[i].weightIndex = (int) (weightCode / 3);
+			flipArray[i].weight = (NeuronWeight) ((int) (weightCode % 3) + NEURON_WEIGHT_NEGATIVE);
+		}
+		else
+			returnValue = NEURAL_NETWORK_JOURNAL_ERROR;
+
+		i++;
+	}
+
+	//The flips must fill the whole entry
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (position!=flipDataSize))
+		returnValue = NEURAL_NETWORK_JOURNAL_ERROR;
+
+	return returnValue;
+}
+
+//Read the header of a journal file and check that it was written by this version on this machine
+static NeuralNetworkErrorCode readLineageJournalHeader(FILE *myFile, LineageJournalHeader *myHeader)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if (fread(myHeader, sizeof(LineageJournalHeader), 1, myFile)!=1)
+		returnValue = NEURAL_NETWORK_FILE_LOAD_ERROR;
+	else if ((memcmp(myHeader->magic, LINEAGE_JOURNAL_MAGIC, sizeof(myHeader->magic))!=0) || (myHeader->version!=LINEAGE_JOURNAL_VERSION) ||
+			 (myHeader->byteOrderMark!=LINEAGE_JOURNAL_BYTE_ORDER_MARK))
+		returnValue = NEURAL_NETWORK_FILE_FORMAT_ERROR;
+
+	return returnValue;
+}
+
+//The journal file is replaced by a new journal that starts from the initial neural network
+NeuralNetworkErrorCode createLineageJournal(LineageJournal **myJournal, const char *filePath, NeuralNetwork *initialNeuralNetwork)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	LineageJournalHeader myHeader;
+
+	if ((myJournal==NULL) || (filePath==NULL) || (initialNeuralNetwork==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		memset(&myHeader, 0, sizeof(myHeader));
+		memcpy(myHeader.magic, LINEAGE_JOURNAL_MAGIC, sizeof(myHeader.magic));
+
+		myHeader.version = LINEAGE_JOURNAL_VERSION;
+		myHeader.byteOrderMark = LINEAGE_JOURNAL_BYTE_ORDER_MARK;
+
+		returnValue = getNeuralNetworkWeightHash(initialNeuralNetwork, &(myHeader.initialWeightHash));
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		*myJournal = calloc(1, sizeof(LineageJournal));
+
+		if (*myJournal==NULL)
+			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		LineageJournal *newJournal = *myJournal;
+
+		newJournal->file = fopen(filePath, "wb");
+
+		if ((newJournal->file==NULL) || (fwrite(&myHeader, sizeof(myHeader), 1, newJournal->file)!=1) || (fflush(newJournal->file)==EOF))
+		{
+			if (newJournal->file!=NULL)
+				fclose(newJournal->file);
+
+			free(newJournal);
+
+			*myJournal = NULL;
+
+			returnValue = NEURAL_NETWORK_FILE_SAVE_ERROR;
+		}
+	}
+
+	return returnValue;
+}
+
+/*Open an existing journal to append the entries of an evolver resumed from a checkpoint, with the
+ *journal state of the checkpoint. The entries of the generations run after the checkpoint, and an
+ *incomplete last entry left by a crash, are cut from the file. The journal must start from the same
+ *neural network and its last remaining entry must be the last entry written before the checkpoint,
+ *otherwise the file is left untouched and the journal is not opened*/
+NeuralNetworkErrorCode openLineageJournal(LineageJournal **myJournal, const char *filePath, const EvolverJournalState *myState)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	LineageJournalHeader myHeader;
+	LineageJournalEntryHeader myEntryHeader;
+	struct stat myFileStatus;
+	uint64_t journalSize = sizeof(LineageJournalHeader);
+	uint64_t weightHash = 0;
+	int lastGenerationNumber = -1;
+	bool isJournalCompleted = false;
+
+	FILE *myFile = NULL;
+
+	if ((myJournal==NULL) || (filePath==NULL) || (myState==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		myFile = fopen(filePath, "r+b");
+
+		if ((myFile==NULL) || (fstat(fileno(myFile), &myFileStatus)!=0))
+			returnValue = NEURAL_NETWORK_FILE_LOAD_ERROR;
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = readLineageJournalHeader(myFile, &myHeader);
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myHeader.initialWeightHash!=myState->initialWeightHash))
+		returnValue = NEURAL_NETWORK_JOURNAL_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		weightHash = myHeader.initialWeightHash;
+
+	//Only the entry headers are read, the flips of the entries are skipped
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (!isJournalCompleted))
+	{
+		uint64_t remainingSize = (uint64_t) myFileStatus.st_size - journalSize;
+
+		if ((fread(&myEntryHeader, sizeof(myEntryHeader), 1, myFile)!=1) || (myEntryHeader.flipDataSize > remainingSize - sizeof(myEntryHeader)) ||
+			(myEntryHeader.generationNumber>=myState->nextGenerationNumber))
+		{
+			isJournalCompleted = true;
+		}
+		else if ((myEntryHeader.generationNumber<=lastGenerationNumber) || (fseek(myFile, (long) myEntryHeader.flipDataSize, SEEK_CUR)!=0))
+		{
+			returnValue = NEURAL_NETWORK_JOURNAL_ERROR;
+		}
+		else
+		{
+			journalSize += sizeof(myEntryHeader) + myEntryHeader.flipDataSize;
+			lastGenerationNumber = myEntryHeader.generationNumber;
+			weightHash = myEntryHeader.weightHash;
+		}
+	}
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && ((lastGenerationNumber!=myState->lastGenerationNumber) || (weightHash!=myState->weightHash)))
+		returnValue = NEURAL_NETWORK_JOURNAL_ERROR;
+
+	//The next entries are written after the last remaining entry
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) &&
+		((fflush(myFile)==EOF) || (ftruncate(fileno(myFile), (off_t) journalSize)!=0) || (fseek(myFile, (long) journalSize, SEEK_SET)!=0)))
+
+		returnValue = NEURAL_NETWORK_FILE_SAVE_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		*myJournal = calloc(1, sizeof(LineageJournal));
+
+		if (*myJournal==NULL)
+			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+		else
+			(*myJournal)->file = myFile;
+	}
+
+	if ((returnValue!=NEURAL_NETWORK_RETURN_VALUE_OK) && (myFile!=NULL))
+		fclose(myFile);
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode destroyLineageJournal(LineageJournal **myJournal)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myJournal==NULL) || (*myJournal==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		if (fclose((*myJournal)->file)==EOF)
+			returnValue = NEURAL_NETWORK_FILE_SAVE_ERROR;
+
+		free((*myJournal)->buffer);
+		free(*myJournal);
+
+		*myJournal = NULL;
+	}
+
+	return returnValue;
+}
+
+/*Append an entry to the journal. Each entry is flushed, so a crash can only lose the entries still in
+ *the buffers of the operating system, and replayLineageJournal ignores an incomplete last entry*/
+NeuralNetworkErrorCode writeLineageJournalEntry(const EvolverJournalEntry *myEntry, void *journalData)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	LineageJournal *myJournal = journalData;
+	LineageJournalEntryHeader myEntryHeader;
+
+	size_t flipDataSize = 0;
+
+	if ((myEntry==NULL) || (myJournal==NULL) || ((myEntry->flipArray==NULL) && (myEntry->numberOfFlips > 0)))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else if (myEntry->numberOfFlips < 0)
+		returnValue = NEURAL_NETWORK_JOURNAL_ERROR;
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && ((size_t) myEntry->numberOfFlips * LINEAGE_JOURNAL_MAXIMUM_FLIP_SIZE > myJournal->bufferCapacity))
+	{
+		size_t newBufferCapacity = (size_t) myEntry->numberOfFlips * LINEAGE_JOURNAL_MAXIMUM_FLIP_SIZE;
+
+		unsigned char *newBuffer = realloc(myJournal->buffer, newBufferCapacity);
+
+		if (newBuffer==NULL)
+		{
+			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+		}
+		else
+		{
+			myJournal->buffer = newBuffer;
+			myJournal->bufferCapacity = newBufferCapacity;
+		}
+	}
+
+	for (int i=0; (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (i < myEntry->numberOfFlips); i++)
+	{
+		const NeuralNetworkWeightFlip *myFlip = &(myEntry->flipArray[i]);
+
+		if ((myFlip->layerIndex < 0) || (myFlip->neuronIndex < 0) || (myFlip->weightIndex < 0) ||
+			(myFlip->weight < NEURON_WEIGHT_NEGATIVE) || (myFlip->weight > NEURON_WEIGHT_POSITIVE))
+		{
+			returnValue = NEURAL_NETWORK_JOURNAL_ERROR;
+		}
+		else
+		{
+			flipDataSize += encodeVariableLengthInteger((uint64_t) myFlip->layerIndex, myJournal->buffer + flipDataSize);
+			flipDataSize += encodeVariableLengthInteger((uint64_t) myFlip->neuronIndex, myJournal->buffer + flipDataSize);
+			flipDataSize += encodeVariableLengthInteger(3 * (uint64_t) myFlip->weightIndex + (uint64_t) (myFlip->weight - NEURON_WEIGHT_NEGATIVE), myJournal->buffer + flipDataSize);
+		}
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		myEntryHeader.generationNumber = myEntry->generationNumber;
+		myEntryHeader.fitnessScore = myEntry->fitnessScore;
+		myEntryHeader.numberOfFlips = (uint32_t) myEntry->numberOfFlips;
+		myEntryHeader.flipDataSize = (uint32_t) flipDataSize;
+		myEntryHeader.weightHash = myEntry->weightHash;
+
+		if ((fwrite(&myEntryHeader, sizeof(myEntryHeader), 1, myJournal->file)!=1) ||
+			((flipDataSize > 0) && (fwrite(myJournal->buffer, flipDataSize, 1, myJournal->file)!=1)) || (fflush(myJournal->file)==EOF))
+
+			returnValue = NEURAL_NETWORK_FILE_SAVE_ERROR;
+	}
+
+	return returnValue;
+}
+
+/*Apply the entries of a journal up to the given generation, or every entry with
+ *LINEAGE_JOURNAL_LAST_GENERATION, to a copy of the neural network given to the evolver that wrote the
+ *journal. The weight hash of the neural network is checked before the first entry and after each
+ *entry. The fitness score is the score of the last applied entry, or INT_MIN without entries. An
+ *incomplete last entry, left by a crash while it was written, is ignored*/
+NeuralNetworkErrorCode replayLineageJournal(const char *filePath, int generationNumber, NeuralNetwork *myNeuralNetwork, int *fitnessScore)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	LineageJournalHeader myHeader;
+	LineageJournalEntryHeader myEntryHeader;
+	struct stat myFileStatus;
+	unsigned char *flipData = NULL;
+	NeuralNetworkWeightFlip *flipArray = NULL;
+	size_t flipDataCapacity = 0;
+	size_t flipArrayCapacity = 0;
+	uint64_t remainingSize = 0;
+	uint64_t weightHash = 0;
+	int lastGenerationNumber = INT_MIN;
+	bool isJournalCompleted = false;
+
+	FILE *myFile = NULL;
+
+	if ((filePath==NULL) || (myNeuralNetwork==NULL) || (fitnessScore==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		myFile = fopen(filePath, "rb");
+
+		if ((myFile==NULL) || (fstat(fileno(myFile), &myFileStatus)!=0))
+			returnValue = NEURAL_NETWORK_FILE_LOAD_ERROR;
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = readLineageJournalHeader(myFile, &myHeader);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getNeuralNetworkWeightHash(myNeuralNetwork, &weightHash);
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (weightHash!=myHeader.initialWeightHash))
+		returnValue = NEURAL_NETWORK_JOURNAL_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		remainingSize = (uint64_t) myFileStatus.st_size - sizeof(myHeader);
+		*fitnessScore = INT_MIN;
+	}
+
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (!isJournalCompleted))
+	{
+		//The end of the file, an incomplete entry or an entry after the given generation complete the replay
+		if ((fread(&myEntryHeader, sizeof(myEntryHeader), 1, myFile)!=1) || (myEntryHeader.flipDataSize > remainingSize - sizeof(myEntryHeader)) ||
+			(myEntryHeader.generationNumber > generationNumber))
+		{
+			isJournalCompleted = true;
+		}
+		else if ((myEntryHeader.generationNumber<=lastGenerationNumber) || (myEntryHeader.numberOfFlips > INT_MAX) ||
+				 ((uint64_t) myEntryHeader.numberOfFlips * LINEAGE_JOURNAL_MINIMUM_FLIP_SIZE > myEntryHeader.flipDataSize))
+		{
+			returnValue = NEURAL_NETWORK_JOURNAL_ERROR;
+		}
+		else
+		{
+			remainingSize -= sizeof(myEntryHeader) + myEntryHeader.flipDataSize;
+			lastGenerationNumber = myEntryHeader.generationNumber;
+
+			//The sizes are bounded by the size of the file
+			if (myEntryHeader.flipDataSize > flipDataCapacity)
+			{
+				unsigned char *newFlipData = realloc(flipData, myEntryHeader.flipDataSize);
+
+				if (newFlipData==NULL)
+				{
+					returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+				}
+				else
+				{
+					flipData = newFlipData;
+					flipDataCapacity = myEntryHeader.flipDataSize;
+				}
+			}
+
+			if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myEntryHeader.numberOfFlips > flipArrayCapacity))
+			{
+				NeuralNetworkWeightFlip *newFlipArray = realloc(flipArray, sizeof(NeuralNetworkWeightFlip) * myEntryHeader.numberOfFlips);
+
+				if (newFlipArray==NULL)
+				{
+					returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+				}
+				else
+				{
+					flipArray = newFlipArray;
+					flipArrayCapacity = myEntryHeader.numberOfFlips;
+				}
+			}
+
+			if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myEntryHeader.flipDataSize > 0) && (fread(flipData, myEntryHeader.flipDataSize, 1, myFile)!=1))
+				returnValue = NEURAL_NETWORK_FILE_LOAD_ERROR;
+
+			if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+				returnValue = decodeFlips(flipData, myEntryHeader.flipDataSize, flipArray, (int) myEntryHeader.numberOfFlips);
+
+			if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (flipNeuralNetworkWeights(myNeuralNetwork, flipArray, (int) myEntryHeader.numberOfFlips)!=NEURAL_NETWORK_RETURN_VALUE_OK))
+				returnValue = NEURAL_NETWORK_JOURNAL_ERROR;
+
+			if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+				returnValue = getNeuralNetworkWeightHash(myNeuralNetwork, &weightHash);
+
+			if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (weightHash!=myEntryHeader.weightHash))
+				returnValue = NEURAL_NETWORK_JOURNAL_ERROR;
+
+			if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+				*fitnessScore = myEntryHeader.fitnessScore;
+		}
+	}
+
+	free(flipData);
+	free(flipArray);
+
+	if (myFile!=NULL)
+		fclose(myFile);
+
+	return returnValue;
+}
@@ -0,0 +1,57 @@
+/*
+ * LineageJournal.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#ifndef SRC_DATA_TIER_LINEAGEJOURNAL_H_
+#define SRC_DATA_TIER_LINEAGEJOURNAL_H_
+
+#include "../logic_tier/NeuralNetwork.h"
+#include "../logic_tier/Evolver.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define LINEAGE_JOURNAL_VERSION 1
+
+//Generation number of replayLineageJournal that replays every entry
+#define LINEAGE_JOURNAL_LAST_GENERATION INT_MAX
+
+/*A lineage journal file holds a header with the weight hash of the neural network given to the
+ *evolver, followed by the entries of the evolver journal, each one with an entry header and its flips.
+ *All the values are stored in the byte order of the machine that saved the file*/
+typedef struct
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t byteOrderMark;
+	uint64_t initialWeightHash;
+} LineageJournalHeader;
+
+/*The flips of an entry are stored in flipDataSize bytes, each flip as three variable-length integers:
+ *the layer index, the neuron index, and the weight index times 3 plus the weight plus 1. The weight
+ *hash is the hash of the best neural network after the flips*/
+typedef struct
+{
+	int32_t generationNumber;
+	int32_t fitnessScore;
+	uint32_t numberOfFlips;
+	uint32_t flipDataSize;
+	uint64_t weightHash;
+} LineageJournalEntryHeader;
+
+/*Append-only file with the lineage journal of an evolver. writeLineageJournalEntry is an evolver
+ *journal function with the journal as journal data*/
+typedef struct lineageJournal LineageJournal;
+
+NeuralNetworkErrorCode createLineageJournal(LineageJournal **myJournal, const char *filePath, NeuralNetwork *initialNeuralNetwork);
+NeuralNetworkErrorCode openLineageJournal(LineageJournal **myJournal, const char *filePath, const EvolverJournalState *myState);
+NeuralNetworkErrorCode destroyLineageJournal(LineageJournal **myJournal);
+NeuralNetworkErrorCode writeLineageJournalEntry(const EvolverJournalEntry *myEntry, void *journalData);
+NeuralNetworkErrorCode replayLineageJournal(const char *filePath, int generationNumber, NeuralNetwork *myNeuralNetwork, int *fitnessScore);
+
+#endif /* SRC_DATA_TIER_LINEAGEJOURNAL_H_ */
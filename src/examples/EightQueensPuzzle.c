@@ -25,6 +25,14 @@
  *branch is abandoned and a new evolutionary branch is created from scratch*/
 #define MAXIMUM_NUMBER_OF_GENERATIONS_WITHOUT_IMPROVING_SCORE 1000
 
+//The fitness function is deterministic, so the scores of the visited weights can be reused
+#define FITNESS_CACHE_SIZE 4096
+
+/*Each thread evolves its own island, and the islands send their best neural network to the next one
+ *every N generations. Frequent migrations make all the islands follow the same evolutionary branch,
+ *so N must be much larger than the number of generations of an abandoned evolutionary branch*/
+#define MIGRATION_INTERVAL 5000
+
 #define NEURAL_NETWORK_FILE_NAME "eight_queens_puzzle.json"
 
 typedef enum
@@ -176,7 +184,7 @@ static NeuralNetworkErrorCode playEightQueensPuzzle(NeuralNetwork *myNeuralNetwo
 		returnValue = enableInputNeurons(myNeuralNetwork);
 
 		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-			returnValue = computeNeuralNetworkOutput(myNeuralNetwork, &neuralNetworkOutput, &numberOfOutputs);
+			returnValue = computeNeuralNetworkCachedOutput(myNeuralNetwork, 0, &neuralNetworkOutput, &numberOfOutputs);
 
 		if ((numberOfOutputs!=NUMBER_OF_SQUARES) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK))
 			returnValue = NEURAL_NETWORK_NUMBER_OF_OUTPUT_NEURONS_ERROR;
@@ -188,81 +196,80 @@ static NeuralNetworkErrorCode playEightQueensPuzzle(NeuralNetwork *myNeuralNetwo
 	return returnValue;
 }
 
-static NeuralNetworkErrorCode trainNeuralNetwork(NeuralNetwork **myNeuralNetwork)
+//The puzzle is a single test case, so the evaluation can not be stopped early
+static NeuralNetworkErrorCode evaluateFitness(NeuralNetwork *myNeuralNetwork, int scoreToBeat, TestCaseIterator *myTestCaseIterator, void *userData, int *fitnessScore)
 {
 	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
-	NeuralNetwork *myNeuralNetworkClone = NULL;
-
 	GameBoard myGameBoard = {0};
 
-	bool trainingCompleted = false;
-	int generationNumber = 0;
-	int myNeuralNetworkScore = -INT_MAX;
-	int generationsWithoutImprovingScore = 0;
+	(void) scoreToBeat;
+	(void) myTestCaseIterator;
+	(void) userData;
 
-	if (myNeuralNetwork==NULL)
+	if (fitnessScore==NULL)
 		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
 	else
-		returnValue = createNeuralNetwork(&myNeuralNetworkClone, NUMBER_OF_INPUTS, NUMBER_OF_HIDDEN_LAYERS, NUMBER_OF_OUTPUTS);
+		returnValue = playEightQueensPuzzle(myNeuralNetwork, &myGameBoard);
 
-	//Play the game until T-Rex wins
-	while ((!trainingCompleted) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK))
-	{
-		generationNumber++;
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		*fitnessScore = myGameBoard.gameScore;
 
-		//Clone the reference neural network
-		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-			returnValue = cloneNeuralNetwork(*myNeuralNetwork, myNeuralNetworkClone);
+	return returnValue;
+}
 
-		//Mutate the neural network clone
-		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-			returnValue = mutateNeuralNetwork(myNeuralNetworkClone);
+static void printProgress(const EvolverProgress *myProgress, void *userData)
+{
+	(void) userData;
 
-		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-		{
-			returnValue = playEightQueensPuzzle(myNeuralNetworkClone, &myGameBoard);
-			printf("Generation: %d - Game score: %d\n", generationNumber, myGameBoard.gameScore);
-		}
+	if ((myProgress->generationNumber==0) && (myProgress->numberOfRestarts>0))
+		printf("\n%d generations without improving the game score, starting a new evolutionary branch ...\n\n", MAXIMUM_NUMBER_OF_GENERATIONS_WITHOUT_IMPROVING_SCORE);
 
-		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-		{
-			//Select the best neural network as the reference
-			if (myGameBoard.gameScore > myNeuralNetworkScore)
-			{
-				myNeuralNetworkScore = myGameBoard.gameScore;
+	printf("Generation: %d - Game score: %d\n", myProgress->generationNumber, myProgress->bestFitnessScore);
+}
 
-				NeuralNetwork *auxNeuralNetwork = *myNeuralNetwork;
-				*myNeuralNetwork = myNeuralNetworkClone;
-				myNeuralNetworkClone = auxNeuralNetwork;
+NeuralNetworkErrorCode initializeEightQueensPuzzleParameters(EvolverParameters *myParameters)
+{
+	NeuralNetworkErrorCode returnValue = initializeEvolverParameters(myParameters, NUMBER_OF_INPUTS, NUMBER_OF_HIDDEN_LAYERS, NUMBER_OF_OUTPUTS);
 
-				generationsWithoutImprovingScore = 0;
-			}
-			else
-			{
-				generationsWithoutImprovingScore++;
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		myParameters->targetFitnessScore = LEGAL_NUMBER_OF_QUEENS;
+		myParameters->maximumNumberOfGenerationsWithoutImproving = MAXIMUM_NUMBER_OF_GENERATIONS_WITHOUT_IMPROVING_SCORE;
+		myParameters->numberOfCachedTestCases = 1;
+		myParameters->fitnessCacheSize = FITNESS_CACHE_SIZE;
+		myParameters->fitnessFunction = evaluateFitness;
+		myParameters->progressFunction = printProgress;
+	}
 
-				if (generationsWithoutImprovingScore>MAXIMUM_NUMBER_OF_GENERATIONS_WITHOUT_IMPROVING_SCORE)
-				{
-					printf("\n%d generations without improving the game score, starting a new evolutionary branch ...\n\n", MAXIMUM_NUMBER_OF_GENERATIONS_WITHOUT_IMPROVING_SCORE);
+	return returnValue;
+}
 
-					generationNumber = 0;
-					myNeuralNetworkScore = -INT_MAX;
+static NeuralNetworkErrorCode trainNeuralNetwork(NeuralNetwork *myNeuralNetwork)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
-					returnValue = destroyNeuralNetwork(myNeuralNetwork);
+	EvolverParameters myParameters;
 
-					if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-						returnValue = createNeuralNetwork(myNeuralNetwork, NUMBER_OF_INPUTS, NUMBER_OF_HIDDEN_LAYERS, NUMBER_OF_OUTPUTS);
-				}
-			}
+	int myNeuralNetworkScore = 0;
+	int numberOfIslands = 0;
 
-			if (myGameBoard.gameScore==LEGAL_NUMBER_OF_QUEENS)
-				trainingCompleted = true;
-		}
+	if (myNeuralNetwork==NULL)
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = initializeEightQueensPuzzleParameters(&myParameters);
+
+	//One island per thread, each island evolves its population in a single thread
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		numberOfIslands = myParameters.numberOfThreads;
+		myParameters.numberOfThreads = 1;
 	}
 
+	//Play the game until T-Rex wins in any island
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-		returnValue = destroyNeuralNetwork(&myNeuralNetworkClone);
+		returnValue = runIslandEvolver(&myParameters, numberOfIslands, MIGRATION_INTERVAL, myNeuralNetwork, &myNeuralNetworkScore);
 
 	return returnValue;
 }
@@ -277,7 +284,7 @@ NeuralNetworkErrorCode runEightQueensPuzzle(void)
 	NeuralNetworkErrorCode returnValue = createNeuralNetwork(&myNeuralNetwork, NUMBER_OF_INPUTS, NUMBER_OF_HIDDEN_LAYERS, NUMBER_OF_OUTPUTS);
 
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-		returnValue = trainNeuralNetwork(&myNeuralNetwork);
+		returnValue = trainNeuralNetwork(myNeuralNetwork);
 
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
 		returnValue = playEightQueensPuzzle(myNeuralNetwork, &myGameBoard);
@@ -9,9 +9,11 @@
 #define EXAMPLES_EIGHTQUEENSPUZZLE_H_
 
 #include "../logic_tier/NeuralNetwork.h"
+#include "../logic_tier/IslandEvolver.h"
 #include "../presentation_tier/ConsoleManager.h"
 #include "../data_tier/DataManager.h"
 
+NeuralNetworkErrorCode initializeEightQueensPuzzleParameters(EvolverParameters *myParameters);
 NeuralNetworkErrorCode runEightQueensPuzzle(void);
 
 #endif /* EXAMPLES_EIGHTQUEENSPUZZLE_H_ */
@@ -24,6 +24,31 @@
 
 #define NUMBER_OF_MOVEMENTS_PER_TURN 1
 
+/*Each T-Rex turn is a test case of the activation cache: while the game is the same as the
+ *game of the parent, a child only computes the neurons changed by its mutation*/
+#define NUMBER_OF_TURNS ((NUMBER_OF_SQUARES + 1) / 2)
+
+/*The fitness score is the player's score, a victory or a draw get a bonus score and complete
+ *the training*/
+#define TARGET_FITNESS_SCORE (NUMBER_OF_COLUMNS + 1)
+
+//The fitness function is deterministic, so the scores of the visited weights can be reused
+#define FITNESS_CACHE_SIZE 4096
+
+/*The training is saved in the checkpoint file every N generations, and an interrupted training goes on
+ *from it the next time. The file is removed when the training is completed*/
+#define CHECKPOINT_INTERVAL 1000
+#define CHECKPOINT_FILE_NAME "tic_tac_toe.checkpoint"
+
+//Bit (row * NUMBER_OF_COLUMNS + column) of a bitboard is the square of that row and column
+#define FULL_GAME_BOARD_MASK ((1u << NUMBER_OF_SQUARES) - 1)
+
+//The rows, the columns and the two diagonals of the game board
+#define NUMBER_OF_LINES (NUMBER_OF_ROWS + NUMBER_OF_COLUMNS + 2)
+
+//The extra input is the last one, after the circles and the crosses
+#define EXTRA_INPUT_MASK (UINT64_C(1) << (NUMBER_OF_INPUTS - 1))
+
 typedef enum
 {
 	PLAYER_MARK_CIRCLE = 0x4F,
@@ -40,15 +65,38 @@ typedef enum
 	GAME_RESULT_ILLEGAL_MOVEMENT
 } GameResult;
 
-//The player's score is the highest number of marks in any line that does not contain any mark of the opponent
+/*The game board is stored as two bitboards, one with the circles and other with the crosses. The
+ *player's score is the highest number of marks in any line that does not contain any mark of the
+ *opponent*/
 typedef struct gameBoard
 {
-	char gameBoard[NUMBER_OF_ROWS][NUMBER_OF_COLUMNS];
+	uint16_t circleMask;
+	uint16_t crossMask;
 	int circlePlayerScore;
 	int crossPlayerScore;
 	GameResult gameResult;
 } GameBoard;
 
+//The lines are checked in the order of the rows, the columns and the diagonals
+static const uint16_t lineMaskArray[NUMBER_OF_LINES] =
+{
+	0x007, 0x038, 0x1C0,	//Rows
+	0x049, 0x092, 0x124,	//Columns
+	0x111, 0x054			//Diagonals
+};
+
+static PlayerMark getPlayerMark(const GameBoard *myGameBoard, int squareIndex)
+{
+	PlayerMark myPlayerMark = PLAYER_MARK_FREE;
+
+	if ((myGameBoard->circleMask >> squareIndex) & 1)
+		myPlayerMark = PLAYER_MARK_CIRCLE;
+	else if ((myGameBoard->crossMask >> squareIndex) & 1)
+		myPlayerMark = PLAYER_MARK_CROSS;
+
+	return myPlayerMark;
+}
+
 static void printGameBoard(GameBoard *myGameBoard)
 {
 	printf("\n");
@@ -61,7 +109,7 @@ static void printGameBoard(GameBoard *myGameBoard)
 		printf("-\n");
 
 		for (int j=0; j<NUMBER_OF_COLUMNS; j++)
-			printf("| %c ", myGameBoard->gameBoard [i][j]);
+			printf("| %c ", getPlayerMark(myGameBoard, i*NUMBER_OF_COLUMNS + j));
 
 		printf("|\n");
 	}
@@ -87,53 +135,15 @@ static void updatePlayerScore(GameBoard *myGameBoard, int numberOfCircles, int n
 		myGameBoard->gameResult = GAME_RESULT_PLAYER_CROSS_WINS;
 }
 
-static void checkHorizontalLines(GameBoard *myGameBoard)
-{
-	int i=0;
-
-	while ((i<NUMBER_OF_ROWS) && (myGameBoard->gameResult==GAME_RESULT_NO_WINNER))
-	{
-		int numberOfCircles = 0;
-		int numberOfCrosses = 0;
-
-		int j=0;
-
-		while (j<NUMBER_OF_COLUMNS)
-		{
-			if (myGameBoard->gameBoard[i][j]==PLAYER_MARK_CIRCLE)
-				numberOfCircles++;
-			else if (myGameBoard->gameBoard[i][j]==PLAYER_MARK_CROSS)
-				numberOfCrosses++;
-
-			j++;
-		}
-
-		updatePlayerScore(myGameBoard, numberOfCircles, numberOfCrosses);
-
-		i++;
-	}
-}
-
-static void checkVerticalLines(GameBoard *myGameBoard)
+//The marks of each line are counted with a popcount of the line mask and the bitboard of each player
+static void checkLines(GameBoard *myGameBoard)
 {
 	int i=0;
 
-	while ((i<NUMBER_OF_COLUMNS) && (myGameBoard->gameResult==GAME_RESULT_NO_WINNER))
+	while ((i<NUMBER_OF_LINES) && (myGameBoard->gameResult==GAME_RESULT_NO_WINNER))
 	{
-		int numberOfCircles = 0;
-		int numberOfCrosses = 0;
-
-		int j=0;
-
-		while (j<NUMBER_OF_ROWS)
-		{
-			if (myGameBoard->gameBoard[j][i]==PLAYER_MARK_CIRCLE)
-				numberOfCircles++;
-			else if (myGameBoard->gameBoard[j][i]==PLAYER_MARK_CROSS)
-				numberOfCrosses++;
-
-			j++;
-		}
+		int numberOfCircles = __builtin_popcount(myGameBoard->circleMask & lineMaskArray[i]);
+		int numberOfCrosses = __builtin_popcount(myGameBoard->crossMask & lineMaskArray[i]);
 
 		updatePlayerScore(myGameBoard, numberOfCircles, numberOfCrosses);
 
@@ -141,93 +151,28 @@ static void checkVerticalLines(GameBoard *myGameBoard)
 	}
 }
 
-static void checkDiagonals(GameBoard *myGameBoard)
-{
-	int i=0;
-	int j=0;
-	int numberOfCircles = 0;
-	int numberOfCrosses = 0;
-
-	//Check first diagonal
-	while ((i<NUMBER_OF_ROWS) && (j<NUMBER_OF_COLUMNS))
-	{
-		if (myGameBoard->gameBoard[i][j]==PLAYER_MARK_CIRCLE)
-			numberOfCircles++;
-		else if (myGameBoard->gameBoard[i][j]==PLAYER_MARK_CROSS)
-			numberOfCrosses++;
-
-		i++;
-		j++;
-	}
-
-	updatePlayerScore(myGameBoard, numberOfCircles, numberOfCrosses);
-
-	i=0;
-	j=NUMBER_OF_COLUMNS-1;
-
-	numberOfCircles = 0;
-	numberOfCrosses = 0;
-
-	//Check second diagonal
-	if (myGameBoard->gameResult==GAME_RESULT_NO_WINNER)
-	{
-		while ((i<NUMBER_OF_ROWS) && (j>=0))
-		{
-			if (myGameBoard->gameBoard[i][j]==PLAYER_MARK_CIRCLE)
-				numberOfCircles++;
-			else if (myGameBoard->gameBoard[i][j]==PLAYER_MARK_CROSS)
-				numberOfCrosses++;
-
-			i++;
-			j--;
-		}
-	}
-
-	updatePlayerScore(myGameBoard, numberOfCircles, numberOfCrosses);
-}
-
 static void checkStalemate(GameBoard *myGameBoard)
 {
-	bool stalemate = true;
-
-	int i=0;
-
-	while ((i<NUMBER_OF_ROWS) && (stalemate))
-	{
-		int j=0;
-
-		while ((j<NUMBER_OF_COLUMNS) && (stalemate))
-		{
-			if (myGameBoard->gameBoard[i][j]==PLAYER_MARK_FREE)
-				stalemate = false;
-
-			j++;
-		}
-
-		i++;
-	}
-
-	if (stalemate)
+	if ((myGameBoard->circleMask | myGameBoard->crossMask)==FULL_GAME_BOARD_MASK)
 		myGameBoard->gameResult = GAME_RESULT_DRAW;
 }
 
-static void getPlayerMarkCoordinates(NeuronData *neuralNetworkOutput, int numberOfOutputs, int *rowNumber, int *columnNumber, GameBoard *myGameBoard)
+//Without any active output the mark is placed in the first square
+static void getPlayerMarkSquare(NeuronData *neuralNetworkOutput, int numberOfOutputs, int *squareIndex, GameBoard *myGameBoard)
 {
-	bool coordinatesFound = false;
+	bool squareFound = false;
 	int neuralNetworkOutputIndex = 0;
 
-	int i=0;
-	int j=0;
+	*squareIndex = 0;
 
 	while ((neuralNetworkOutputIndex<numberOfOutputs) && (myGameBoard->gameResult==GAME_RESULT_NO_WINNER))
 	{
 		if (neuralNetworkOutput[neuralNetworkOutputIndex]==NEURON_DATA_ONE)
 		{
-			if (!coordinatesFound)
+			if (!squareFound)
 			{
-				*rowNumber = i;
-				*columnNumber = j;
-				coordinatesFound = true;
+				*squareIndex = neuralNetworkOutputIndex;
+				squareFound = true;
 			}
 			else
 			{
@@ -236,33 +181,24 @@ static void getPlayerMarkCoordinates(NeuronData *neuralNetworkOutput, int number
 		}
 
 		neuralNetworkOutputIndex++;
-
-		j++;
-
-		if (j>=NUMBER_OF_COLUMNS)
-		{
-			i++;
-			j=0;
-		}
 	}
 }
 
-static void evaluateMovement(int rowNumber, int columnNumber, PlayerMark myPlayerMark, GameBoard *myGameBoard)
+static void evaluateMovement(int squareIndex, PlayerMark myPlayerMark, GameBoard *myGameBoard)
 {
-	if (myGameBoard->gameBoard[rowNumber][columnNumber]==PLAYER_MARK_FREE)
+	uint16_t squareMask = (uint16_t) (1u << squareIndex);
+
+	if (((myGameBoard->circleMask | myGameBoard->crossMask) & squareMask)==0)
 	{
-		myGameBoard->gameBoard[rowNumber][columnNumber] = myPlayerMark;
+		if (myPlayerMark==PLAYER_MARK_CIRCLE)
+			myGameBoard->circleMask |= squareMask;
+		else
+			myGameBoard->crossMask |= squareMask;
 
 		checkStalemate(myGameBoard);
 
 		if (myGameBoard->gameResult==GAME_RESULT_NO_WINNER)
-			checkHorizontalLines(myGameBoard);
-
-		if (myGameBoard->gameResult==GAME_RESULT_NO_WINNER)
-			checkVerticalLines(myGameBoard);
-
-		if (myGameBoard->gameResult==GAME_RESULT_NO_WINNER)
-			checkDiagonals(myGameBoard);
+			checkLines(myGameBoard);
 	}
 	else
 		myGameBoard->gameResult = GAME_RESULT_ILLEGAL_MOVEMENT;
@@ -270,75 +206,26 @@ static void evaluateMovement(int rowNumber, int columnNumber, PlayerMark myPlaye
 
 static void evaluateNeuralNetworkOutput(NeuronData *neuralNetworkOutput, int numberOfOutputs, GameBoard *myGameBoard)
 {
-	int rowNumber = 0;
-	int columnNumber = 0;
+	int squareIndex = 0;
 
-	getPlayerMarkCoordinates(neuralNetworkOutput, numberOfOutputs, &rowNumber, &columnNumber, myGameBoard);
+	getPlayerMarkSquare(neuralNetworkOutput, numberOfOutputs, &squareIndex, myGameBoard);
 
 	if (myGameBoard->gameResult==GAME_RESULT_NO_WINNER)
-		evaluateMovement(rowNumber, columnNumber, PLAYER_MARK_CIRCLE, myGameBoard);
+		evaluateMovement(squareIndex, PLAYER_MARK_CIRCLE, myGameBoard);
 }
 
+//The circles are the first inputs and the crosses the next ones, so the bitboards are the packed input
 static NeuralNetworkErrorCode setGameBoardAsNeuralNetworkInput(GameBoard *myGameBoard, NeuralNetwork *myNeuralNetwork)
 {
-	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
-
-	//Create input arrays from the game board
-	NeuronData circleInputArray[NUMBER_OF_SQUARES];
-	NeuronData crossInputArray[NUMBER_OF_SQUARES];
+	uint64_t packedInput = myGameBoard->circleMask | ((uint64_t) myGameBoard->crossMask << NUMBER_OF_SQUARES) | EXTRA_INPUT_MASK;
 
-	int inputArrayIndex = 0;
-
-	for (int i=0; i<NUMBER_OF_ROWS; i++)
-		for (int j=0; j<NUMBER_OF_COLUMNS; j++)
-		{
-			PlayerMark myPlayerMark = myGameBoard->gameBoard[i][j];
-
-			if (myPlayerMark==PLAYER_MARK_CIRCLE)
-			{
-				circleInputArray[inputArrayIndex] = NEURON_DATA_ONE;
-				crossInputArray[inputArrayIndex] = NEURON_DATA_ZERO;
-			}
-			else if (myPlayerMark==PLAYER_MARK_CROSS)
-			{
-				circleInputArray[inputArrayIndex] = NEURON_DATA_ZERO;
-				crossInputArray[inputArrayIndex] = NEURON_DATA_ONE;
-			}
-			else if (myPlayerMark==PLAYER_MARK_FREE)
-			{
-				circleInputArray[inputArrayIndex] = NEURON_DATA_ZERO;
-				crossInputArray[inputArrayIndex] = NEURON_DATA_ZERO;
-			}
-
-			inputArrayIndex++;
-		}
-
-	inputArrayIndex = 0;
-
-	//Set the input arrays as the neural network input
-	while ((inputArrayIndex<NUMBER_OF_SQUARES) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK))
-	{
-		returnValue = setNeuralNetworkInput(myNeuralNetwork, inputArrayIndex, circleInputArray[inputArrayIndex]);
-
-		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-			returnValue = setNeuralNetworkInput(myNeuralNetwork, inputArrayIndex + NUMBER_OF_SQUARES, crossInputArray[inputArrayIndex]);
-
-		inputArrayIndex++;
-	}
-
-	//Set the extra input as active
-	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-		returnValue = setNeuralNetworkInput(myNeuralNetwork, NUMBER_OF_INPUTS - 1, NEURON_DATA_ONE);
-
-	return returnValue;
+	return setNeuralNetworkPackedInput(myNeuralNetwork, &packedInput);
 }
 
 static void initializeGameBoard(GameBoard *myGameBoard)
 {
-	for (int i=0; i<NUMBER_OF_ROWS; i++)
-		for (int j=0; j<NUMBER_OF_COLUMNS; j++)
-			myGameBoard->gameBoard[i][j] = PLAYER_MARK_FREE;
-
+	myGameBoard->circleMask = 0;
+	myGameBoard->crossMask = 0;
 	myGameBoard->circlePlayerScore = 0;
 	myGameBoard->crossPlayerScore = 0;
 	myGameBoard->gameResult = GAME_RESULT_NO_WINNER;
@@ -349,20 +236,19 @@ static void computeClassicAIoutput(GameBoard *myGameBoard)
 	GameBoard bestMovementGameBoard = *myGameBoard;
 	bool movementFound = false;
 
-	for (int i=0; i<NUMBER_OF_ROWS; i++)
-		for (int j=0; j<NUMBER_OF_COLUMNS; j++)
-		{
-			GameBoard myGameBoardCopy = *myGameBoard;
+	for (int i=0; i<NUMBER_OF_SQUARES; i++)
+	{
+		GameBoard myGameBoardCopy = *myGameBoard;
 
-			evaluateMovement(i, j, PLAYER_MARK_CROSS, &myGameBoardCopy);
+		evaluateMovement(i, PLAYER_MARK_CROSS, &myGameBoardCopy);
 
-			if ((myGameBoardCopy.gameResult!=GAME_RESULT_ILLEGAL_MOVEMENT) &&
-				(myGameBoardCopy.crossPlayerScore>=bestMovementGameBoard.crossPlayerScore))
-			{
-				bestMovementGameBoard = myGameBoardCopy;
-				movementFound = true;
-			}
+		if ((myGameBoardCopy.gameResult!=GAME_RESULT_ILLEGAL_MOVEMENT) &&
+			(myGameBoardCopy.crossPlayerScore>=bestMovementGameBoard.crossPlayerScore))
+		{
+			bestMovementGameBoard = myGameBoardCopy;
+			movementFound = true;
 		}
+	}
 
 	if (movementFound)
 		*myGameBoard = bestMovementGameBoard;
@@ -380,13 +266,15 @@ static void printNewGameMessage(void)
 	printf("------------------------------\n");
 }
 
-static NeuralNetworkErrorCode playGameAgainstClassicAI(NeuralNetwork *myNeuralNetwork, GameBoard *myGameBoard)
+//The game is only printed when printGame is true, because the training plays many games at the same time
+static NeuralNetworkErrorCode playGameAgainstClassicAI(NeuralNetwork *myNeuralNetwork, GameBoard *myGameBoard, bool printGame)
 {
 	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
 	//Neural network output
 	NeuronData *neuralNetworkOutput = NULL;
 	int numberOfOutputs = 0;
+	int turnNumber = 0;
 
 	if ((myNeuralNetwork==NULL) || (myGameBoard==NULL))
 	{
@@ -395,7 +283,9 @@ static NeuralNetworkErrorCode playGameAgainstClassicAI(NeuralNetwork *myNeuralNe
 	else
 	{
 		initializeGameBoard(myGameBoard);
-		printNewGameMessage();
+
+		if (printGame)
+			printNewGameMessage();
 	}
 
 	while ((myGameBoard->gameResult==GAME_RESULT_NO_WINNER) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK))
@@ -404,7 +294,7 @@ static NeuralNetworkErrorCode playGameAgainstClassicAI(NeuralNetwork *myNeuralNe
 		returnValue = setGameBoardAsNeuralNetworkInput(myGameBoard, myNeuralNetwork);
 
 		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-			returnValue = computeNeuralNetworkOutput(myNeuralNetwork, &neuralNetworkOutput, &numberOfOutputs);
+			returnValue = computeNeuralNetworkCachedOutput(myNeuralNetwork, turnNumber, &neuralNetworkOutput, &numberOfOutputs);
 
 		if ((numberOfOutputs!=NUMBER_OF_SQUARES) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK))
 			returnValue = NEURAL_NETWORK_NUMBER_OF_OUTPUT_NEURONS_ERROR;
@@ -412,12 +302,17 @@ static NeuralNetworkErrorCode playGameAgainstClassicAI(NeuralNetwork *myNeuralNe
 		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
 			evaluateNeuralNetworkOutput(neuralNetworkOutput, numberOfOutputs, myGameBoard);
 
+		turnNumber++;
+
 		if ((myGameBoard->gameResult!=GAME_RESULT_ILLEGAL_MOVEMENT) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK))
 		{
-			printf("\nT-Rex moves - Score: %d\n", myGameBoard->circlePlayerScore);
-			printGameBoard(myGameBoard);
+			if (printGame)
+			{
+				printf("\nT-Rex moves - Score: %d\n", myGameBoard->circlePlayerScore);
+				printGameBoard(myGameBoard);
+			}
 		}
-		else
+		else if (printGame)
 			printf("\nGAME OVER: T-Rex has tried an illegal movement\n\n");
 
 		//Classic AI's movement
@@ -425,19 +320,22 @@ static NeuralNetworkErrorCode playGameAgainstClassicAI(NeuralNetwork *myNeuralNe
 		{
 			computeClassicAIoutput(myGameBoard);
 
-			if (myGameBoard->gameResult!=GAME_RESULT_ILLEGAL_MOVEMENT)
+			if ((myGameBoard->gameResult!=GAME_RESULT_ILLEGAL_MOVEMENT) && (printGame))
 			{
 				printf("\nClassic AI moves - Score: %d\n", myGameBoard->crossPlayerScore);
 				printGameBoard(myGameBoard);
 			}
 		}
 
-		if (myGameBoard->gameResult==GAME_RESULT_PLAYER_CIRCLE_WINS)
-			printf("\nT-Rex wins the game\n\n");
-		else if (myGameBoard->gameResult==GAME_RESULT_PLAYER_CROSS_WINS)
-			printf("\nClassic AI wins the game\n\n");
-		else if (myGameBoard->gameResult==GAME_RESULT_DRAW)
-			printf("\nDraw\n\n");
+		if (printGame)
+		{
+			if (myGameBoard->gameResult==GAME_RESULT_PLAYER_CIRCLE_WINS)
+				printf("\nT-Rex wins the game\n\n");
+			else if (myGameBoard->gameResult==GAME_RESULT_PLAYER_CROSS_WINS)
+				printf("\nClassic AI wins the game\n\n");
+			else if (myGameBoard->gameResult==GAME_RESULT_DRAW)
+				printf("\nDraw\n\n");
+		}
 	}
 
 	return returnValue;
@@ -451,75 +349,130 @@ static bool isTRexVictoryOrDraw(GameBoard *myGameBoard)
 	return isTRexVictoryOrDraw;
 }
 
-static NeuralNetworkErrorCode trainNeuralNetwork(NeuralNetwork **myNeuralNetwork)
+//A single game is played, so the evaluation can not be stopped before the end of the game
+static NeuralNetworkErrorCode evaluateFitness(NeuralNetwork *myNeuralNetwork, int scoreToBeat, TestCaseIterator *myTestCaseIterator, void *userData, int *fitnessScore)
 {
 	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
-	NeuralNetwork *myNeuralNetworkClone = NULL;
-
 	GameBoard myGameBoard = {0};
 
-	bool trainingCompleted = false;
-	int generationNumber = 0;
-	int myNeuralNetworkScore = 0;
+	(void) scoreToBeat;
+	(void) myTestCaseIterator;
+	(void) userData;
 
-	if (myNeuralNetwork==NULL)
+	if (fitnessScore==NULL)
 		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
 	else
-		returnValue = createNeuralNetwork(&myNeuralNetworkClone, NUMBER_OF_INPUTS, NUMBER_OF_HIDDEN_LAYERS, NUMBER_OF_OUTPUTS);
+		returnValue = playGameAgainstClassicAI(myNeuralNetwork, &myGameBoard, false);
 
-	//Play the game until T-Rex wins or the game ends in a draw
-	while ((!trainingCompleted) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK))
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
 	{
-		generationNumber++;
+		if (isTRexVictoryOrDraw(&myGameBoard))
+			*fitnessScore = TARGET_FITNESS_SCORE;
+		else
+			*fitnessScore = myGameBoard.circlePlayerScore;
+	}
 
-		//Clone the reference neural network
-		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-			returnValue = cloneNeuralNetwork(*myNeuralNetwork, myNeuralNetworkClone);
+	return returnValue;
+}
 
-		//Mutate the neural network clone
-		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-			returnValue = mutateNeuralNetwork(myNeuralNetworkClone);
+static void printProgress(const EvolverProgress *myProgress, void *userData)
+{
+	(void) userData;
 
-		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-		{
-			returnValue = playGameAgainstClassicAI(myNeuralNetworkClone, &myGameBoard);
-			printf("Generation: %d\n\n\n", generationNumber);
-		}
+	printf("Generation: %d - Score: %d\n", myProgress->generationNumber, myProgress->bestFitnessScore);
+}
 
-		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-		{
-			//Select the best neural network as the reference
-			if (myGameBoard.circlePlayerScore > myNeuralNetworkScore)
-			{
-				myNeuralNetworkScore = myGameBoard.circlePlayerScore;
+NeuralNetworkErrorCode initializeTicTacToeParameters(EvolverParameters *myParameters)
+{
+	NeuralNetworkErrorCode returnValue = initializeEvolverParameters(myParameters, NUMBER_OF_INPUTS, NUMBER_OF_HIDDEN_LAYERS, NUMBER_OF_OUTPUTS);
 
-				NeuralNetwork *auxNeuralNetwork = *myNeuralNetwork;
-				*myNeuralNetwork = myNeuralNetworkClone;
-				myNeuralNetworkClone = auxNeuralNetwork;
-			}
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		myParameters->targetFitnessScore = TARGET_FITNESS_SCORE;
+		myParameters->numberOfCachedTestCases = NUMBER_OF_TURNS;
+		myParameters->fitnessCacheSize = FITNESS_CACHE_SIZE;
+		myParameters->fitnessFunction = evaluateFitness;
+		myParameters->progressFunction = printProgress;
+	}
 
-			if (isTRexVictoryOrDraw(&myGameBoard))
-				trainingCompleted = true;
-		}
+	return returnValue;
+}
+
+static NeuralNetworkErrorCode trainNeuralNetwork(NeuralNetwork *myNeuralNetwork)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	EvolverParameters myParameters;
+	Evolver *myEvolver = NULL;
+	CheckpointWriter *myCheckpointWriter = NULL;
+
+	void *checkpoint = NULL;
+	size_t checkpointSize = 0;
+	int myNeuralNetworkScore = 0;
+
+	if (myNeuralNetwork==NULL)
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = initializeTicTacToeParameters(&myParameters);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = createCheckpointWriter(&myCheckpointWriter, CHECKPOINT_FILE_NAME);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		myParameters.checkpointInterval = CHECKPOINT_INTERVAL;
+		myParameters.checkpointFunction = writeCheckpoint;
+		myParameters.checkpointData = myCheckpointWriter;
+
+		returnValue = createEvolver(&myEvolver, &myParameters);
+	}
+
+	//Play the game until T-Rex wins or the game ends in a draw, from the last checkpoint if there is one
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (loadCheckpoint(CHECKPOINT_FILE_NAME, &checkpoint, &checkpointSize)==NEURAL_NETWORK_RETURN_VALUE_OK))
+	{
+		printf("Resuming the training from %s\n\n", CHECKPOINT_FILE_NAME);
+
+		returnValue = resumeEvolver(myEvolver, checkpoint, checkpointSize, myNeuralNetwork, &myNeuralNetworkScore);
 	}
+	else if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		returnValue = runEvolver(myEvolver, myNeuralNetwork, &myNeuralNetworkScore);
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = destroyEvolver(&myEvolver);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = destroyCheckpointWriter(&myCheckpointWriter);
 
+	//The training is completed, so it will not be resumed
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-		returnValue = destroyNeuralNetwork(&myNeuralNetworkClone);
+		remove(CHECKPOINT_FILE_NAME);
+
+	free(checkpoint);
 
 	return returnValue;
 }
 
 NeuralNetworkErrorCode runTicTacToe(void)
 {
-	printf("\n----- TIC-TAC-TOE -----\n");
+	printf("\n----- TIC-TAC-TOE -----\n\n");
 
 	NeuralNetwork *myNeuralNetwork;
+	GameBoard myGameBoard;
 
 	NeuralNetworkErrorCode returnValue = createNeuralNetwork(&myNeuralNetwork, NUMBER_OF_INPUTS, NUMBER_OF_HIDDEN_LAYERS, NUMBER_OF_OUTPUTS);
 
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-		returnValue = trainNeuralNetwork(&myNeuralNetwork);
+		returnValue = trainNeuralNetwork(myNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		printf("\n\nShowing the game of the trained neural network\n");
+		returnValue = playGameAgainstClassicAI(myNeuralNetwork, &myGameBoard, true);
+	}
 
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
 		returnValue = destroyNeuralNetwork(&myNeuralNetwork);
@@ -9,8 +9,11 @@
 #define EXAMPLES_TICTACTOE_H_
 
 #include "../logic_tier/NeuralNetwork.h"
+#include "../logic_tier/Evolver.h"
 #include "../presentation_tier/ConsoleManager.h"
+#include "../data_tier/CheckpointFile.h"
 
+NeuralNetworkErrorCode initializeTicTacToeParameters(EvolverParameters *myParameters);
 NeuralNetworkErrorCode runTicTacToe(void);
 
 #endif /* EXAMPLES_TICTACTOE_H_ */
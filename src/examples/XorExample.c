@@ -14,105 +14,114 @@
 #define NUMBER_OF_TEST_CASES 4
 #define TARGET_FITNESS_SCORE NUMBER_OF_TEST_CASES
 
+//The fitness function is deterministic, so the scores of the visited weights can be reused
+#define FITNESS_CACHE_SIZE 4096
+
 #define NEURAL_NETWORK_FILE_NAME "xor.json"
+#define LINEAGE_JOURNAL_FILE_NAME "xor.journal"
 
 static const NeuronData xorInput[NUMBER_OF_TEST_CASES][NUMBER_OF_INPUTS] = {{0, 0}, {0, 1}, {1, 0}, {1, 1}};
 static const NeuronData xorOutput[NUMBER_OF_TEST_CASES] = {0, 1, 1, 0};
 
 
-static NeuralNetworkErrorCode evaluateFitness(NeuralNetwork *myNeuralNetwork, int *fitnessScore)
+/*Each test case scores one point. The test case iterator stops as soon as the neural network can not
+ *beat the score to beat, and starts with the test cases that rejected more children*/
+static NeuralNetworkErrorCode evaluateFitness(NeuralNetwork *myNeuralNetwork, int scoreToBeat, TestCaseIterator *myTestCaseIterator, void *userData, int *fitnessScore)
 {
 	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
+	NeuronData *neuralNetworkOutput;
+
+	int numberOfOutputs = 0;
 	int xorInputIndex = 0;
-	int score = 0;
 
-	NeuronData *neuralNetworkOutput;
-	int numberOfOutputs;
+	(void) scoreToBeat;
+	(void) userData;
 
-	if ((myNeuralNetwork==NULL) || (fitnessScore==NULL))
+	if ((myNeuralNetwork==NULL) || (myTestCaseIterator==NULL) || (fitnessScore==NULL))
 		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
 
-	while ((xorInputIndex<NUMBER_OF_TEST_CASES) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK))
+	//Evaluate output, one test case at a time with the buffers of the neural network
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (getNextTestCase(myTestCaseIterator, &xorInputIndex)))
 	{
-		int neuralNetworkInputIndex = 0;
-
-		while ((neuralNetworkInputIndex<NUMBER_OF_INPUTS) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK))
-		{
-			NeuronData neuralNetworkInput = xorInput[xorInputIndex][neuralNetworkInputIndex];
-
-			returnValue = setNeuralNetworkInput(myNeuralNetwork, neuralNetworkInputIndex, neuralNetworkInput);
-
-			neuralNetworkInputIndex++;
-		}
+		for (int i=0; (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (i<NUMBER_OF_INPUTS); i++)
+			returnValue = setNeuralNetworkInput(myNeuralNetwork, i, xorInput[xorInputIndex][i]);
 
 		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
 			returnValue = computeNeuralNetworkOutput(myNeuralNetwork, &neuralNetworkOutput, &numberOfOutputs);
 
-		//Evaluate output
 		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-		{
-			if (neuralNetworkOutput[0]==xorOutput[xorInputIndex])
-				score++;
-		}
-
-		xorInputIndex++;
+			returnValue = addTestCaseScore(myTestCaseIterator, (neuralNetworkOutput[0]==xorOutput[xorInputIndex]) ? 1 : 0);
 	}
 
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-		*fitnessScore = score;
+		*fitnessScore = getTestCaseIterationScore(myTestCaseIterator);
+
+	return returnValue;
+}
+
+static void printProgress(const EvolverProgress *myProgress, void *userData)
+{
+	(void) userData;
+
+	printf("\nCurrent generation: %d, score: %d", myProgress->generationNumber, myProgress->bestFitnessScore);
+}
+
+/*Evolver parameters of the example, the training benchmark replaces the seed and the progress
+ *function before training with them*/
+NeuralNetworkErrorCode initializeXorExampleParameters(EvolverParameters *myParameters)
+{
+	NeuralNetworkErrorCode returnValue = initializeEvolverParameters(myParameters, NUMBER_OF_INPUTS, NUMBER_OF_HIDDEN_LAYERS, NUMBER_OF_OUTPUTS);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		myParameters->targetFitnessScore = TARGET_FITNESS_SCORE;
+		myParameters->fitnessCacheSize = FITNESS_CACHE_SIZE;
+		myParameters->numberOfTestCases = NUMBER_OF_TEST_CASES;
+		myParameters->fitnessFunction = evaluateFitness;
+		myParameters->progressFunction = printProgress;
+	}
 
 	return returnValue;
 }
 
-static NeuralNetworkErrorCode trainNeuralNetwork(NeuralNetwork **myNeuralNetwork)
+static NeuralNetworkErrorCode trainNeuralNetwork(NeuralNetwork *myNeuralNetwork)
 {
 	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
-	NeuralNetwork *myNeuralNetworkClone;
+	EvolverParameters myParameters;
+	Evolver *myEvolver = NULL;
+	LineageJournal *myJournal = NULL;
 
-	int generationNumber = 1;
 	int myNeuralNetworkScore = 0;
-	int myNeuralNetworkCloneScore = 0;
 
 	if (myNeuralNetwork==NULL)
 		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
 
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-		returnValue = createNeuralNetwork(&myNeuralNetworkClone, NUMBER_OF_INPUTS, NUMBER_OF_HIDDEN_LAYERS, NUMBER_OF_OUTPUTS);
-
-	while ((myNeuralNetworkScore<TARGET_FITNESS_SCORE) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK))
-	{
-		returnValue = evaluateFitness(*myNeuralNetwork, &myNeuralNetworkScore);
-
-		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-			returnValue = evaluateFitness(myNeuralNetworkClone, &myNeuralNetworkCloneScore);
-
-		//Set the best scoring neural network as the reference
-		if (myNeuralNetworkCloneScore>myNeuralNetworkScore)
-		{
-			NeuralNetwork *auxNeuralNetwork = *myNeuralNetwork;
-			*myNeuralNetwork = myNeuralNetworkClone;
-			myNeuralNetworkClone = auxNeuralNetwork;
+		returnValue = initializeXorExampleParameters(&myParameters);
 
-			myNeuralNetworkScore = myNeuralNetworkCloneScore;
-		}
+	//The journal records the weights changed by each improvement of the best neural network
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = createLineageJournal(&myJournal, LINEAGE_JOURNAL_FILE_NAME, myNeuralNetwork);
 
-		printf("\nCurrent generation: %d, score: %d", generationNumber, myNeuralNetworkScore);
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		myParameters.journalFunction = writeLineageJournalEntry;
+		myParameters.journalData = myJournal;
 
-		//Clone the best neural network
-		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-			returnValue = cloneNeuralNetwork(*myNeuralNetwork, myNeuralNetworkClone);
+		returnValue = createEvolver(&myEvolver, &myParameters);
+	}
 
-		//Mutate the neural network clone
-		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-			returnValue = mutateNeuralNetwork(myNeuralNetworkClone);
+	//Evolve the neural network until it passes all the test cases
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = runEvolver(myEvolver, myNeuralNetwork, &myNeuralNetworkScore);
 
-		generationNumber++;
-	}
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = destroyEvolver(&myEvolver);
 
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-		returnValue = destroyNeuralNetwork(&myNeuralNetworkClone);
+		returnValue = destroyLineageJournal(&myJournal);
 
 	return returnValue;
 }
@@ -157,11 +166,21 @@ NeuralNetworkErrorCode runXorExample(void)
 
 	NeuralNetwork *myNeuralNetwork;
 	NeuralNetwork *myLoadedNeuralNetwork;
+	NeuralNetwork *myRebuiltNeuralNetwork;
+
+	int myRebuiltNeuralNetworkScore = 0;
 
 	NeuralNetworkErrorCode returnValue = createNeuralNetwork(&myNeuralNetwork, NUMBER_OF_INPUTS, NUMBER_OF_HIDDEN_LAYERS, NUMBER_OF_OUTPUTS);
 
+	//The lineage journal is replayed on a copy of the untrained neural network
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = createNeuralNetwork(&myRebuiltNeuralNetwork, NUMBER_OF_INPUTS, NUMBER_OF_HIDDEN_LAYERS, NUMBER_OF_OUTPUTS);
+
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-		returnValue = trainNeuralNetwork(&myNeuralNetwork);
+		returnValue = cloneNeuralNetwork(myNeuralNetwork, myRebuiltNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = trainNeuralNetwork(myNeuralNetwork);
 
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
 	{
@@ -187,11 +206,26 @@ NeuralNetworkErrorCode runXorExample(void)
 		returnValue = printNeuralNetworkResults(myLoadedNeuralNetwork);
 	}
 
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		printf("\n\nRebuilding the trained neural network from the lineage journal\n");
+		returnValue = replayLineageJournal(LINEAGE_JOURNAL_FILE_NAME, LINEAGE_JOURNAL_LAST_GENERATION, myRebuiltNeuralNetwork, &myRebuiltNeuralNetworkScore);
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		printf("\nShowing the output of the neural network rebuilt from the lineage journal\n\n\n");
+		returnValue = printNeuralNetworkResults(myRebuiltNeuralNetwork);
+	}
+
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
 		returnValue = destroyNeuralNetwork(&myNeuralNetwork);
 
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
 		returnValue = destroyNeuralNetwork(&myLoadedNeuralNetwork);
 
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = destroyNeuralNetwork(&myRebuiltNeuralNetwork);
+
 	return returnValue;
 }
@@ -9,9 +9,11 @@
 #define EXAMPLES_XOREXAMPLE_H_
 
 #include "../logic_tier/NeuralNetwork.h"
+#include "../logic_tier/Evolver.h"
 #include "../presentation_tier/ConsoleManager.h"
 #include "../data_tier/DataManager.h"
 
+NeuralNetworkErrorCode initializeXorExampleParameters(EvolverParameters *myParameters);
 NeuralNetworkErrorCode runXorExample(void);
 
 #endif /* EXAMPLES_XOREXAMPLE_H_ */
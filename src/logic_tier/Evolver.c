@@ -0,0 +1,1245 @@
+/*
+ * Evolver.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#include "Evolver.h"
+
+#define EVOLVER_CHECKPOINT_MAGIC "T-REX-EV"
+#define EVOLVER_CHECKPOINT_VERSION 2
+
+//Every section of a checkpoint starts at a multiple of this size
+#define EVOLVER_CHECKPOINT_ALIGNMENT 8
+
+/*Fitness cache entry, the last use is 0 in an empty entry. The entries of a set are stored together
+ *and the set of a neural network is selected by its weight hash. A rejected neural network keeps the
+ *score to beat that rejected it, which is an upper bound of its fitness score*/
+typedef struct
+{
+	uint64_t weightHash;
+	uint64_t lastUse;
+	int fitnessScore;
+	bool isUpperBound;
+} FitnessCacheEntry;
+
+/*Header of a checkpoint, with the sizes that must match the evolver that restores it, the counters
+ *of runEvolver and the state of the lineage journal. All the values are stored in the byte order of
+ *the machine*/
+typedef struct
+{
+	char magic[8];
+	uint32_t version;
+	int32_t populationSize;
+	uint64_t layerRegionSize;
+	int32_t numberOfParents;
+	int32_t numberOfFitnessCacheSets;
+	int32_t numberOfTestCases;
+	int32_t generationNumber;
+	int32_t bestFitnessScore;
+	int32_t numberOfRestarts;
+	int32_t generationsWithoutImproving;
+	int32_t totalNumberOfGenerations;
+	int32_t isJournalEnabled;
+	int32_t journalGenerationNumber;
+	int64_t numberOfEvaluations;
+	int64_t numberOfFitnessCacheHits;
+	int64_t numberOfFitnessCacheMisses;
+	uint64_t fitnessCacheClock;
+	uint64_t journalInitialWeightHash;
+	uint64_t journalWeightHash;
+} CheckpointHeader;
+
+/*Offsets of the sections of a checkpoint: the header, the random generator, the score and the layer
+ *region of each neural network of the population, the fitness cache, the order and the rejection
+ *counters of the test case schedule, and the layer region of the journal neural network if the
+ *evolver keeps a journal*/
+typedef struct
+{
+	size_t generatorOffset;
+	size_t fitnessScoreOffset;
+	size_t layerRegionOffset;
+	size_t layerRegionSize;
+	size_t layerRegionStride;
+	size_t fitnessCacheOffset;
+	size_t testCaseOrderOffset;
+	size_t rejectionCountOffset;
+	size_t journalLayerRegionOffset;
+	size_t checkpointSize;
+} CheckpointLayout;
+
+/*The population holds the parents followed by the children. The jobs of a generation are shared by
+ *the worker threads and the thread that runs the evolver through the job counters. The origin array
+ *holds the parent each child was created from, or NULL if the child does not come from a parent. The
+ *score to beat of the current generation is the score of the worst parent. The progress and the
+ *generation counters are the state of runEvolver, kept here so a checkpoint can save them. The
+ *journal neural network is a copy of the best neural network of the last journal entry, which is the
+ *entry of journalGenerationNumber, or -1 before the first entry*/
+typedef struct evolver
+{
+	EvolverParameters parameters;
+	int populationSize;
+	NeuralNetwork **populationArray;
+	NeuralNetwork **originArray;
+	int *fitnessScoreArray;
+	pthread_t *threadArray;
+	int numberOfWorkerThreads;
+	pthread_mutex_t jobMutex;
+	pthread_cond_t jobAvailableCondition;
+	pthread_cond_t jobsCompletedCondition;
+	int nextJob;
+	int lastJob;
+	int pendingJobs;
+	int scoreToBeat;
+	bool isCreatingChildren;
+	bool isShuttingDown;
+	NeuralNetworkErrorCode jobResult;
+	FitnessCacheEntry *fitnessCacheArray;
+	int numberOfFitnessCacheSets;
+	uint64_t fitnessCacheClock;
+	long long numberOfFitnessCacheHits;
+	long long numberOfFitnessCacheMisses;
+	pthread_mutex_t fitnessCacheMutex;
+	TestCaseSchedule *testCaseSchedule;
+	EvolverProgress progress;
+	int generationsWithoutImproving;
+	int totalNumberOfGenerations;
+	CheckpointLayout checkpointLayout;
+	unsigned char *checkpointBuffer;
+	NeuralNetwork *journalNeuralNetwork;
+	uint64_t journalWeightHash;
+	uint64_t journalInitialWeightHash;
+	int journalGenerationNumber;
+	NeuralNetworkWeightFlip *journalFlipArray;
+	int journalFlipCapacity;
+} Evolver;
+
+/*A child is a mutated clone of a parent, each parent gets the same number of children. The parents
+ *are not modified while the children are created, so the children can be created in parallel. A
+ *child that was rejected is turned back into its parent by reverting its mutation, which only copies
+ *the mutated weights, and it is only cloned again when it must become the child of another parent*/
+static NeuralNetworkErrorCode createChild(Evolver *myEvolver, int populationIndex)
+{
+	NeuralNetworkErrorCode returnValue;
+
+	int numberOfParents = myEvolver->parameters.numberOfParents;
+
+	NeuralNetwork *myParent = myEvolver->populationArray[(populationIndex - numberOfParents) % numberOfParents];
+	NeuralNetwork *myChild = myEvolver->populationArray[populationIndex];
+
+	if (myEvolver->originArray[populationIndex]==myParent)
+		returnValue = revertNeuralNetworkMutation(myChild);
+	else
+		returnValue = cloneNeuralNetwork(myParent, myChild);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = mutateNeuralNetwork(myChild);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		myEvolver->originArray[populationIndex] = myParent;
+	else
+		myEvolver->originArray[populationIndex] = NULL;
+
+	return returnValue;
+}
+
+//Fitness cache operations, the fitness cache mutex must be locked
+
+static FitnessCacheEntry *getFitnessCacheSet(Evolver *myEvolver, uint64_t weightHash)
+{
+	size_t setIndex = ((weightHash >> 32) * (uint64_t) myEvolver->numberOfFitnessCacheSets) >> 32;
+
+	return &(myEvolver->fitnessCacheArray[setIndex * EVOLVER_FITNESS_CACHE_WAYS]);
+}
+
+//Find the entry of the weights and mark it as the most recently used, or return NULL
+static FitnessCacheEntry *findFitnessCacheEntry(Evolver *myEvolver, uint64_t weightHash)
+{
+	FitnessCacheEntry *mySet = getFitnessCacheSet(myEvolver, weightHash);
+	FitnessCacheEntry *myEntry = NULL;
+
+	for (int i=0; (i < EVOLVER_FITNESS_CACHE_WAYS) && (myEntry==NULL); i++)
+	{
+		if ((mySet[i].lastUse!=0) && (mySet[i].weightHash==weightHash))
+		{
+			myEvolver->fitnessCacheClock++;
+			mySet[i].lastUse = myEvolver->fitnessCacheClock;
+
+			myEntry = &mySet[i];
+		}
+	}
+
+	return myEntry;
+}
+
+//An upper bound is only a valid score while it can not beat the score to beat
+static bool findCachedFitnessScore(Evolver *myEvolver, uint64_t weightHash, int scoreToBeat, int *fitnessScore)
+{
+	FitnessCacheEntry *myEntry = findFitnessCacheEntry(myEvolver, weightHash);
+
+	bool isCached = (myEntry!=NULL) && ((!myEntry->isUpperBound) || (myEntry->fitnessScore <= scoreToBeat));
+
+	if (isCached)
+		*fitnessScore = myEntry->fitnessScore;
+
+	return isCached;
+}
+
+//Replace the least recently used entry of the set, an empty entry is always the least recently used
+static void storeFitnessScore(Evolver *myEvolver, uint64_t weightHash, int fitnessScore, bool isUpperBound)
+{
+	FitnessCacheEntry *mySet = getFitnessCacheSet(myEvolver, weightHash);
+	FitnessCacheEntry *oldestEntry = &mySet[0];
+
+	for (int i=1; i < EVOLVER_FITNESS_CACHE_WAYS; i++)
+	{
+		if (mySet[i].lastUse < oldestEntry->lastUse)
+			oldestEntry = &mySet[i];
+	}
+
+	myEvolver->fitnessCacheClock++;
+
+	oldestEntry->weightHash = weightHash;
+	oldestEntry->lastUse = myEvolver->fitnessCacheClock;
+	oldestEntry->fitnessScore = fitnessScore;
+	oldestEntry->isUpperBound = isUpperBound;
+}
+
+//Call the fitness function, with a test case iterator if the evolver has a test case schedule
+static NeuralNetworkErrorCode computeFitnessScore(Evolver *myEvolver, NeuralNetwork *myNeuralNetwork, int scoreToBeat, int *fitnessScore)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	TestCaseIterator myIterator;
+	TestCaseIterator *myTestCaseIterator = NULL;
+
+	if (myEvolver->testCaseSchedule!=NULL)
+	{
+		returnValue = startTestCaseIteration(myEvolver->testCaseSchedule, scoreToBeat, &myIterator);
+		myTestCaseIterator = &myIterator;
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = myEvolver->parameters.fitnessFunction(myNeuralNetwork, scoreToBeat, myTestCaseIterator, myEvolver->parameters.userData, fitnessScore);
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myTestCaseIterator!=NULL))
+		returnValue = recordTestCaseIteration(myEvolver->testCaseSchedule, myTestCaseIterator);
+
+	return returnValue;
+}
+
+//Compute the fitness score of a neural network, unless the fitness cache already holds the score of its weights
+static NeuralNetworkErrorCode evaluateNeuralNetwork(Evolver *myEvolver, NeuralNetwork *myNeuralNetwork, int scoreToBeat, int *fitnessScore)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	uint64_t weightHash = 0;
+	bool isCached = false;
+
+	if (myEvolver->fitnessCacheArray!=NULL)
+	{
+		returnValue = getNeuralNetworkWeightHash(myNeuralNetwork, &weightHash);
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		{
+			pthread_mutex_lock(&(myEvolver->fitnessCacheMutex));
+
+			isCached = findCachedFitnessScore(myEvolver, weightHash, scoreToBeat, fitnessScore);
+
+			if (isCached)
+				myEvolver->numberOfFitnessCacheHits++;
+			else
+				myEvolver->numberOfFitnessCacheMisses++;
+
+			pthread_mutex_unlock(&(myEvolver->fitnessCacheMutex));
+		}
+	}
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (!isCached))
+		returnValue = computeFitnessScore(myEvolver, myNeuralNetwork, scoreToBeat, fitnessScore);
+
+	/*The score of a rejected neural network can be the score of the test cases evaluated before the
+	 *fitness function stopped, so only the score to beat is known to be an upper bound of its score.
+	 *Two threads can evaluate the same weights at the same time, the second one just refreshes the entry.
+	 *An upper bound is replaced by the new score, which is exact or a lower upper bound*/
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (!isCached) && (myEvolver->fitnessCacheArray!=NULL))
+	{
+		bool isUpperBound = (*fitnessScore <= scoreToBeat);
+		int cachedFitnessScore = isUpperBound ? scoreToBeat : *fitnessScore;
+
+		pthread_mutex_lock(&(myEvolver->fitnessCacheMutex));
+
+		FitnessCacheEntry *myEntry = findFitnessCacheEntry(myEvolver, weightHash);
+
+		if (myEntry==NULL)
+		{
+			storeFitnessScore(myEvolver, weightHash, cachedFitnessScore, isUpperBound);
+		}
+		else if (myEntry->isUpperBound)
+		{
+			myEntry->fitnessScore = cachedFitnessScore;
+			myEntry->isUpperBound = isUpperBound;
+		}
+
+		pthread_mutex_unlock(&(myEvolver->fitnessCacheMutex));
+	}
+
+	return returnValue;
+}
+
+//The children can not be reverted to their parents after the weights of the parents are replaced
+static void forgetChildOrigins(Evolver *myEvolver)
+{
+	for (int i=0; i < myEvolver->populationSize; i++)
+		myEvolver->originArray[i] = NULL;
+}
+
+//Run the jobs of the current generation until there are no jobs left, the job mutex must be locked
+static void runPendingJobs(Evolver *myEvolver)
+{
+	while (myEvolver->nextJob < myEvolver->lastJob)
+	{
+		NeuralNetworkErrorCode result = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+		int populationIndex = myEvolver->nextJob;
+		int scoreToBeat = myEvolver->scoreToBeat;
+		bool isCreatingChildren = myEvolver->isCreatingChildren;
+		int fitnessScore = 0;
+
+		myEvolver->nextJob++;
+
+		pthread_mutex_unlock(&(myEvolver->jobMutex));
+
+		if (isCreatingChildren)
+			result = createChild(myEvolver, populationIndex);
+
+		if (result==NEURAL_NETWORK_RETURN_VALUE_OK)
+			result = evaluateNeuralNetwork(myEvolver, myEvolver->populationArray[populationIndex], scoreToBeat, &fitnessScore);
+
+		/*The score of a rejected child can be an upper bound that depends on the test case order and the
+		 *fitness cache, so all the rejected children get the same score and keep their order*/
+		if (fitnessScore <= scoreToBeat)
+			fitnessScore = INT_MIN;
+
+		pthread_mutex_lock(&(myEvolver->jobMutex));
+
+		myEvolver->fitnessScoreArray[populationIndex] = fitnessScore;
+
+		if (result!=NEURAL_NETWORK_RETURN_VALUE_OK)
+			myEvolver->jobResult = result;
+
+		myEvolver->pendingJobs--;
+
+		if (myEvolver->pendingJobs==0)
+			pthread_cond_signal(&(myEvolver->jobsCompletedCondition));
+	}
+}
+
+static void *runWorkerThread(void *argument)
+{
+	Evolver *myEvolver = argument;
+
+	pthread_mutex_lock(&(myEvolver->jobMutex));
+
+	while (!myEvolver->isShuttingDown)
+	{
+		if (myEvolver->nextJob < myEvolver->lastJob)
+			runPendingJobs(myEvolver);
+		else
+			pthread_cond_wait(&(myEvolver->jobAvailableCondition), &(myEvolver->jobMutex));
+	}
+
+	pthread_mutex_unlock(&(myEvolver->jobMutex));
+
+	return NULL;
+}
+
+/*Evaluate the neural networks of the population from firstIndex to lastIndex - 1 in parallel. If
+ *isCreatingChildren is true each neural network is created as a child before the evaluation, and it
+ *must beat the worst parent to be kept*/
+static NeuralNetworkErrorCode evaluatePopulation(Evolver *myEvolver, int firstIndex, int lastIndex, bool isCreatingChildren)
+{
+	NeuralNetworkErrorCode returnValue;
+
+	pthread_mutex_lock(&(myEvolver->jobMutex));
+
+	myEvolver->nextJob = firstIndex;
+	myEvolver->lastJob = lastIndex;
+	myEvolver->isCreatingChildren = isCreatingChildren;
+	myEvolver->scoreToBeat = isCreatingChildren ? myEvolver->fitnessScoreArray[myEvolver->parameters.numberOfParents - 1] : INT_MIN;
+	myEvolver->pendingJobs = lastIndex - firstIndex;
+	myEvolver->jobResult = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	pthread_cond_broadcast(&(myEvolver->jobAvailableCondition));
+
+	//This thread also evaluates neural networks while it waits for the worker threads
+	runPendingJobs(myEvolver);
+
+	while (myEvolver->pendingJobs > 0)
+		pthread_cond_wait(&(myEvolver->jobsCompletedCondition), &(myEvolver->jobMutex));
+
+	returnValue = myEvolver->jobResult;
+
+	pthread_mutex_unlock(&(myEvolver->jobMutex));
+
+	return returnValue;
+}
+
+/*Move the best neural networks to the start of the population. The sort is stable and the parents
+ *are stored before the children, so a child must have a higher score to replace a parent*/
+static NeuralNetworkErrorCode selectParents(Evolver *myEvolver)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	NeuralNetwork **populationArray = myEvolver->populationArray;
+	NeuralNetwork **originArray = myEvolver->originArray;
+	int *fitnessScoreArray = myEvolver->fitnessScoreArray;
+	int parentIndex = 0;
+
+	for (int i=1; i < myEvolver->populationSize; i++)
+	{
+		NeuralNetwork *myNeuralNetwork = populationArray[i];
+		NeuralNetwork *myOrigin = originArray[i];
+		int fitnessScore = fitnessScoreArray[i];
+		int j = i;
+
+		//Only the pointers are moved, the neural networks are not copied
+		while ((j > 0) && (fitnessScoreArray[j-1] < fitnessScore))
+		{
+			populationArray[j] = populationArray[j-1];
+			originArray[j] = originArray[j-1];
+			fitnessScoreArray[j] = fitnessScoreArray[j-1];
+			j--;
+		}
+
+		populationArray[j] = myNeuralNetwork;
+		originArray[j] = myOrigin;
+		fitnessScoreArray[j] = fitnessScore;
+	}
+
+	//The mutations of the children selected as parents are kept
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (parentIndex < myEvolver->parameters.numberOfParents))
+	{
+		if (originArray[parentIndex]!=NULL)
+		{
+			returnValue = commitNeuralNetworkMutation(populationArray[parentIndex]);
+			originArray[parentIndex] = NULL;
+		}
+
+		parentIndex++;
+	}
+
+	return returnValue;
+}
+
+/*Get an immigrant from the migration function in the first child, which is not the child of a parent
+ *anymore. The parents are selected again if the immigrant is better than the worst parent, and then
+ *the children can not be reverted to their parents because the parents can be in other positions*/
+static NeuralNetworkErrorCode migrateNeuralNetwork(Evolver *myEvolver)
+{
+	NeuralNetworkErrorCode returnValue;
+
+	int immigrantIndex = myEvolver->parameters.numberOfParents;
+	int immigrantFitnessScore = INT_MIN;
+
+	myEvolver->originArray[immigrantIndex] = NULL;
+	myEvolver->fitnessScoreArray[immigrantIndex] = INT_MIN;
+
+	returnValue = myEvolver->parameters.migrationFunction(myEvolver->populationArray[0], myEvolver->fitnessScoreArray[0], myEvolver->populationArray[immigrantIndex],
+														  &immigrantFitnessScore, myEvolver->parameters.migrationData);
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (immigrantFitnessScore > myEvolver->fitnessScoreArray[immigrantIndex - 1]))
+	{
+		myEvolver->fitnessScoreArray[immigrantIndex] = immigrantFitnessScore;
+
+		forgetChildOrigins(myEvolver);
+
+		returnValue = selectParents(myEvolver);
+	}
+
+	return returnValue;
+}
+
+//Replace the weights of the parents with random weights
+static NeuralNetworkErrorCode createRandomParents(Evolver *myEvolver)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	int parentIndex = 0;
+
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (parentIndex < myEvolver->parameters.numberOfParents))
+	{
+		returnValue = randomizeNeuralNetwork(myEvolver->populationArray[parentIndex]);
+
+		parentIndex++;
+	}
+
+	forgetChildOrigins(myEvolver);
+
+	return returnValue;
+}
+
+/*Start the lineage journal from a neural network, the next entry holds the weights of the best
+ *neural network that differ from it*/
+static NeuralNetworkErrorCode startEvolverJournal(Evolver *myEvolver, NeuralNetwork *myNeuralNetwork)
+{
+	NeuralNetworkErrorCode returnValue = cloneNeuralNetwork(myNeuralNetwork, myEvolver->journalNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getNeuralNetworkWeightHash(myEvolver->journalNeuralNetwork, &(myEvolver->journalWeightHash));
+
+	return returnValue;
+}
+
+/*Give the journal function the weights of the best neural network changed since the last entry. The
+ *weight hash is only computed again after a restart or a migration, so a generation that keeps the
+ *best neural network costs a comparison. The flip array grows until it fits the largest entry*/
+static NeuralNetworkErrorCode writeEvolverJournal(Evolver *myEvolver)
+{
+	NeuralNetworkErrorCode returnValue;
+
+	NeuralNetwork *bestNeuralNetwork = myEvolver->populationArray[0];
+	EvolverJournalEntry myEntry;
+
+	returnValue = getNeuralNetworkWeightHash(bestNeuralNetwork, &(myEntry.weightHash));
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myEntry.weightHash!=myEvolver->journalWeightHash))
+	{
+		returnValue = getNeuralNetworkWeightFlips(bestNeuralNetwork, myEvolver->journalNeuralNetwork, myEvolver->journalFlipArray, myEvolver->journalFlipCapacity, &(myEntry.numberOfFlips));
+
+		if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myEntry.numberOfFlips > myEvolver->journalFlipCapacity))
+		{
+			NeuralNetworkWeightFlip *newFlipArray = realloc(myEvolver->journalFlipArray, sizeof(NeuralNetworkWeightFlip) * myEntry.numberOfFlips);
+
+			if (newFlipArray==NULL)
+			{
+				returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+			}
+			else
+			{
+				myEvolver->journalFlipArray = newFlipArray;
+				myEvolver->journalFlipCapacity = myEntry.numberOfFlips;
+
+				returnValue = getNeuralNetworkWeightFlips(bestNeuralNetwork, myEvolver->journalNeuralNetwork, myEvolver->journalFlipArray, myEvolver->journalFlipCapacity,
+														  &(myEntry.numberOfFlips));
+			}
+		}
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		{
+			myEntry.generationNumber = myEvolver->totalNumberOfGenerations;
+			myEntry.fitnessScore = myEvolver->fitnessScoreArray[0];
+			myEntry.flipArray = myEvolver->journalFlipArray;
+
+			returnValue = myEvolver->parameters.journalFunction(&myEntry, myEvolver->parameters.journalData);
+		}
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			myEvolver->journalGenerationNumber = myEntry.generationNumber;
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			returnValue = startEvolverJournal(myEvolver, bestNeuralNetwork);
+	}
+
+	return returnValue;
+}
+
+static inline size_t alignCheckpointSize(size_t size)
+{
+	return (size + EVOLVER_CHECKPOINT_ALIGNMENT - 1) / EVOLVER_CHECKPOINT_ALIGNMENT * EVOLVER_CHECKPOINT_ALIGNMENT;
+}
+
+static NeuralNetworkErrorCode computeCheckpointLayout(Evolver *myEvolver)
+{
+	CheckpointLayout *myLayout = &(myEvolver->checkpointLayout);
+
+	const void *layerRegion = NULL;
+	size_t layerRegionSize = 0;
+
+	size_t populationSize = (size_t) myEvolver->populationSize;
+	size_t numberOfTestCases = (size_t) myEvolver->parameters.numberOfTestCases;
+
+	NeuralNetworkErrorCode returnValue = getNeuralNetworkLayerRegion(myEvolver->populationArray[0], &layerRegion, &layerRegionSize);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		myLayout->generatorOffset = alignCheckpointSize(sizeof(CheckpointHeader));
+		myLayout->fitnessScoreOffset = myLayout->generatorOffset + alignCheckpointSize(sizeof(RandomGenerator) * populationSize);
+		myLayout->layerRegionOffset = myLayout->fitnessScoreOffset + alignCheckpointSize(sizeof(int32_t) * populationSize);
+		myLayout->layerRegionSize = layerRegionSize;
+		myLayout->layerRegionStride = alignCheckpointSize(layerRegionSize);
+		myLayout->fitnessCacheOffset = myLayout->layerRegionOffset + myLayout->layerRegionStride * populationSize;
+		myLayout->testCaseOrderOffset = myLayout->fitnessCacheOffset +
+										alignCheckpointSize(sizeof(FitnessCacheEntry) * (size_t) myEvolver->numberOfFitnessCacheSets * EVOLVER_FITNESS_CACHE_WAYS);
+		myLayout->rejectionCountOffset = myLayout->testCaseOrderOffset + alignCheckpointSize(sizeof(int) * numberOfTestCases);
+		myLayout->journalLayerRegionOffset = myLayout->rejectionCountOffset + alignCheckpointSize(sizeof(long long) * numberOfTestCases);
+		myLayout->checkpointSize = myLayout->journalLayerRegionOffset;
+
+		if (myEvolver->parameters.journalFunction!=NULL)
+			myLayout->checkpointSize += myLayout->layerRegionStride;
+	}
+
+	return returnValue;
+}
+
+/*Copy the state of the evolver to the checkpoint buffer and give it to the checkpoint function. It runs
+ *between two generations, so only memory is copied and the evolver goes on without waiting for the
+ *checkpoint to be stored*/
+static NeuralNetworkErrorCode saveEvolverCheckpoint(Evolver *myEvolver)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	const CheckpointLayout *myLayout = &(myEvolver->checkpointLayout);
+	unsigned char *checkpoint = myEvolver->checkpointBuffer;
+
+	CheckpointHeader myHeader;
+	int populationIndex = 0;
+
+	memset(&myHeader, 0, sizeof(myHeader));
+	memcpy(myHeader.magic, EVOLVER_CHECKPOINT_MAGIC, sizeof(myHeader.magic));
+
+	myHeader.version = EVOLVER_CHECKPOINT_VERSION;
+	myHeader.populationSize = myEvolver->populationSize;
+	myHeader.numberOfParents = myEvolver->parameters.numberOfParents;
+	myHeader.numberOfFitnessCacheSets = myEvolver->numberOfFitnessCacheSets;
+	myHeader.numberOfTestCases = myEvolver->parameters.numberOfTestCases;
+	myHeader.generationNumber = myEvolver->progress.generationNumber;
+	myHeader.bestFitnessScore = myEvolver->progress.bestFitnessScore;
+	myHeader.numberOfRestarts = myEvolver->progress.numberOfRestarts;
+	myHeader.generationsWithoutImproving = myEvolver->generationsWithoutImproving;
+	myHeader.totalNumberOfGenerations = myEvolver->totalNumberOfGenerations;
+	myHeader.numberOfEvaluations = myEvolver->progress.numberOfEvaluations;
+	myHeader.numberOfFitnessCacheHits = myEvolver->numberOfFitnessCacheHits;
+	myHeader.numberOfFitnessCacheMisses = myEvolver->numberOfFitnessCacheMisses;
+	myHeader.fitnessCacheClock = myEvolver->fitnessCacheClock;
+
+	if (myEvolver->journalNeuralNetwork!=NULL)
+	{
+		myHeader.isJournalEnabled = 1;
+		myHeader.journalGenerationNumber = myEvolver->journalGenerationNumber;
+		myHeader.journalInitialWeightHash = myEvolver->journalInitialWeightHash;
+		myHeader.journalWeightHash = myEvolver->journalWeightHash;
+	}
+
+	//The padding between the sections is also cleared, so the same state always gives the same checkpoint
+	memset(checkpoint, 0, myLayout->checkpointSize);
+
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (populationIndex < myEvolver->populationSize))
+	{
+		NeuralNetwork *myNeuralNetwork = myEvolver->populationArray[populationIndex];
+		RandomGenerator myGenerator;
+		int32_t fitnessScore = myEvolver->fitnessScoreArray[populationIndex];
+
+		const void *layerRegion = NULL;
+		size_t layerRegionSize = 0;
+
+		returnValue = getNeuralNetworkRandomState(myNeuralNetwork, &myGenerator);
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			returnValue = getNeuralNetworkLayerRegion(myNeuralNetwork, &layerRegion, &layerRegionSize);
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		{
+			myHeader.layerRegionSize = layerRegionSize;
+
+			memcpy(checkpoint + myLayout->generatorOffset + sizeof(RandomGenerator) * populationIndex, &myGenerator, sizeof(RandomGenerator));
+			memcpy(checkpoint + myLayout->fitnessScoreOffset + sizeof(int32_t) * populationIndex, &fitnessScore, sizeof(int32_t));
+			memcpy(checkpoint + myLayout->layerRegionOffset + myLayout->layerRegionStride * populationIndex, layerRegion, layerRegionSize);
+		}
+
+		populationIndex++;
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		memcpy(checkpoint, &myHeader, sizeof(myHeader));
+
+		if (myEvolver->fitnessCacheArray!=NULL)
+			memcpy(checkpoint + myLayout->fitnessCacheOffset, myEvolver->fitnessCacheArray,
+				   sizeof(FitnessCacheEntry) * myEvolver->numberOfFitnessCacheSets * EVOLVER_FITNESS_CACHE_WAYS);
+	}
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myEvolver->journalNeuralNetwork!=NULL))
+	{
+		const void *layerRegion = NULL;
+		size_t layerRegionSize = 0;
+
+		returnValue = getNeuralNetworkLayerRegion(myEvolver->journalNeuralNetwork, &layerRegion, &layerRegionSize);
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			memcpy(checkpoint + myLayout->journalLayerRegionOffset, layerRegion, layerRegionSize);
+	}
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myEvolver->testCaseSchedule!=NULL))
+		returnValue = getTestCaseScheduleState(myEvolver->testCaseSchedule, (int *) (checkpoint + myLayout->testCaseOrderOffset),
+											   (long long *) (checkpoint + myLayout->rejectionCountOffset));
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = myEvolver->parameters.checkpointFunction(checkpoint, myLayout->checkpointSize, myEvolver->parameters.checkpointData);
+
+	return returnValue;
+}
+
+/*The checkpoint must come from an evolver with the same topology, population, fitness cache and test
+ *cases, which keeps a journal if this evolver does*/
+static bool isValidCheckpointHeader(const Evolver *myEvolver, const CheckpointHeader *myHeader)
+{
+	bool isValid = (memcmp(myHeader->magic, EVOLVER_CHECKPOINT_MAGIC, sizeof(myHeader->magic))==0) &&
+				   (myHeader->version==EVOLVER_CHECKPOINT_VERSION) &&
+				   (myHeader->populationSize==myEvolver->populationSize) &&
+				   (myHeader->numberOfParents==myEvolver->parameters.numberOfParents) &&
+				   (myHeader->layerRegionSize==myEvolver->checkpointLayout.layerRegionSize) &&
+				   (myHeader->numberOfFitnessCacheSets==myEvolver->numberOfFitnessCacheSets) &&
+				   (myHeader->numberOfTestCases==myEvolver->parameters.numberOfTestCases) &&
+				   (myHeader->generationNumber>=0) &&
+				   (myHeader->numberOfRestarts>=0) &&
+				   (myHeader->generationsWithoutImproving>=0) &&
+				   (myHeader->totalNumberOfGenerations>=0) &&
+				   (myHeader->isJournalEnabled==(myEvolver->parameters.journalFunction!=NULL)) &&
+				   (myHeader->journalGenerationNumber>=-1) &&
+				   (myHeader->journalGenerationNumber < myHeader->totalNumberOfGenerations);
+
+	return isValid;
+}
+
+//Restore the state saved by saveEvolverCheckpoint, so runEvolver goes on from the same generation
+static NeuralNetworkErrorCode restoreEvolverCheckpoint(Evolver *myEvolver, const unsigned char *checkpoint, size_t checkpointSize)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	const CheckpointLayout *myLayout = &(myEvolver->checkpointLayout);
+
+	CheckpointHeader myHeader;
+	int populationIndex = 0;
+
+	if ((checkpointSize!=myLayout->checkpointSize) || (((uintptr_t) checkpoint % EVOLVER_CHECKPOINT_ALIGNMENT)!=0))
+		returnValue = NEURAL_NETWORK_CHECKPOINT_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		memcpy(&myHeader, checkpoint, sizeof(myHeader));
+
+		if (!isValidCheckpointHeader(myEvolver, &myHeader))
+			returnValue = NEURAL_NETWORK_CHECKPOINT_ERROR;
+	}
+
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (populationIndex < myEvolver->populationSize))
+	{
+		NeuralNetwork *myNeuralNetwork = myEvolver->populationArray[populationIndex];
+		RandomGenerator myGenerator;
+		int32_t fitnessScore = 0;
+
+		memcpy(&myGenerator, checkpoint + myLayout->generatorOffset + sizeof(RandomGenerator) * populationIndex, sizeof(RandomGenerator));
+		memcpy(&fitnessScore, checkpoint + myLayout->fitnessScoreOffset + sizeof(int32_t) * populationIndex, sizeof(int32_t));
+
+		returnValue = setNeuralNetworkLayerRegion(myNeuralNetwork, checkpoint + myLayout->layerRegionOffset + myLayout->layerRegionStride * populationIndex,
+												  myHeader.layerRegionSize);
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			returnValue = setNeuralNetworkRandomState(myNeuralNetwork, &myGenerator);
+
+		if (returnValue==NEURAL_NETWORK_LAYER_REGION_ERROR)
+			returnValue = NEURAL_NETWORK_CHECKPOINT_ERROR;
+
+		myEvolver->fitnessScoreArray[populationIndex] = fitnessScore;
+
+		populationIndex++;
+	}
+
+	//The next journal entry holds the weights changed since the last entry written before the checkpoint
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myEvolver->journalNeuralNetwork!=NULL))
+	{
+		returnValue = setNeuralNetworkLayerRegion(myEvolver->journalNeuralNetwork, checkpoint + myLayout->journalLayerRegionOffset, myHeader.layerRegionSize);
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			returnValue = getNeuralNetworkWeightHash(myEvolver->journalNeuralNetwork, &(myEvolver->journalWeightHash));
+
+		if (returnValue==NEURAL_NETWORK_LAYER_REGION_ERROR)
+			returnValue = NEURAL_NETWORK_CHECKPOINT_ERROR;
+
+		if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myEvolver->journalWeightHash!=myHeader.journalWeightHash))
+			returnValue = NEURAL_NETWORK_CHECKPOINT_ERROR;
+
+		myEvolver->journalInitialWeightHash = myHeader.journalInitialWeightHash;
+		myEvolver->journalGenerationNumber = myHeader.journalGenerationNumber;
+	}
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myEvolver->testCaseSchedule!=NULL))
+	{
+		returnValue = setTestCaseScheduleState(myEvolver->testCaseSchedule, (const int *) (checkpoint + myLayout->testCaseOrderOffset),
+											   (const long long *) (checkpoint + myLayout->rejectionCountOffset));
+
+		if (returnValue==NEURAL_NETWORK_TEST_CASE_ERROR)
+			returnValue = NEURAL_NETWORK_CHECKPOINT_ERROR;
+	}
+
+	//The children are cloned again from their parents, which gives the same weights as reverting them
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		forgetChildOrigins(myEvolver);
+
+		if (myEvolver->fitnessCacheArray!=NULL)
+			memcpy(myEvolver->fitnessCacheArray, checkpoint + myLayout->fitnessCacheOffset,
+				   sizeof(FitnessCacheEntry) * myEvolver->numberOfFitnessCacheSets * EVOLVER_FITNESS_CACHE_WAYS);
+
+		myEvolver->fitnessCacheClock = myHeader.fitnessCacheClock;
+		myEvolver->numberOfFitnessCacheHits = myHeader.numberOfFitnessCacheHits;
+		myEvolver->numberOfFitnessCacheMisses = myHeader.numberOfFitnessCacheMisses;
+
+		memset(&(myEvolver->progress), 0, sizeof(EvolverProgress));
+
+		myEvolver->progress.generationNumber = myHeader.generationNumber;
+		myEvolver->progress.bestFitnessScore = myHeader.bestFitnessScore;
+		myEvolver->progress.numberOfRestarts = myHeader.numberOfRestarts;
+		myEvolver->progress.numberOfEvaluations = myHeader.numberOfEvaluations;
+		myEvolver->progress.numberOfFitnessCacheHits = myHeader.numberOfFitnessCacheHits;
+		myEvolver->progress.numberOfFitnessCacheMisses = myHeader.numberOfFitnessCacheMisses;
+		myEvolver->generationsWithoutImproving = myHeader.generationsWithoutImproving;
+		myEvolver->totalNumberOfGenerations = myHeader.totalNumberOfGenerations;
+	}
+
+	return returnValue;
+}
+
+static bool isValidEvolverParameters(const EvolverParameters *myParameters)
+{
+	bool isValid = (myParameters->numberOfParents>=EVOLVER_MINIMUM_NUMBER_OF_PARENTS) &&
+				   (myParameters->numberOfChildren>=EVOLVER_MINIMUM_NUMBER_OF_CHILDREN) &&
+				   (myParameters->numberOfThreads>=EVOLVER_MINIMUM_NUMBER_OF_THREADS) &&
+				   (myParameters->numberOfParents <= INT_MAX - myParameters->numberOfChildren) &&
+				   (myParameters->maximumNumberOfGenerationsWithoutImproving>=0) &&
+				   (myParameters->maximumNumberOfGenerations>=0) &&
+				   (myParameters->numberOfCachedTestCases>=0) &&
+				   (myParameters->fitnessCacheSize>=0) &&
+				   (myParameters->numberOfTestCases>=0) &&
+				   (myParameters->maximumTestCaseScore>=0) &&
+				   (myParameters->migrationInterval>=0) &&
+				   (myParameters->checkpointInterval>=0) &&
+				   (myParameters->fitnessFunction!=NULL);
+
+	return isValid;
+}
+
+//The default evolver runs a (1+λ) evolution with one child per online CPU
+NeuralNetworkErrorCode initializeEvolverParameters(EvolverParameters *myParameters, int numberOfInputs, int numberOfHiddenLayers, int numberOfOutputs)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if (myParameters==NULL)
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		long numberOfProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+
+		if ((numberOfProcessors<EVOLVER_MINIMUM_NUMBER_OF_THREADS) || (numberOfProcessors>INT_MAX))
+			numberOfProcessors = EVOLVER_MINIMUM_NUMBER_OF_THREADS;
+
+		memset(myParameters, 0, sizeof(EvolverParameters));
+
+		myParameters->numberOfInputs = numberOfInputs;
+		myParameters->numberOfHiddenLayers = numberOfHiddenLayers;
+		myParameters->numberOfOutputs = numberOfOutputs;
+		myParameters->numberOfParents = EVOLVER_MINIMUM_NUMBER_OF_PARENTS;
+		myParameters->numberOfChildren = (int) numberOfProcessors;
+		myParameters->numberOfThreads = (int) numberOfProcessors;
+		myParameters->targetFitnessScore = INT_MAX;
+		myParameters->maximumTestCaseScore = 1;
+		myParameters->randomSeed = getRandomSeed();
+	}
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode createEvolver(Evolver **myEvolver, const EvolverParameters *myParameters)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	RandomGenerator myGenerator;
+	int populationIndex = 0;
+
+	if ((myEvolver==NULL) || (myParameters==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else if (!isValidEvolverParameters(myParameters))
+		returnValue = NEURAL_NETWORK_EVOLVER_PARAMETER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		*myEvolver = calloc(1, sizeof(Evolver));
+
+		if (*myEvolver==NULL)
+			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+	}
+
+	//Create the population arrays
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		Evolver *newEvolver = *myEvolver;
+
+		//The static initializers can not fail, so the evolver can always be destroyed
+		newEvolver->jobMutex = (pthread_mutex_t) PTHREAD_MUTEX_INITIALIZER;
+		newEvolver->jobAvailableCondition = (pthread_cond_t) PTHREAD_COND_INITIALIZER;
+		newEvolver->jobsCompletedCondition = (pthread_cond_t) PTHREAD_COND_INITIALIZER;
+		newEvolver->fitnessCacheMutex = (pthread_mutex_t) PTHREAD_MUTEX_INITIALIZER;
+
+		newEvolver->parameters = *myParameters;
+		newEvolver->populationSize = myParameters->numberOfParents + myParameters->numberOfChildren;
+
+		newEvolver->populationArray = calloc(newEvolver->populationSize, sizeof(NeuralNetwork *));
+		newEvolver->originArray = calloc(newEvolver->populationSize, sizeof(NeuralNetwork *));
+		newEvolver->fitnessScoreArray = calloc(newEvolver->populationSize, sizeof(int));
+		newEvolver->threadArray = calloc(myParameters->numberOfThreads, sizeof(pthread_t));
+
+		if ((newEvolver->populationArray==NULL) || (newEvolver->originArray==NULL) ||
+			(newEvolver->fitnessScoreArray==NULL) || (newEvolver->threadArray==NULL))
+
+			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+	}
+
+	//Create the fitness cache
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myParameters->fitnessCacheSize > 0))
+	{
+		Evolver *newEvolver = *myEvolver;
+
+		newEvolver->numberOfFitnessCacheSets = (myParameters->fitnessCacheSize - 1) / EVOLVER_FITNESS_CACHE_WAYS + 1;
+		newEvolver->fitnessCacheArray = calloc((size_t) newEvolver->numberOfFitnessCacheSets * EVOLVER_FITNESS_CACHE_WAYS, sizeof(FitnessCacheEntry));
+
+		if (newEvolver->fitnessCacheArray==NULL)
+			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+	}
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myParameters->numberOfTestCases > 0))
+		returnValue = createTestCaseSchedule(&((*myEvolver)->testCaseSchedule), myParameters->numberOfTestCases, myParameters->maximumTestCaseScore);
+
+	//Create the neural networks of the population, each one with its own random sequence taken from the evolver seed
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		seedRandomGenerator(&myGenerator, myParameters->randomSeed);
+
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (populationIndex < (*myEvolver)->populationSize))
+	{
+		NeuralNetwork **myNeuralNetwork = &((*myEvolver)->populationArray[populationIndex]);
+
+		returnValue = createNeuralNetworkWithTopology(myNeuralNetwork, myParameters->numberOfInputs, myParameters->numberOfHiddenLayers, myParameters->hiddenLayerWidthArray, myParameters->numberOfOutputs,
+													  myParameters->connectivity);
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			returnValue = setNeuralNetworkRandomSeed(*myNeuralNetwork, getRandomNumber(&myGenerator));
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			returnValue = randomizeNeuralNetwork(*myNeuralNetwork);
+
+		if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myParameters->numberOfCachedTestCases>0))
+			returnValue = setNeuralNetworkActivationCache(*myNeuralNetwork, myParameters->numberOfCachedTestCases);
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			returnValue = setNeuralNetworkMutationLog(*myNeuralNetwork, true);
+
+		populationIndex++;
+	}
+
+	//The checkpoint layout is also needed to check the checkpoints given to resumeEvolver
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = computeCheckpointLayout(*myEvolver);
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myParameters->checkpointFunction!=NULL))
+	{
+		(*myEvolver)->checkpointBuffer = malloc((*myEvolver)->checkpointLayout.checkpointSize);
+
+		if ((*myEvolver)->checkpointBuffer==NULL)
+			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+	}
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myParameters->journalFunction!=NULL))
+		returnValue = createNeuralNetworkWithTopology(&((*myEvolver)->journalNeuralNetwork), myParameters->numberOfInputs, myParameters->numberOfHiddenLayers, myParameters->hiddenLayerWidthArray,
+													  myParameters->numberOfOutputs, myParameters->connectivity);
+
+	//The thread that runs the evolver is also a worker, so one thread less is created
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && ((*myEvolver)->numberOfWorkerThreads < myParameters->numberOfThreads - 1))
+	{
+		Evolver *newEvolver = *myEvolver;
+
+		if (pthread_create(&(newEvolver->threadArray[newEvolver->numberOfWorkerThreads]), NULL, runWorkerThread, newEvolver)!=0)
+			returnValue = NEURAL_NETWORK_THREAD_ERROR;
+		else
+			newEvolver->numberOfWorkerThreads++;
+	}
+
+	//Release the partially created evolver
+	if ((returnValue!=NEURAL_NETWORK_RETURN_VALUE_OK) && (returnValue!=NEURAL_NETWORK_NULL_POINTER_ERROR) &&
+		(returnValue!=NEURAL_NETWORK_EVOLVER_PARAMETER_ERROR) && (*myEvolver!=NULL))
+
+		destroyEvolver(myEvolver);
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode destroyEvolver(Evolver **myEvolver)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myEvolver==NULL) || (*myEvolver==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	//Stop the worker threads
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && ((*myEvolver)->numberOfWorkerThreads > 0))
+	{
+		Evolver *oldEvolver = *myEvolver;
+
+		pthread_mutex_lock(&(oldEvolver->jobMutex));
+		oldEvolver->isShuttingDown = true;
+		pthread_cond_broadcast(&(oldEvolver->jobAvailableCondition));
+		pthread_mutex_unlock(&(oldEvolver->jobMutex));
+
+		for (int i=0; i < oldEvolver->numberOfWorkerThreads; i++)
+			pthread_join(oldEvolver->threadArray[i], NULL);
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		Evolver *oldEvolver = *myEvolver;
+
+		if (oldEvolver->populationArray!=NULL)
+		{
+			for (int i=0; i < oldEvolver->populationSize; i++)
+			{
+				if (oldEvolver->populationArray[i]!=NULL)
+					destroyNeuralNetwork(&(oldEvolver->populationArray[i]));
+			}
+		}
+
+		if (oldEvolver->journalNeuralNetwork!=NULL)
+			destroyNeuralNetwork(&(oldEvolver->journalNeuralNetwork));
+
+		pthread_mutex_destroy(&(oldEvolver->jobMutex));
+		pthread_cond_destroy(&(oldEvolver->jobAvailableCondition));
+		pthread_cond_destroy(&(oldEvolver->jobsCompletedCondition));
+		pthread_mutex_destroy(&(oldEvolver->fitnessCacheMutex));
+
+		if (oldEvolver->testCaseSchedule!=NULL)
+			destroyTestCaseSchedule(&(oldEvolver->testCaseSchedule));
+
+		free(oldEvolver->populationArray);
+		free(oldEvolver->originArray);
+		free(oldEvolver->fitnessScoreArray);
+		free(oldEvolver->threadArray);
+		free(oldEvolver->fitnessCacheArray);
+		free(oldEvolver->checkpointBuffer);
+		free(oldEvolver->journalFlipArray);
+		free(oldEvolver);
+
+		*myEvolver = NULL;
+	}
+
+	return returnValue;
+}
+
+/*Run generations until the evolution stops, from the state left by runEvolver or resumeEvolver. The
+ *checkpoints are taken after a whole generation, so a resumed evolver starts the next generation*/
+static NeuralNetworkErrorCode evolvePopulation(Evolver *myEvolver)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	EvolverProgress *myProgress = &(myEvolver->progress);
+	EvolverParameters *myParameters = &(myEvolver->parameters);
+
+	bool evolutionCompleted = false;
+
+	while ((!evolutionCompleted) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK))
+	{
+		//The generation zero evaluates the parents of a new evolutionary branch
+		if (myProgress->generationNumber==0)
+		{
+			for (int i=myParameters->numberOfParents; i < myEvolver->populationSize; i++)
+				myEvolver->fitnessScoreArray[i] = INT_MIN;
+
+			returnValue = evaluatePopulation(myEvolver, 0, myParameters->numberOfParents, false);
+
+			myProgress->numberOfEvaluations += myParameters->numberOfParents;
+		}
+		else
+		{
+			returnValue = evaluatePopulation(myEvolver, myParameters->numberOfParents, myEvolver->populationSize, true);
+
+			myProgress->numberOfEvaluations += myParameters->numberOfChildren;
+		}
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			returnValue = selectParents(myEvolver);
+
+		//The test cases are only reordered between generations, so every child sees the same order
+		if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myEvolver->testCaseSchedule!=NULL))
+			returnValue = sortTestCaseSchedule(myEvolver->testCaseSchedule);
+
+		if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myParameters->migrationFunction!=NULL) && (myParameters->migrationInterval > 0) &&
+			(((myEvolver->totalNumberOfGenerations + 1) % myParameters->migrationInterval)==0))
+
+			returnValue = migrateNeuralNetwork(myEvolver);
+
+		//The worker threads are waiting for the next generation
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		{
+			myProgress->numberOfFitnessCacheHits = myEvolver->numberOfFitnessCacheHits;
+			myProgress->numberOfFitnessCacheMisses = myEvolver->numberOfFitnessCacheMisses;
+		}
+
+		//The journal gets the best neural network after the migration, which can replace it
+		if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myParameters->journalFunction!=NULL))
+			returnValue = writeEvolverJournal(myEvolver);
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		{
+			int bestFitnessScore = myEvolver->fitnessScoreArray[0];
+
+			if ((myProgress->generationNumber==0) || (bestFitnessScore > myProgress->bestFitnessScore))
+				myEvolver->generationsWithoutImproving = 0;
+			else
+				myEvolver->generationsWithoutImproving++;
+
+			myProgress->bestFitnessScore = bestFitnessScore;
+
+			if (myParameters->progressFunction!=NULL)
+				myParameters->progressFunction(myProgress, myParameters->userData);
+
+			myProgress->generationNumber++;
+			myEvolver->totalNumberOfGenerations++;
+
+			if (bestFitnessScore>=myParameters->targetFitnessScore)
+				evolutionCompleted = true;
+			else if ((myParameters->maximumNumberOfGenerations > 0) && (myEvolver->totalNumberOfGenerations>=myParameters->maximumNumberOfGenerations))
+				evolutionCompleted = true;
+			else if ((myParameters->stopRequest!=NULL) && atomic_load(myParameters->stopRequest))
+				evolutionCompleted = true;
+			else if ((myParameters->maximumNumberOfGenerationsWithoutImproving > 0) && (myEvolver->generationsWithoutImproving > myParameters->maximumNumberOfGenerationsWithoutImproving))
+			{
+				//Abandon the current evolutionary branch and start a new one from scratch
+				returnValue = createRandomParents(myEvolver);
+
+				myProgress->generationNumber = 0;
+				myProgress->numberOfRestarts++;
+			}
+		}
+
+		if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (!evolutionCompleted) && (myParameters->checkpointFunction!=NULL) &&
+			(myParameters->checkpointInterval > 0) && ((myEvolver->totalNumberOfGenerations % myParameters->checkpointInterval)==0))
+
+			returnValue = saveEvolverCheckpoint(myEvolver);
+	}
+
+	return returnValue;
+}
+
+/*Evolve the population starting from the given neural network, which is the first parent. When the
+ *evolution stops the given neural network is replaced by the best neural network found*/
+NeuralNetworkErrorCode runEvolver(Evolver *myEvolver, NeuralNetwork *myNeuralNetwork, int *fitnessScore)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myEvolver==NULL) || (myNeuralNetwork==NULL) || (fitnessScore==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else
+		returnValue = cloneNeuralNetwork(myNeuralNetwork, myEvolver->populationArray[0]);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		forgetChildOrigins(myEvolver);
+
+		memset(&(myEvolver->progress), 0, sizeof(EvolverProgress));
+
+		myEvolver->generationsWithoutImproving = 0;
+		myEvolver->totalNumberOfGenerations = 0;
+	}
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myEvolver->parameters.journalFunction!=NULL))
+	{
+		returnValue = startEvolverJournal(myEvolver, myNeuralNetwork);
+
+		myEvolver->journalInitialWeightHash = myEvolver->journalWeightHash;
+		myEvolver->journalGenerationNumber = -1;
+	}
+
+	//The fitness function can score differently in each run, so every run starts with an empty fitness cache
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myEvolver->fitnessCacheArray!=NULL))
+	{
+		memset(myEvolver->fitnessCacheArray, 0, sizeof(FitnessCacheEntry) * myEvolver->numberOfFitnessCacheSets * EVOLVER_FITNESS_CACHE_WAYS);
+
+		myEvolver->fitnessCacheClock = 0;
+		myEvolver->numberOfFitnessCacheHits = 0;
+		myEvolver->numberOfFitnessCacheMisses = 0;
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = evolvePopulation(myEvolver);
+
+	//Return the best neural network
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = cloneNeuralNetwork(myEvolver->populationArray[0], myNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		*fitnessScore = myEvolver->fitnessScoreArray[0];
+
+	return returnValue;
+}
+
+/*Go on with an evolution from a checkpoint given by the checkpoint function, which must be aligned to
+ *8 bytes. The evolver must be created with the parameters of the evolver that took the checkpoint, and
+ *then it runs the same generations that evolver would have run, as if it had never stopped. The
+ *given neural network is replaced by the best neural network found.
+ *
+ *An evolver that keeps a journal writes its next entry from the last entry written before the
+ *checkpoint, so the journal must first be brought back to the state given by
+ *getEvolverCheckpointJournalState*/
+NeuralNetworkErrorCode resumeEvolver(Evolver *myEvolver, const void *checkpoint, size_t checkpointSize, NeuralNetwork *myNeuralNetwork, int *fitnessScore)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myEvolver==NULL) || (checkpoint==NULL) || (myNeuralNetwork==NULL) || (fitnessScore==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else
+		returnValue = restoreEvolverCheckpoint(myEvolver, checkpoint, checkpointSize);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = evolvePopulation(myEvolver);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = cloneNeuralNetwork(myEvolver->populationArray[0], myNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		*fitnessScore = myEvolver->fitnessScoreArray[0];
+
+	return returnValue;
+}
+
+/*Get the state of the lineage journal when a checkpoint was taken. The entries of the generations run
+ *after the checkpoint must be dropped from the journal before an evolver resumed from the checkpoint
+ *writes them again*/
+NeuralNetworkErrorCode getEvolverCheckpointJournalState(const void *checkpoint, size_t checkpointSize, EvolverJournalState *myState)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	CheckpointHeader myHeader;
+
+	if ((checkpoint==NULL) || (myState==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else if (checkpointSize < sizeof(CheckpointHeader))
+		returnValue = NEURAL_NETWORK_CHECKPOINT_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		memcpy(&myHeader, checkpoint, sizeof(myHeader));
+
+		if ((memcmp(myHeader.magic, EVOLVER_CHECKPOINT_MAGIC, sizeof(myHeader.magic))!=0) || (myHeader.version!=EVOLVER_CHECKPOINT_VERSION) ||
+			(myHeader.isJournalEnabled==0))
+			returnValue = NEURAL_NETWORK_CHECKPOINT_ERROR;
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		myState->lastGenerationNumber = myHeader.journalGenerationNumber;
+		myState->nextGenerationNumber = myHeader.totalNumberOfGenerations;
+		myState->initialWeightHash = myHeader.journalInitialWeightHash;
+		myState->weightHash = myHeader.journalWeightHash;
+	}
+
+	return returnValue;
+}
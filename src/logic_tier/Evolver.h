@@ -0,0 +1,184 @@
+/*
+ * Evolver.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#ifndef LOGIC_TIER_EVOLVER_H_
+#define LOGIC_TIER_EVOLVER_H_
+
+#include "NeuralNetwork.h"
+#include "TestCaseSchedule.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+#define EVOLVER_MINIMUM_NUMBER_OF_PARENTS 1
+#define EVOLVER_MINIMUM_NUMBER_OF_CHILDREN 1
+#define EVOLVER_MINIMUM_NUMBER_OF_THREADS 1
+
+//Number of entries of each set of the fitness cache
+#define EVOLVER_FITNESS_CACHE_WAYS 4
+
+typedef struct evolver Evolver;
+
+/*Compute the fitness score of a neural network. The function is called from several threads at the
+ *same time, each one with a different neural network, so it must not modify shared data.
+ *
+ *A neural network whose score is not higher than scoreToBeat is rejected, so the function can stop as
+ *soon as it knows the neural network can not beat it and return any score not higher than scoreToBeat.
+ *The score to beat is INT_MIN when every neural network is kept. If the evolver has a test case
+ *schedule the test case iterator is ready to evaluate its test cases with that score to beat,
+ *otherwise the iterator is NULL*/
+typedef NeuralNetworkErrorCode (*EvolverFitnessFunction)(NeuralNetwork *myNeuralNetwork, int scoreToBeat, TestCaseIterator *myTestCaseIterator, void *userData, int *fitnessScore);
+
+/*The generation number is reset to zero when a new evolutionary branch is started. The generation
+ *zero is the evaluation of the initial parents. The evaluations include the fitness cache hits, whose
+ *fitness function was not called*/
+typedef struct
+{
+	int generationNumber;
+	int bestFitnessScore;
+	int numberOfRestarts;
+	long long numberOfEvaluations;
+	long long numberOfFitnessCacheHits;
+	long long numberOfFitnessCacheMisses;
+} EvolverProgress;
+
+//The progress function is called from the thread that runs the evolver after each generation
+typedef void (*EvolverProgressFunction)(const EvolverProgress *myProgress, void *userData);
+
+/*Exchange neural networks with other populations, such as the other islands of runIslandEvolver. The
+ *function gets the best parent and its score, and it can copy another neural network with the same
+ *topology into the immigrant and set its score, which is INT_MIN if there is no immigrant. The
+ *immigrant replaces the worst parent if it has a higher score*/
+typedef NeuralNetworkErrorCode (*EvolverMigrationFunction)(const NeuralNetwork *bestNeuralNetwork, int bestFitnessScore, NeuralNetwork *myImmigrant, int *immigrantFitnessScore, void *migrationData);
+
+/*Store a checkpoint of the evolver, such as a CheckpointWriter of the data tier. The checkpoint is a
+ *buffer owned by the evolver that is only valid during the call, so the function must copy it*/
+typedef NeuralNetworkErrorCode (*EvolverCheckpointFunction)(const void *checkpoint, size_t checkpointSize, void *checkpointData);
+
+/*Weights of the best neural network that changed in a generation. The generation number is counted
+ *over all the evolutionary branches, from zero, and the flips turn the best neural network of the
+ *previous entry, or the neural network given to runEvolver for the first entry, into the best neural
+ *network of this generation, whose score and weight hash are given*/
+typedef struct
+{
+	int generationNumber;
+	int fitnessScore;
+	uint64_t weightHash;
+	int numberOfFlips;
+	const NeuralNetworkWeightFlip *flipArray;
+} EvolverJournalEntry;
+
+/*Position of a lineage journal. The entries start from the neural network with initialWeightHash,
+ *the last entry is the entry of generation lastGenerationNumber, or -1 without entries, and it leaves
+ *the neural network with weightHash. The next entry will be written for generation
+ *nextGenerationNumber or a later one*/
+typedef struct
+{
+	int lastGenerationNumber;
+	int nextGenerationNumber;
+	uint64_t initialWeightHash;
+	uint64_t weightHash;
+} EvolverJournalState;
+
+/*Store an entry of the lineage journal, such as a LineageJournal of the data tier. The flip array is
+ *owned by the evolver and it is only valid during the call*/
+typedef NeuralNetworkErrorCode (*EvolverJournalFunction)(const EvolverJournalEntry *myEntry, void *journalData);
+
+/*Each generation creates numberOfChildren mutated clones of the numberOfParents best neural networks
+ *and evaluates them in parallel. The best numberOfParents neural networks among parents and children
+ *are the parents of the next generation, and a parent is only replaced by a child with a higher score.
+ *
+ *If the best score does not improve after maximumNumberOfGenerationsWithoutImproving generations the
+ *current evolutionary branch is abandoned and the parents are created again from scratch (0 disables
+ *the restarts). The evolution stops when a neural network reaches the target fitness score or after
+ *maximumNumberOfGenerations generations of all the evolutionary branches (0 means no limit).
+ *
+ *The random seed sets the initial weights and the mutations of the whole population, so a training
+ *with a deterministic fitness function can be replayed with the same seed and parameters.
+ *
+ *If numberOfCachedTestCases is not 0 every neural network of the population keeps an activation cache
+ *of that number of test cases, and the children inherit the cache of their parents. A fitness function
+ *that computes its test cases with computeNeuralNetworkCachedOutput only computes the neurons changed
+ *by the mutation of each child.
+ *
+ *If hiddenLayerWidthArray is not NULL it holds the number of neurons of each hidden layer, otherwise
+ *every hidden layer is as wide as the input layer. The array is only read by createEvolver. A sparse
+ *connectivity lets the mutations remove and add connections, and the fitness function can penalise the
+ *size of the neural networks with getNeuralNetworkNumberOfConnections.
+ *
+ *If fitnessCacheSize is not 0 the fitness scores of up to that number of neural networks, rounded up to
+ *a multiple of EVOLVER_FITNESS_CACHE_WAYS, are kept by runEvolver keyed by their weight hash (see
+ *getNeuralNetworkWeightHash), and a neural network with the weights of a cached one, such as a child
+ *whose mutation undid a previous one, gets the cached score without calling the fitness function. Each
+ *set of the cache replaces its least recently used entry. The cache must only be enabled for a fitness
+ *function that always gives the same score to the same weights. A rejected neural network is kept with
+ *the score to beat that rejected it as an upper bound, which is only reused while it can not beat the
+ *score to beat either.
+ *
+ *If numberOfTestCases is not 0 the evolver keeps a test case schedule of that number of test cases,
+ *each one with a score from 0 to maximumTestCaseScore, and the fitness function gets an iterator that
+ *stops when the neural network can not beat the score to beat. After each generation the test cases
+ *that rejected more children are moved to the front of the schedule.
+ *
+ *If migrationFunction is not NULL it is called from the thread that runs the evolver every
+ *migrationInterval generations, counted over all the evolutionary branches, with migrationData.
+ *
+ *If stopRequest is not NULL the evolution also stops after the first generation that ends with the
+ *flag set, so another thread or process sharing the flag can cancel the evolver.
+ *
+ *If checkpointFunction is not NULL it gets a checkpoint of the whole state of the evolver every
+ *checkpointInterval generations, counted over all the evolutionary branches, with checkpointData.
+ *resumeEvolver goes on from a checkpoint with the same results as the evolver that took it.
+ *
+ *If journalFunction is not NULL it gets an entry with the changed weights after each generation that
+ *changes the best neural network, with journalData. Replaying the entries on the neural network given
+ *to runEvolver rebuilds the best neural network of any generation. A checkpoint records the state of
+ *the journal and resumeEvolver writes the next entry from the last entry written before the
+ *checkpoint. A journal kept in a file survives a crash: reopened at the EvolverJournalState given by
+ *getEvolverCheckpointJournalState, it drops a torn last entry and the entries of the generations run
+ *after the checkpoint, so the resumed evolver does not write any generation twice*/
+typedef struct
+{
+	int numberOfInputs;
+	int numberOfHiddenLayers;
+	const int *hiddenLayerWidthArray;
+	int numberOfOutputs;
+	NeuralNetworkConnectivity connectivity;
+	int numberOfParents;
+	int numberOfChildren;
+	int numberOfThreads;
+	int targetFitnessScore;
+	int maximumNumberOfGenerationsWithoutImproving;
+	int maximumNumberOfGenerations;
+	uint64_t randomSeed;
+	int numberOfCachedTestCases;
+	int fitnessCacheSize;
+	int numberOfTestCases;
+	int maximumTestCaseScore;
+	EvolverFitnessFunction fitnessFunction;
+	EvolverProgressFunction progressFunction;
+	void *userData;
+	int migrationInterval;
+	EvolverMigrationFunction migrationFunction;
+	void *migrationData;
+	atomic_bool *stopRequest;
+	int checkpointInterval;
+	EvolverCheckpointFunction checkpointFunction;
+	void *checkpointData;
+	EvolverJournalFunction journalFunction;
+	void *journalData;
+} EvolverParameters;
+
+NeuralNetworkErrorCode initializeEvolverParameters(EvolverParameters *myParameters, int numberOfInputs, int numberOfHiddenLayers, int numberOfOutputs);
+NeuralNetworkErrorCode createEvolver(Evolver **myEvolver, const EvolverParameters *myParameters);
+NeuralNetworkErrorCode destroyEvolver(Evolver **myEvolver);
+NeuralNetworkErrorCode runEvolver(Evolver *myEvolver, NeuralNetwork *myNeuralNetwork, int *fitnessScore);
+NeuralNetworkErrorCode resumeEvolver(Evolver *myEvolver, const void *checkpoint, size_t checkpointSize, NeuralNetwork *myNeuralNetwork, int *fitnessScore);
+NeuralNetworkErrorCode getEvolverCheckpointJournalState(const void *checkpoint, size_t checkpointSize, EvolverJournalState *myState);
+
+#endif /* LOGIC_TIER_EVOLVER_H_ */
@@ -0,0 +1,413 @@
+/*
+ * IslandEvolver.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#include "IslandEvolver.h"
+
+//The slots hold layer regions, which createNeuralNetworkFromLayerRegion needs aligned to 64 bytes
+#define ISLAND_EVOLVER_SLOT_ALIGNMENT 64
+
+/*Score of the neural network of a slot, INT_MIN while the slot is empty, and result of the island
+ *process, which is a thread error until the island ends*/
+typedef struct
+{
+	int fitnessScore;
+	NeuralNetworkErrorCode returnValue;
+} IslandRecord;
+
+/*Memory shared by the island processes, mapped before they are created so every pointer is valid in
+ *all of them. There is a record and a slot for each island, with the best neural network the island
+ *published last, followed by the record and the slot of the best neural network of all the islands.
+ *The records and the slots are only used with the mutex locked. The stop request is set by the first
+ *island that reaches the target score and cancels the evolvers of the other islands*/
+typedef struct
+{
+	pthread_mutex_t mutex;
+	atomic_bool stopRequest;
+	int numberOfIslands;
+	size_t layerRegionSize;
+	size_t slotSize;
+	size_t mappingSize;
+	IslandRecord *recordArray;
+	unsigned char *slotArray;
+} IslandSharedMemory;
+
+//Private data of an island process, given to its migration function
+typedef struct
+{
+	IslandSharedMemory *sharedMemory;
+	const EvolverParameters *parameters;
+	int islandIndex;
+} Island;
+
+static inline size_t alignSlotSize(size_t size)
+{
+	return (size + ISLAND_EVOLVER_SLOT_ALIGNMENT - 1) / ISLAND_EVOLVER_SLOT_ALIGNMENT * ISLAND_EVOLVER_SLOT_ALIGNMENT;
+}
+
+static inline unsigned char *getSlot(const IslandSharedMemory *mySharedMemory, int recordIndex)
+{
+	return mySharedMemory->slotArray + mySharedMemory->slotSize * (size_t) recordIndex;
+}
+
+static NeuralNetworkErrorCode createSharedMemory(IslandSharedMemory **mySharedMemory, int numberOfIslands, size_t layerRegionSize)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	pthread_mutexattr_t myMutexAttributes;
+
+	int numberOfRecords = numberOfIslands + 1;
+
+	size_t headerSize = alignSlotSize(sizeof(IslandSharedMemory) + sizeof(IslandRecord) * numberOfRecords);
+	size_t slotSize = alignSlotSize(layerRegionSize);
+	size_t mappingSize = headerSize + slotSize * numberOfRecords;
+
+	void *myMapping = mmap(NULL, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+	if (myMapping==MAP_FAILED)
+		returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		IslandSharedMemory *newSharedMemory = myMapping;
+
+		atomic_init(&(newSharedMemory->stopRequest), false);
+
+		newSharedMemory->numberOfIslands = numberOfIslands;
+		newSharedMemory->layerRegionSize = layerRegionSize;
+		newSharedMemory->slotSize = slotSize;
+		newSharedMemory->mappingSize = mappingSize;
+		newSharedMemory->recordArray = (IslandRecord *) ((unsigned char *) myMapping + sizeof(IslandSharedMemory));
+		newSharedMemory->slotArray = (unsigned char *) myMapping + headerSize;
+
+		for (int i=0; i < numberOfRecords; i++)
+		{
+			newSharedMemory->recordArray[i].fitnessScore = INT_MIN;
+			newSharedMemory->recordArray[i].returnValue = NEURAL_NETWORK_THREAD_ERROR;
+		}
+
+		/*The mutex is locked by several processes, so it must be created as a shared mutex. It is also a
+		 *robust mutex, so an island that dies with the mutex locked does not block the other ones forever*/
+		if (pthread_mutexattr_init(&myMutexAttributes)!=0)
+		{
+			returnValue = NEURAL_NETWORK_THREAD_ERROR;
+		}
+		else
+		{
+			if ((pthread_mutexattr_setpshared(&myMutexAttributes, PTHREAD_PROCESS_SHARED)!=0) ||
+				(pthread_mutexattr_setrobust(&myMutexAttributes, PTHREAD_MUTEX_ROBUST)!=0) ||
+				(pthread_mutex_init(&(newSharedMemory->mutex), &myMutexAttributes)!=0))
+				returnValue = NEURAL_NETWORK_THREAD_ERROR;
+
+			pthread_mutexattr_destroy(&myMutexAttributes);
+		}
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			*mySharedMemory = newSharedMemory;
+		else
+			munmap(myMapping, mappingSize);
+	}
+
+	return returnValue;
+}
+
+static void destroySharedMemory(IslandSharedMemory **mySharedMemory)
+{
+	pthread_mutex_destroy(&((*mySharedMemory)->mutex));
+	munmap(*mySharedMemory, (*mySharedMemory)->mappingSize);
+
+	*mySharedMemory = NULL;
+}
+
+/*Lock the mutex of the shared memory. If the island that held it died, its slots can be half written,
+ *so the mutex is made consistent again to let the other islands end, and they stop with an error*/
+static NeuralNetworkErrorCode lockSharedMemory(IslandSharedMemory *mySharedMemory)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	int lockResult = pthread_mutex_lock(&(mySharedMemory->mutex));
+
+	if (lockResult==EOWNERDEAD)
+	{
+		pthread_mutex_consistent(&(mySharedMemory->mutex));
+		pthread_mutex_unlock(&(mySharedMemory->mutex));
+
+		atomic_store(&(mySharedMemory->stopRequest), true);
+	}
+
+	if (lockResult!=0)
+		returnValue = NEURAL_NETWORK_THREAD_ERROR;
+
+	return returnValue;
+}
+
+//Copy a neural network and its score to a slot, the mutex must be locked
+static NeuralNetworkErrorCode publishNeuralNetwork(IslandSharedMemory *mySharedMemory, int recordIndex, const NeuralNetwork *myNeuralNetwork, int fitnessScore)
+{
+	const void *layerRegion = NULL;
+	size_t layerRegionSize = 0;
+
+	NeuralNetworkErrorCode returnValue = getNeuralNetworkLayerRegion(myNeuralNetwork, &layerRegion, &layerRegionSize);
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (layerRegionSize!=mySharedMemory->layerRegionSize))
+		returnValue = NEURAL_NETWORK_DIFFERENT_NEURAL_NETWORKS_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		memcpy(getSlot(mySharedMemory, recordIndex), layerRegion, layerRegionSize);
+		mySharedMemory->recordArray[recordIndex].fitnessScore = fitnessScore;
+	}
+
+	return returnValue;
+}
+
+/*Copy the neural network of a slot through a neural network created on the slot, which is destroyed
+ *right away because the slot changes when the mutex is unlocked. The mutex must be locked*/
+static NeuralNetworkErrorCode readNeuralNetwork(IslandSharedMemory *mySharedMemory, int recordIndex, const EvolverParameters *myParameters, NeuralNetwork *myNeuralNetwork)
+{
+	NeuralNetwork *mySlotNeuralNetwork = NULL;
+
+	NeuralNetworkErrorCode returnValue = createNeuralNetworkFromLayerRegion(&mySlotNeuralNetwork, myParameters->numberOfInputs, myParameters->numberOfHiddenLayers, myParameters->hiddenLayerWidthArray,
+																			myParameters->numberOfOutputs, myParameters->connectivity, getSlot(mySharedMemory, recordIndex),
+																			mySharedMemory->layerRegionSize, NULL);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = cloneNeuralNetwork(mySlotNeuralNetwork, myNeuralNetwork);
+
+	if (mySlotNeuralNetwork!=NULL)
+		destroyNeuralNetwork(&mySlotNeuralNetwork);
+
+	return returnValue;
+}
+
+//Publish a neural network of an island, which also becomes the best neural network if it has a higher score
+static NeuralNetworkErrorCode publishIslandNeuralNetwork(Island *myIsland, const NeuralNetwork *myNeuralNetwork, int fitnessScore)
+{
+	IslandSharedMemory *mySharedMemory = myIsland->sharedMemory;
+
+	int bestRecordIndex = mySharedMemory->numberOfIslands;
+
+	NeuralNetworkErrorCode returnValue = publishNeuralNetwork(mySharedMemory, myIsland->islandIndex, myNeuralNetwork, fitnessScore);
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (fitnessScore > mySharedMemory->recordArray[bestRecordIndex].fitnessScore))
+		returnValue = publishNeuralNetwork(mySharedMemory, bestRecordIndex, myNeuralNetwork, fitnessScore);
+
+	return returnValue;
+}
+
+//The islands form a ring: each island publishes its best parent and gets the best parent published by the previous island
+static NeuralNetworkErrorCode exchangeNeuralNetworks(const NeuralNetwork *bestNeuralNetwork, int bestFitnessScore, NeuralNetwork *myImmigrant, int *immigrantFitnessScore, void *migrationData)
+{
+	Island *myIsland = migrationData;
+	IslandSharedMemory *mySharedMemory = myIsland->sharedMemory;
+
+	int numberOfIslands = mySharedMemory->numberOfIslands;
+	int sourceIndex = (myIsland->islandIndex + numberOfIslands - 1) % numberOfIslands;
+
+	NeuralNetworkErrorCode returnValue = lockSharedMemory(mySharedMemory);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		returnValue = publishIslandNeuralNetwork(myIsland, bestNeuralNetwork, bestFitnessScore);
+
+		if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (sourceIndex!=myIsland->islandIndex) && (mySharedMemory->recordArray[sourceIndex].fitnessScore!=INT_MIN))
+		{
+			returnValue = readNeuralNetwork(mySharedMemory, sourceIndex, myIsland->parameters, myImmigrant);
+
+			if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+				*immigrantFitnessScore = mySharedMemory->recordArray[sourceIndex].fitnessScore;
+		}
+
+		pthread_mutex_unlock(&(mySharedMemory->mutex));
+	}
+
+	return returnValue;
+}
+
+/*Run the evolver of an island process. The first island keeps the random seed and the neural network
+ *of the caller, the other islands start from their own random neural network and seed*/
+static NeuralNetworkErrorCode runIsland(Island *myIsland, int migrationInterval, NeuralNetwork *myNeuralNetwork)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	EvolverParameters myParameters = *(myIsland->parameters);
+	Evolver *myEvolver = NULL;
+
+	int fitnessScore = INT_MIN;
+
+	myParameters.randomSeed += (uint64_t) myIsland->islandIndex;
+	myParameters.migrationInterval = migrationInterval;
+	myParameters.migrationFunction = exchangeNeuralNetworks;
+	myParameters.migrationData = myIsland;
+	myParameters.stopRequest = &(myIsland->sharedMemory->stopRequest);
+	myParameters.checkpointFunction = NULL;
+	myParameters.journalFunction = NULL;
+
+	//Only the first island reports its progress
+	if (myIsland->islandIndex > 0)
+	{
+		myParameters.progressFunction = NULL;
+
+		returnValue = setNeuralNetworkRandomSeed(myNeuralNetwork, myParameters.randomSeed);
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			returnValue = randomizeNeuralNetwork(myNeuralNetwork);
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = createEvolver(&myEvolver, &myParameters);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = runEvolver(myEvolver, myNeuralNetwork, &fitnessScore);
+
+	//The last neural network of the island can be the best of all the islands
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = lockSharedMemory(myIsland->sharedMemory);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		returnValue = publishIslandNeuralNetwork(myIsland, myNeuralNetwork, fitnessScore);
+
+		pthread_mutex_unlock(&(myIsland->sharedMemory->mutex));
+	}
+
+	//The other islands stop after their current generation
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (fitnessScore>=myParameters.targetFitnessScore))
+		atomic_store(&(myIsland->sharedMemory->stopRequest), true);
+
+	if (myEvolver!=NULL)
+		destroyEvolver(&myEvolver);
+
+	return returnValue;
+}
+
+static bool isValidIslandParameters(int numberOfIslands, int migrationInterval)
+{
+	bool isValid = (numberOfIslands>=ISLAND_EVOLVER_MINIMUM_NUMBER_OF_ISLANDS) &&
+				   (numberOfIslands<=ISLAND_EVOLVER_MAXIMUM_NUMBER_OF_ISLANDS) &&
+				   (migrationInterval>=ISLAND_EVOLVER_MINIMUM_MIGRATION_INTERVAL);
+
+	return isValid;
+}
+
+/*Evolve numberOfIslands populations in parallel, each one in its own process with its own evolver, so
+ *the islands do not share any cache line or allocator and their memory is allocated by the CPUs that
+ *run them. Every migrationInterval generations each island sends its best parent to the next island
+ *through shared memory, and the first island that reaches the target score stops the other ones after
+ *their current generation. This process is the coordinator: it waits for all the islands and replaces
+ *the given neural network by the best neural network of all of them.
+ *
+ *Each island is created with the given evolver parameters, so the number of threads is the number of
+ *threads of each island. The migration parameters are replaced, the islands do not take checkpoints
+ *or keep a journal and the progress function is only called by the first island. The user data is
+ *copied with the island processes, so the fitness and progress functions can not send data back to
+ *this process through it. If an island dies, the other ones stop and the run ends with an error*/
+NeuralNetworkErrorCode runIslandEvolver(const EvolverParameters *myParameters, int numberOfIslands, int migrationInterval, NeuralNetwork *myNeuralNetwork, int *fitnessScore)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	IslandSharedMemory *mySharedMemory = NULL;
+	NeuralNetwork *myScratchNeuralNetwork = NULL;
+	pid_t *processArray = NULL;
+
+	const void *layerRegion = NULL;
+	size_t layerRegionSize = 0;
+	int numberOfProcesses = 0;
+
+	if ((myParameters==NULL) || (myNeuralNetwork==NULL) || (fitnessScore==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else if (!isValidIslandParameters(numberOfIslands, migrationInterval))
+		returnValue = NEURAL_NETWORK_EVOLVER_PARAMETER_ERROR;
+
+	//The given neural network must have the topology of the evolver parameters
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = createNeuralNetworkWithTopology(&myScratchNeuralNetwork, myParameters->numberOfInputs, myParameters->numberOfHiddenLayers, myParameters->hiddenLayerWidthArray,
+													  myParameters->numberOfOutputs, myParameters->connectivity);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = cloneNeuralNetwork(myNeuralNetwork, myScratchNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getNeuralNetworkLayerRegion(myScratchNeuralNetwork, &layerRegion, &layerRegionSize);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = createSharedMemory(&mySharedMemory, numberOfIslands, layerRegionSize);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		processArray = malloc(sizeof(pid_t) * numberOfIslands);
+
+		if (processArray==NULL)
+			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+	}
+
+	//Create the island processes
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		fflush(NULL);
+
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (numberOfProcesses < numberOfIslands))
+	{
+		pid_t islandProcess = fork();
+
+		if (islandProcess<0)
+		{
+			returnValue = NEURAL_NETWORK_THREAD_ERROR;
+		}
+		else if (islandProcess==0)
+		{
+			Island myIsland = {mySharedMemory, myParameters, numberOfProcesses};
+
+			mySharedMemory->recordArray[numberOfProcesses].returnValue = runIsland(&myIsland, migrationInterval, myNeuralNetwork);
+
+			fflush(NULL);
+			_exit(EXIT_SUCCESS);
+		}
+		else
+		{
+			processArray[numberOfProcesses] = islandProcess;
+			numberOfProcesses++;
+		}
+	}
+
+	//The islands already created are stopped if the other ones can not be created
+	if (returnValue!=NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		for (int i=0; i < numberOfProcesses; i++)
+			kill(processArray[i], SIGTERM);
+	}
+
+	for (int i=0; i < numberOfProcesses; i++)
+	{
+		int status = 0;
+
+		if ((waitpid(processArray[i], &status, 0)!=processArray[i]) || (!WIFEXITED(status)) || (WEXITSTATUS(status)!=EXIT_SUCCESS))
+		{
+			if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+				returnValue = NEURAL_NETWORK_THREAD_ERROR;
+		}
+		else if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (mySharedMemory->recordArray[i].returnValue!=NEURAL_NETWORK_RETURN_VALUE_OK))
+		{
+			returnValue = mySharedMemory->recordArray[i].returnValue;
+		}
+	}
+
+	//All the islands have ended, so the best neural network can be read without locking the mutex
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = readNeuralNetwork(mySharedMemory, numberOfIslands, myParameters, myNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		*fitnessScore = mySharedMemory->recordArray[numberOfIslands].fitnessScore;
+
+	if (mySharedMemory!=NULL)
+		destroySharedMemory(&mySharedMemory);
+
+	if (myScratchNeuralNetwork!=NULL)
+		destroyNeuralNetwork(&myScratchNeuralNetwork);
+
+	free(processArray);
+
+	return returnValue;
+}
@@ -0,0 +1,25 @@
+/*
+ * IslandEvolver.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#ifndef LOGIC_TIER_ISLANDEVOLVER_H_
+#define LOGIC_TIER_ISLANDEVOLVER_H_
+
+#include "Evolver.h"
+
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#define ISLAND_EVOLVER_MINIMUM_NUMBER_OF_ISLANDS 1
+#define ISLAND_EVOLVER_MAXIMUM_NUMBER_OF_ISLANDS 1024
+#define ISLAND_EVOLVER_MINIMUM_MIGRATION_INTERVAL 1
+
+NeuralNetworkErrorCode runIslandEvolver(const EvolverParameters *myParameters, int numberOfIslands, int migrationInterval, NeuralNetwork *myNeuralNetwork, int *fitnessScore);
+
+#endif /* LOGIC_TIER_ISLANDEVOLVER_H_ */
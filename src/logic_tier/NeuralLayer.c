@@ -7,69 +7,703 @@
 
 #include "NeuralLayer.h"
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define NEURAL_LAYER_X86_KERNELS
+#endif
+
+/*Each weight is stored as one bit: 1 for NEURON_WEIGHT_POSITIVE and 0 for NEURON_WEIGHT_NEGATIVE.
+ *A sparse neuron stores a connection mask after the weight mask, with a cleared bit for each
+ *disconnected input, whose weight bit is also cleared, followed by the list of the words of the
+ *connection mask that have at least one connection. numberOfWords counts all these words*/
 typedef struct neuron
 {
 	int numberOfWeights;
-	NeuronWeight *weightArray;
+	int numberOfWords;
+	uint64_t weightMask[];
 } Neuron;
 
+/*The neurons are stored inside the neural layer one after another, so a neuron is located
+ *by its offset instead of by a pointer and a whole layer is a single block of memory*/
 typedef struct neuralLayer
 {
 	int numberOfInputs;
 	int numberOfNeurons;
-	Neuron **neuronArray;
+	int neuronSizeInWords;
+	bool isSparse;
+	uint64_t neuronData[];
 } NeuralLayer;
 
-//Neuron operations
+//Popcount kernels: count the active bits of (firstArray AND secondArray)
+typedef int (*PopcountKernel)(const uint64_t *firstArray, const uint64_t *secondArray, int numberOfWords);
 
-NeuronErrorCode createNeuron(Neuron **myNeuron, int numberOfInputs)
+static int scalarPopcountKernel(const uint64_t *firstArray, const uint64_t *secondArray, int numberOfWords)
 {
-	NeuronErrorCode returnValue = NEURON_RETURN_VALUE_OK;
-	
-	if (myNeuron==NULL)
-		returnValue = NEURON_NULL_POINTER_ERROR;
+	int activeBits = 0;
 
-	if ((numberOfInputs<NEURAL_LAYER_MINIMUM_NUMBER_OF_INPUTS) || (numberOfInputs>INT_MAX))
-		returnValue = NEURON_NUMBER_OF_INPUTS_ERROR;
+	for (int i=0; i<numberOfWords; i++)
+		activeBits += __builtin_popcountll(firstArray[i] & secondArray[i]);
 
-	//Create neuron
-	if (returnValue==NEURON_RETURN_VALUE_OK)
+	return activeBits;
+}
+
+#ifdef NEURAL_LAYER_X86_KERNELS
+
+/*The popcnt instruction was introduced together with SSE4.2. The library is built for any x86-64
+ *CPU, where the scalar kernel counts the bits in software*/
+__attribute__((target("sse4.2,popcnt")))
+static int sse42PopcountKernel(const uint64_t *firstArray, const uint64_t *secondArray, int numberOfWords)
+{
+	int activeBits = 0;
+
+	for (int i=0; i<numberOfWords; i++)
+		activeBits += (int) _mm_popcnt_u64(firstArray[i] & secondArray[i]);
+
+	return activeBits;
+}
+
+//Nibble lookup table with vpshufb, the byte counts are accumulated with vpsadbw
+__attribute__((target("avx2,popcnt")))
+static int avx2PopcountKernel(const uint64_t *firstArray, const uint64_t *secondArray, int numberOfWords)
+{
+	const __m256i lookupTable = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+	                                             0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+	const __m256i lowNibbleMask = _mm256_set1_epi8(0x0F);
+
+	__m256i accumulator = _mm256_setzero_si256();
+
+	int activeBits = 0;
+	int i=0;
+
+	for (; i+4<=numberOfWords; i+=4)
 	{
-		*myNeuron = malloc(sizeof(Neuron));
+		__m256i firstVector = _mm256_loadu_si256((const __m256i *) &firstArray[i]);
+		__m256i secondVector = _mm256_loadu_si256((const __m256i *) &secondArray[i]);
+		__m256i maskedVector = _mm256_and_si256(firstVector, secondVector);
 
-		if (*myNeuron==NULL)
-			returnValue = NEURON_MEMORY_ALLOCATION_ERROR;
+		__m256i lowNibbles = _mm256_and_si256(maskedVector, lowNibbleMask);
+		__m256i highNibbles = _mm256_and_si256(_mm256_srli_epi16(maskedVector, 4), lowNibbleMask);
+
+		__m256i byteCounts = _mm256_add_epi8(_mm256_shuffle_epi8(lookupTable, lowNibbles), _mm256_shuffle_epi8(lookupTable, highNibbles));
+
+		accumulator = _mm256_add_epi64(accumulator, _mm256_sad_epu8(byteCounts, _mm256_setzero_si256()));
 	}
 
-	//Create weight array
-	if (returnValue==NEURON_RETURN_VALUE_OK)
+	activeBits = _mm256_extract_epi64(accumulator, 0) + _mm256_extract_epi64(accumulator, 1) +
+	             _mm256_extract_epi64(accumulator, 2) + _mm256_extract_epi64(accumulator, 3);
+
+	for (; i<numberOfWords; i++)
+		activeBits += __builtin_popcountll(firstArray[i] & secondArray[i]);
+
+	return activeBits;
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq,popcnt")))
+static int avx512PopcountKernel(const uint64_t *firstArray, const uint64_t *secondArray, int numberOfWords)
+{
+	int activeBits = 0;
+
+	//Short arrays are faster with the popcnt instruction
+	if (numberOfWords<8)
+		activeBits = sse42PopcountKernel(firstArray, secondArray, numberOfWords);
+	else
 	{
-		(*myNeuron)->weightArray = malloc(sizeof(NeuronWeight) * numberOfInputs);
+		__m512i accumulator = _mm512_setzero_si512();
 
-		if ((*myNeuron)->weightArray==NULL)
+		int i=0;
+
+		for (; i+8<=numberOfWords; i+=8)
 		{
-            free(*myNeuron);
-            *myNeuron = NULL;
-			returnValue = NEURON_MEMORY_ALLOCATION_ERROR;
-	    }
+			__m512i firstVector = _mm512_loadu_si512(&firstArray[i]);
+			__m512i secondVector = _mm512_loadu_si512(&secondArray[i]);
+
+			accumulator = _mm512_add_epi64(accumulator, _mm512_popcnt_epi64(_mm512_and_si512(firstVector, secondVector)));
+		}
+
+		//The remaining words are loaded with a mask
+		if (i<numberOfWords)
+		{
+			__mmask8 tailMask = (__mmask8) ((1U << (numberOfWords - i)) - 1);
+
+			__m512i firstVector = _mm512_maskz_loadu_epi64(tailMask, &firstArray[i]);
+			__m512i secondVector = _mm512_maskz_loadu_epi64(tailMask, &secondArray[i]);
+
+			accumulator = _mm512_add_epi64(accumulator, _mm512_popcnt_epi64(_mm512_and_si512(firstVector, secondVector)));
+		}
+
+		activeBits = _mm512_reduce_add_epi64(accumulator);
 	}
 
-	//Initialize
-	if (returnValue==NEURON_RETURN_VALUE_OK)
+	return activeBits;
+}
+
+#endif
+
+/*Sparse kernels: count the active inputs and the active inputs with positive weight of a sparse neuron,
+ *reading only the words of its connected word list*/
+typedef void (*SparsePopcountKernel)(const uint64_t *packedInputArray, const uint64_t *weightMask, const uint64_t *connectionMask,
+                                     const uint32_t *connectedWordArray, int numberOfConnectedWords, int *activeInputs, int *positiveInputs);
+
+static void scalarSparsePopcountKernel(const uint64_t *packedInputArray, const uint64_t *weightMask, const uint64_t *connectionMask,
+                                       const uint32_t *connectedWordArray, int numberOfConnectedWords, int *activeInputs, int *positiveInputs)
+{
+	int activeBits = 0;
+	int positiveBits = 0;
+
+	for (int i=0; i<numberOfConnectedWords; i++)
 	{
-		(*myNeuron)->numberOfWeights = numberOfInputs;
+		uint32_t wordIndex = connectedWordArray[i];
 
-		for (int i=0; i<numberOfInputs; i++)
+		activeBits += __builtin_popcountll(packedInputArray[wordIndex] & connectionMask[wordIndex]);
+		positiveBits += __builtin_popcountll(packedInputArray[wordIndex] & weightMask[wordIndex]);
+	}
+
+	*activeInputs = activeBits;
+	*positiveInputs = positiveBits;
+}
+
+#ifdef NEURAL_LAYER_X86_KERNELS
+
+__attribute__((target("sse4.2,popcnt")))
+static void sse42SparsePopcountKernel(const uint64_t *packedInputArray, const uint64_t *weightMask, const uint64_t *connectionMask,
+                                      const uint32_t *connectedWordArray, int numberOfConnectedWords, int *activeInputs, int *positiveInputs)
+{
+	int activeBits = 0;
+	int positiveBits = 0;
+
+	for (int i=0; i<numberOfConnectedWords; i++)
+	{
+		uint32_t wordIndex = connectedWordArray[i];
+
+		activeBits += (int) _mm_popcnt_u64(packedInputArray[wordIndex] & connectionMask[wordIndex]);
+		positiveBits += (int) _mm_popcnt_u64(packedInputArray[wordIndex] & weightMask[wordIndex]);
+	}
+
+	*activeInputs = activeBits;
+	*positiveInputs = positiveBits;
+}
+
+#endif
+
+static const PopcountKernel popcountKernelArray[NEURON_KERNEL_AVX512 + 1] =
+{
+	[NEURON_KERNEL_SCALAR] = scalarPopcountKernel,
+#ifdef NEURAL_LAYER_X86_KERNELS
+	[NEURON_KERNEL_SSE42] = sse42PopcountKernel,
+	[NEURON_KERNEL_AVX2] = avx2PopcountKernel,
+	[NEURON_KERNEL_AVX512] = avx512PopcountKernel
+#endif
+};
+
+/*The connected words of a sparse neuron are few and scattered, and loading them with vector gathers is
+ *slower than counting them one by one, so the sparse kernels only differ in the popcnt instruction*/
+static inline SparsePopcountKernel getSparsePopcountKernel(NeuronKernel myKernel)
+{
+	SparsePopcountKernel mySparseKernel = scalarSparsePopcountKernel;
+
+#ifdef NEURAL_LAYER_X86_KERNELS
+	if (myKernel!=NEURON_KERNEL_SCALAR)
+		mySparseKernel = sse42SparsePopcountKernel;
+#else
+	(void) myKernel;
+#endif
+
+	return mySparseKernel;
+}
+
+static inline Neuron *getNeuronAt(NeuralLayer *myNeuralLayer, int neuronIndex)
+{
+	return (Neuron *) &(myNeuralLayer->neuronData[(size_t) neuronIndex * myNeuralLayer->neuronSizeInWords]);
+}
+
+static inline const Neuron *getConstNeuronAt(const NeuralLayer *myNeuralLayer, int neuronIndex)
+{
+	return (const Neuron *) &(myNeuralLayer->neuronData[(size_t) neuronIndex * myNeuralLayer->neuronSizeInWords]);
+}
+
+//The connected word list is an array of 32-bit integers that starts with the number of connected words
+static inline int getNeuronDataWords(int numberOfInputs, bool isSparse)
+{
+	int numberOfMaskWords = NEURON_DATA_NUMBER_OF_WORDS(numberOfInputs);
+
+	return isSparse ? 2*numberOfMaskWords + (numberOfMaskWords + 2) / 2 : numberOfMaskWords;
+}
+
+static inline size_t getNeuronSize(int numberOfInputs, bool isSparse)
+{
+	return sizeof(Neuron) + sizeof(uint64_t) * getNeuronDataWords(numberOfInputs, isSparse);
+}
+
+static inline int getNumberOfMaskWords(const Neuron *myNeuron)
+{
+	return NEURON_DATA_NUMBER_OF_WORDS(myNeuron->numberOfWeights);
+}
+
+static inline bool isSparseNeuron(const Neuron *myNeuron)
+{
+	return myNeuron->numberOfWords != getNumberOfMaskWords(myNeuron);
+}
+
+static inline const uint64_t *getConnectionMask(const Neuron *myNeuron)
+{
+	return &(myNeuron->weightMask[getNumberOfMaskWords(myNeuron)]);
+}
+
+static inline const uint32_t *getConnectedWordList(const Neuron *myNeuron)
+{
+	return (const uint32_t *) &(myNeuron->weightMask[2 * getNumberOfMaskWords(myNeuron)]);
+}
+
+static inline bool isPositiveWeight(const Neuron *myNeuron, int inputNumber)
+{
+	uint64_t word = myNeuron->weightMask[inputNumber / NEURON_DATA_BITS_PER_WORD];
+
+	return (word >> (inputNumber % NEURON_DATA_BITS_PER_WORD)) & 1;
+}
+
+static inline void flipWeight(Neuron *myNeuron, int inputNumber)
+{
+	myNeuron->weightMask[inputNumber / NEURON_DATA_BITS_PER_WORD] ^= UINT64_C(1) << (inputNumber % NEURON_DATA_BITS_PER_WORD);
+}
+
+//All the inputs of a dense neuron are connected
+static inline bool isConnectedInput(const Neuron *myNeuron, int inputNumber)
+{
+	bool isConnected = true;
+
+	if (isSparseNeuron(myNeuron))
+	{
+		uint64_t word = getConnectionMask(myNeuron)[inputNumber / NEURON_DATA_BITS_PER_WORD];
+
+		isConnected = (word >> (inputNumber % NEURON_DATA_BITS_PER_WORD)) & 1;
+	}
+
+	return isConnected;
+}
+
+static inline NeuronWeight getStoredWeight(const Neuron *myNeuron, int inputNumber)
+{
+	NeuronWeight inputWeight = NEURON_WEIGHT_DISCONNECTED;
+
+	if (isConnectedInput(myNeuron, inputNumber))
+		inputWeight = isPositiveWeight(myNeuron, inputNumber) ? NEURON_WEIGHT_POSITIVE : NEURON_WEIGHT_NEGATIVE;
+
+	return inputWeight;
+}
+
+//Only sparse neurons can store NEURON_WEIGHT_DISCONNECTED, the connected word list is not updated
+static inline void storeWeight(Neuron *myNeuron, int inputNumber, NeuronWeight inputWeight)
+{
+	int wordIndex = inputNumber / NEURON_DATA_BITS_PER_WORD;
+	uint64_t inputBit = UINT64_C(1) << (inputNumber % NEURON_DATA_BITS_PER_WORD);
+
+	if (inputWeight==NEURON_WEIGHT_POSITIVE)
+		myNeuron->weightMask[wordIndex] |= inputBit;
+	else
+		myNeuron->weightMask[wordIndex] &= ~inputBit;
+
+	if (isSparseNeuron(myNeuron))
+	{
+		uint64_t *connectionMask = &(myNeuron->weightMask[getNumberOfMaskWords(myNeuron)]);
+
+		if (inputWeight==NEURON_WEIGHT_DISCONNECTED)
+			connectionMask[wordIndex] &= ~inputBit;
+		else
+			connectionMask[wordIndex] |= inputBit;
+	}
+}
+
+/*Zobrist hash of the weights: every weight that is not NEURON_WEIGHT_NEGATIVE adds the key of its
+ *input and its state to the hash of the neuron with an exclusive or, so a changed weight updates the
+ *hash with the keys of its old state and its new state. The keys of the inputs of a neuron are all
+ *different, as the neuron key keeps its high half for the neuron index*/
+static inline uint64_t getWeightHashKey(uint64_t neuronKey, int inputNumber, NeuronWeight inputWeight)
+{
+	uint64_t weightKey = 0;
+
+	if (inputWeight!=NEURON_WEIGHT_NEGATIVE)
+		weightKey = mixRandomBits(neuronKey ^ (2 * (uint64_t) inputNumber + (inputWeight==NEURON_WEIGHT_DISCONNECTED)));
+
+	return weightKey;
+}
+
+//Hash the positive weights and the disconnected inputs of a neuron
+static uint64_t computeNeuronWeightHash(const Neuron *myNeuron, uint64_t neuronKey)
+{
+	uint64_t weightHash = 0;
+
+	int numberOfMaskWords = getNumberOfMaskWords(myNeuron);
+	int lastWordBits = myNeuron->numberOfWeights % NEURON_DATA_BITS_PER_WORD;
+
+	for (int wordIndex=0; wordIndex < numberOfMaskWords; wordIndex++)
+	{
+		uint64_t positiveWord = myNeuron->weightMask[wordIndex];
+		uint64_t disconnectedWord = 0;
+
+		if (isSparseNeuron(myNeuron))
 		{
-			int randomWeight = rand() % 2;
+			disconnectedWord = ~getConnectionMask(myNeuron)[wordIndex];
+
+			if ((wordIndex==numberOfMaskWords - 1) && (lastWordBits!=0))
+				disconnectedWord &= (UINT64_C(1) << lastWordBits) - 1;
+		}
+
+		for (; positiveWord!=0; positiveWord &= positiveWord - 1)
+			weightHash ^= getWeightHashKey(neuronKey, wordIndex * NEURON_DATA_BITS_PER_WORD + __builtin_ctzll(positiveWord), NEURON_WEIGHT_POSITIVE);
+
+		for (; disconnectedWord!=0; disconnectedWord &= disconnectedWord - 1)
+			weightHash ^= getWeightHashKey(neuronKey, wordIndex * NEURON_DATA_BITS_PER_WORD + __builtin_ctzll(disconnectedWord), NEURON_WEIGHT_DISCONNECTED);
+	}
+
+	return weightHash;
+}
+
+static void updateConnectedWordList(Neuron *myNeuron)
+{
+	int numberOfMaskWords = getNumberOfMaskWords(myNeuron);
+	const uint64_t *connectionMask = getConnectionMask(myNeuron);
+	uint32_t *connectedWordList = (uint32_t *) &(myNeuron->weightMask[2 * numberOfMaskWords]);
+
+	uint32_t numberOfConnectedWords = 0;
+
+	for (int i=0; i<numberOfMaskWords; i++)
+	{
+		if (connectionMask[i]!=0)
+		{
+			numberOfConnectedWords++;
+			connectedWordList[numberOfConnectedWords] = i;
+		}
+	}
+
+	connectedWordList[0] = numberOfConnectedWords;
+
+	//The unused entries are cleared, so two neurons with the same weights have the same words
+	for (int i=numberOfConnectedWords + 1; i<=numberOfMaskWords; i++)
+		connectedWordList[i] = 0;
+}
+
+/*A sparse neuron only reads the words of its connected word list when at most half of the words
+ *have connections, otherwise its masks are counted whole with the vector kernels*/
+static inline void countSparseNeuronInputs(const Neuron *myNeuron, const uint64_t *packedInputArray, NeuronKernel myKernel, int *activeInputs, int *positiveInputs)
+{
+	int numberOfMaskWords = getNumberOfMaskWords(myNeuron);
+	const uint64_t *connectionMask = getConnectionMask(myNeuron);
+	const uint32_t *connectedWordList = getConnectedWordList(myNeuron);
+
+	int numberOfConnectedWords = connectedWordList[0];
+
+	if (2*numberOfConnectedWords <= numberOfMaskWords)
+	{
+		getSparsePopcountKernel(myKernel)(packedInputArray, myNeuron->weightMask, connectionMask, &connectedWordList[1],
+		                                  numberOfConnectedWords, activeInputs, positiveInputs);
+	}
+	else
+	{
+		*activeInputs = popcountKernelArray[myKernel](packedInputArray, connectionMask, numberOfMaskWords);
+		*positiveInputs = popcountKernelArray[myKernel](packedInputArray, myNeuron->weightMask, numberOfMaskWords);
+	}
+}
+
+/*The weighted sum of a binary neuron is the number of active inputs with positive weight minus
+ *the number of active inputs with negative weight, so it is positive when more than half of the
+ *active inputs have positive weight. The active inputs of a dense neuron are shared by the whole
+ *layer, a sparse neuron only counts its connected inputs*/
+static inline NeuronData computeBinaryNeuronOutput(const Neuron *myNeuron, const uint64_t *packedInputArray, int numberOfActiveInputs, NeuronKernel myKernel)
+{
+	int positiveInputs = 0;
+
+	if (isSparseNeuron(myNeuron))
+		countSparseNeuronInputs(myNeuron, packedInputArray, myKernel, &numberOfActiveInputs, &positiveInputs);
+	else
+		positiveInputs = popcountKernelArray[myKernel](packedInputArray, myNeuron->weightMask, myNeuron->numberOfWords);
+
+	return (2*positiveInputs > numberOfActiveInputs) ? NEURON_DATA_ONE : NEURON_DATA_ZERO;
+}
+
+/*Bit-sliced engine: the word of each input holds that input for 64 samples, one sample per bit.
+ *The inputs of a neuron are counted for the 64 samples at once in a bit-sliced counter, where
+ *word i holds bit i of the count of every sample. The counters have enough bits to count twice
+ *the inputs of a layer*/
+#define NEURAL_LAYER_SLICED_COUNTER_BITS 33
+
+//Number of input slices added at once by a carry-save adder tree
+#define NEURAL_LAYER_SLICED_BLOCK_SIZE 8
+
+typedef struct
+{
+	uint64_t counter[NEURAL_LAYER_SLICED_COUNTER_BITS];
+	uint64_t pendingInputArray[NEURAL_LAYER_SLICED_BLOCK_SIZE];
+	int numberOfPendingInputs;
+} SlicedCounter;
+
+static inline void clearSlicedCounter(SlicedCounter *myCounter, int numberOfCounterBits)
+{
+	memset(myCounter->counter, 0, sizeof(uint64_t) * numberOfCounterBits);
+	myCounter->numberOfPendingInputs = 0;
+}
+
+//Add a one bit slice to the bits of the counter from firstBit on, the carry stops as soon as no sample propagates it
+static inline void addSlicedBit(SlicedCounter *myCounter, int firstBit, uint64_t bitSlice)
+{
+	uint64_t carry = bitSlice;
+
+	for (int i=firstBit; carry!=0; i++)
+	{
+		uint64_t nextCarry = myCounter->counter[i] & carry;
+
+		myCounter->counter[i] ^= carry;
+		carry = nextCarry;
+	}
+}
+
+//Full adder of three bit slices
+static inline void addSlicedCarrySave(uint64_t *high, uint64_t *low, uint64_t first, uint64_t second, uint64_t third)
+{
+	uint64_t partialSum = first ^ second;
+
+	*high = (first & second) | (partialSum & third);
+	*low = partialSum ^ third;
+}
+
+/*Harley-Seal accumulation: the ones, twos and fours of the counter absorb 8 input slices with
+ *7 full adders, and only the eights are propagated to the upper bits of the counter*/
+static inline void addPendingSlicedInputs(SlicedCounter *myCounter)
+{
+	uint64_t *ones = &(myCounter->counter[0]);
+	uint64_t *twos = &(myCounter->counter[1]);
+	uint64_t *fours = &(myCounter->counter[2]);
+	const uint64_t *inputArray = myCounter->pendingInputArray;
+
+	uint64_t firstTwos, secondTwos, firstFours, secondFours, eights;
+
+	addSlicedCarrySave(&firstTwos, ones, *ones, inputArray[0], inputArray[1]);
+	addSlicedCarrySave(&secondTwos, ones, *ones, inputArray[2], inputArray[3]);
+	addSlicedCarrySave(&firstFours, twos, *twos, firstTwos, secondTwos);
+	addSlicedCarrySave(&firstTwos, ones, *ones, inputArray[4], inputArray[5]);
+	addSlicedCarrySave(&secondTwos, ones, *ones, inputArray[6], inputArray[7]);
+	addSlicedCarrySave(&secondFours, twos, *twos, firstTwos, secondTwos);
+	addSlicedCarrySave(&eights, fours, *fours, firstFours, secondFours);
+
+	addSlicedBit(myCounter, 3, eights);
+
+	myCounter->numberOfPendingInputs = 0;
+}
+
+//Add the input slices of the set bits of selectionWord, wordInputSlices are the slices of the inputs of the word
+static inline void addSlicedInputWord(SlicedCounter *myCounter, const uint64_t *wordInputSlices, uint64_t selectionWord)
+{
+	while (selectionWord!=0)
+	{
+		myCounter->pendingInputArray[myCounter->numberOfPendingInputs] = wordInputSlices[__builtin_ctzll(selectionWord)];
+		myCounter->numberOfPendingInputs++;
+
+		if (myCounter->numberOfPendingInputs==NEURAL_LAYER_SLICED_BLOCK_SIZE)
+			addPendingSlicedInputs(myCounter);
+
+		selectionWord &= selectionWord - 1;
+	}
+}
+
+static inline void flushSlicedCounter(SlicedCounter *myCounter)
+{
+	for (int i=0; i < myCounter->numberOfPendingInputs; i++)
+		addSlicedBit(myCounter, 0, myCounter->pendingInputArray[i]);
+
+	myCounter->numberOfPendingInputs = 0;
+}
+
+//Compare two counters from the most significant bit, as long as they are equal in the previous bits
+static inline uint64_t compareSlicedCounters(const uint64_t *firstCounter, const uint64_t *secondCounter, int numberOfCounterBits)
+{
+	uint64_t greaterSamples = 0;
+	uint64_t equalSamples = ~UINT64_C(0);
+
+	for (int i=numberOfCounterBits - 1; i>=0; i--)
+	{
+		greaterSamples |= equalSamples & firstCounter[i] & ~secondCounter[i];
+		equalSamples &= ~(firstCounter[i] ^ secondCounter[i]);
+	}
+
+	return greaterSamples;
+}
+
+/*Same condition as computeBinaryNeuronOutput, for each sample: twice the active inputs with positive
+ *weight against the active inputs of a dense layer, which are counted once for the whole layer in
+ *activeCounter, and the active inputs with positive weight against the active inputs with negative
+ *weight of a sparse neuron*/
+static uint64_t computeBitSlicedNeuronOutput(const Neuron *myNeuron, const uint64_t *inputSliceArray, const uint64_t *activeCounter, int numberOfCounterBits)
+{
+	SlicedCounter positiveCounter;
+	SlicedCounter negativeCounter;
+	uint64_t neuronOutput;
+
+	clearSlicedCounter(&positiveCounter, numberOfCounterBits);
+
+	if (isSparseNeuron(myNeuron))
+	{
+		const uint64_t *connectionMask = getConnectionMask(myNeuron);
+		const uint32_t *connectedWordList = getConnectedWordList(myNeuron);
+
+		clearSlicedCounter(&negativeCounter, numberOfCounterBits);
+
+		//The weight bit of a disconnected input is cleared
+		for (uint32_t i=1; i <= connectedWordList[0]; i++)
+		{
+			int wordIndex = connectedWordList[i];
+			const uint64_t *wordInputSlices = &inputSliceArray[(size_t) wordIndex * NEURON_DATA_BITS_PER_WORD];
+
+			addSlicedInputWord(&positiveCounter, wordInputSlices, myNeuron->weightMask[wordIndex]);
+			addSlicedInputWord(&negativeCounter, wordInputSlices, connectionMask[wordIndex] & ~myNeuron->weightMask[wordIndex]);
+		}
+
+		flushSlicedCounter(&positiveCounter);
+		flushSlicedCounter(&negativeCounter);
+
+		neuronOutput = compareSlicedCounters(positiveCounter.counter, negativeCounter.counter, numberOfCounterBits);
+	}
+	else
+	{
+		for (int wordIndex=0; wordIndex < myNeuron->numberOfWords; wordIndex++)
+			addSlicedInputWord(&positiveCounter, &inputSliceArray[(size_t) wordIndex * NEURON_DATA_BITS_PER_WORD], myNeuron->weightMask[wordIndex]);
+
+		flushSlicedCounter(&positiveCounter);
+
+		//Twice the counter is the counter shifted one bit
+		memmove(&(positiveCounter.counter[1]), positiveCounter.counter, sizeof(uint64_t) * (numberOfCounterBits - 1));
+		positiveCounter.counter[0] = 0;
+
+		neuronOutput = compareSlicedCounters(positiveCounter.counter, activeCounter, numberOfCounterBits);
+	}
+
+	return neuronOutput;
+}
+
+//The enum is unsigned so a single comparison checks the range
+static inline bool isValidNeuronKernel(NeuronKernel myKernel)
+{
+	return (myKernel<=NEURON_KERNEL_AVX512) && (popcountKernelArray[myKernel]!=NULL);
+}
+
+//Kernel selection
+
+NeuronErrorCode isNeuronKernelSupported(NeuronKernel myKernel, bool *isSupported)
+{
+	NeuronErrorCode returnValue = NEURON_RETURN_VALUE_OK;
+
+	if (isSupported==NULL)
+		returnValue = NEURON_NULL_POINTER_ERROR;
+	else if (!isValidNeuronKernel(myKernel))
+		returnValue = NEURON_KERNEL_ERROR;
+
+	if (returnValue==NEURON_RETURN_VALUE_OK)
+	{
+		switch (myKernel)
+		{
+#ifdef NEURAL_LAYER_X86_KERNELS
+			case NEURON_KERNEL_SSE42:
+				*isSupported = __builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt");
+				break;
+
+			case NEURON_KERNEL_AVX2:
+				*isSupported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+				break;
+
+			case NEURON_KERNEL_AVX512:
+				*isSupported = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq");
+				break;
+#endif
+			case NEURON_KERNEL_SCALAR:
+				*isSupported = true;
+				break;
+
+			default:
+				*isSupported = false;
+				break;
+		}
+	}
+
+	return returnValue;
+}
+
+NeuronErrorCode getBestNeuronKernel(NeuronKernel *myKernel)
+{
+	NeuronErrorCode returnValue = NEURON_RETURN_VALUE_OK;
+
+	NeuronKernel candidateKernel = NEURON_KERNEL_AVX512;
+	bool isSupported = false;
+
+	if (myKernel==NULL)
+		returnValue = NEURON_NULL_POINTER_ERROR;
+
+	//The scalar kernel is always supported
+	while ((returnValue==NEURON_RETURN_VALUE_OK) && (!isSupported))
+	{
+		returnValue = isNeuronKernelSupported(candidateKernel, &isSupported);
+
+		if (isSupported)
+			*myKernel = candidateKernel;
+		else
+			candidateKernel--;
+	}
+
+	return returnValue;
+}
+
+//Neuron operations
+
+/*Each bit of a random word is a random weight, the bits after the last weight are cleared.
+ *A sparse neuron starts with all its inputs connected*/
+static void initializeNeuron(Neuron *myNeuron, int numberOfInputs, bool isSparse, RandomGenerator *myGenerator)
+{
+	int numberOfMaskWords = NEURON_DATA_NUMBER_OF_WORDS(numberOfInputs);
+	int lastWordBits = numberOfInputs % NEURON_DATA_BITS_PER_WORD;
+
+	myNeuron->numberOfWeights = numberOfInputs;
+	myNeuron->numberOfWords = getNeuronDataWords(numberOfInputs, isSparse);
+
+	for (int i=0; i < numberOfMaskWords; i++)
+		myNeuron->weightMask[i] = getRandomNumber(myGenerator);
+
+	if (lastWordBits!=0)
+		myNeuron->weightMask[numberOfMaskWords - 1] &= (UINT64_C(1) << lastWordBits) - 1;
+
+	if (isSparse)
+	{
+		uint64_t *connectionMask = &(myNeuron->weightMask[numberOfMaskWords]);
+
+		memset(connectionMask, 0xFF, sizeof(uint64_t) * numberOfMaskWords);
+		memset(&(myNeuron->weightMask[2 * numberOfMaskWords]), 0, sizeof(uint64_t) * (myNeuron->numberOfWords - 2 * numberOfMaskWords));
+
+		if (lastWordBits!=0)
+			connectionMask[numberOfMaskWords - 1] = (UINT64_C(1) << lastWordBits) - 1;
+
+		updateConnectedWordList(myNeuron);
+	}
+}
+
+NeuronErrorCode createNeuron(Neuron **myNeuron, int numberOfInputs, RandomGenerator *myGenerator)
+{
+	NeuronErrorCode returnValue = NEURON_RETURN_VALUE_OK;
+	
+	if ((myNeuron==NULL) || (myGenerator==NULL))
+		returnValue = NEURON_NULL_POINTER_ERROR;
+
+	if ((numberOfInputs<NEURAL_LAYER_MINIMUM_NUMBER_OF_INPUTS) || (numberOfInputs>INT_MAX))
+		returnValue = NEURON_NUMBER_OF_INPUTS_ERROR;
+
+	//Create neuron and weight array in a single block
+	if (returnValue==NEURON_RETURN_VALUE_OK)
+	{
+		*myNeuron = malloc(getNeuronSize(numberOfInputs, false));
 
-			if (randomWeight)
-				(*myNeuron)->weightArray[i] = NEURON_WEIGHT_POSITIVE;
-			else
-				(*myNeuron)->weightArray[i] = NEURON_WEIGHT_NEGATIVE;
-		}
+		if (*myNeuron==NULL)
+			returnValue = NEURON_MEMORY_ALLOCATION_ERROR;
 	}
 
+	//Initialize
+	if (returnValue==NEURON_RETURN_VALUE_OK)
+		initializeNeuron(*myNeuron, numberOfInputs, false, myGenerator);
+
 	return returnValue;
 }
 
@@ -82,7 +716,6 @@ NeuronErrorCode destroyNeuron(Neuron **myNeuron)
 
 	if (returnValue==NEURON_RETURN_VALUE_OK)
 	{
-		free((*myNeuron)->weightArray);
 		free(*myNeuron);
 		*myNeuron = NULL;
 	}
@@ -96,40 +729,67 @@ NeuronErrorCode cloneNeuron(Neuron *myNeuron, Neuron *myNeuronClone)
 
 	if ((myNeuron==NULL) || (myNeuronClone==NULL))
 		returnValue = NEURON_NULL_POINTER_ERROR;
-	else if (myNeuron->numberOfWeights != myNeuronClone->numberOfWeights)
+	else if ((myNeuron->numberOfWeights != myNeuronClone->numberOfWeights) || (myNeuron->numberOfWords != myNeuronClone->numberOfWords))
 		returnValue = NEURON_DIFFERENT_NEURONS_ERROR;
 
 	//Copy weights
 	if (returnValue==NEURON_RETURN_VALUE_OK)
 	{
-		int size = sizeof(NeuronWeight) * myNeuron->numberOfWeights;
+		int size = sizeof(uint64_t) * myNeuron->numberOfWords;
 		
-		memcpy(myNeuronClone->weightArray, myNeuron->weightArray, size);
+		memcpy(myNeuronClone->weightMask, myNeuron->weightMask, size);
 	}
 
 	return returnValue;
 }
 
-NeuronErrorCode mutateNeuron(Neuron *myNeuron)
+/*The keys of the changed weights are added to *weightHash, the weight hash of the neuron with the key
+ *neuronKey, each one in constant time. The hash is not updated if weightHash is NULL*/
+NeuronErrorCode mutateNeuron(Neuron *myNeuron, RandomGenerator *myGenerator, uint64_t neuronKey, uint64_t *weightHash)
 {
 	NeuronErrorCode returnValue = NEURON_RETURN_VALUE_OK;
 
-	if (myNeuron==NULL)
+	if ((myNeuron==NULL) || (myGenerator==NULL))
 		returnValue = NEURON_NULL_POINTER_ERROR;
 
 	if (returnValue==NEURON_RETURN_VALUE_OK)
 	{
 		//Calculate a random number of mutations
-		int numberOfMutations = (rand() % myNeuron->numberOfWeights) + 1;
+		int numberOfMutations = getRandomInteger(myGenerator, myNeuron->numberOfWeights) + 1;
+
+		if (isSparseNeuron(myNeuron))
+		{
+			//Each mutation moves a weight to one of the other two states, so it can add or remove a connection
+			for (int i=0; i < numberOfMutations; i++)
+			{
+				int randomWeight = getRandomInteger(myGenerator, myNeuron->numberOfWeights);
+				int weightStep = getRandomInteger(myGenerator, 2) + 1;
+
+				NeuronWeight oldWeight = getStoredWeight(myNeuron, randomWeight);
+
+				//NEURON_WEIGHT_NEGATIVE, NEURON_WEIGHT_DISCONNECTED and NEURON_WEIGHT_POSITIVE are consecutive
+				NeuronWeight newWeight = (NeuronWeight) ((oldWeight - NEURON_WEIGHT_NEGATIVE + weightStep) % 3 + NEURON_WEIGHT_NEGATIVE);
 
-		for (int i=0; i < numberOfMutations; i++)
+				storeWeight(myNeuron, randomWeight, newWeight);
+
+				if (weightHash!=NULL)
+					*weightHash ^= getWeightHashKey(neuronKey, randomWeight, oldWeight) ^ getWeightHashKey(neuronKey, randomWeight, newWeight);
+			}
+
+			updateConnectedWordList(myNeuron);
+		}
+		else
 		{
-			int randomWeight = rand() % myNeuron->numberOfWeights;
+			//The key of a negative weight is zero, so a flip always changes the hash by the key of the positive weight
+			for (int i=0; i < numberOfMutations; i++)
+			{
+				int randomWeight = getRandomInteger(myGenerator, myNeuron->numberOfWeights);
 
-			if (myNeuron->weightArray[randomWeight] == NEURON_WEIGHT_NEGATIVE)
-				myNeuron->weightArray[randomWeight] = NEURON_WEIGHT_POSITIVE;
-			else
-				myNeuron->weightArray[randomWeight] = NEURON_WEIGHT_NEGATIVE;
+				flipWeight(myNeuron, randomWeight);
+
+				if (weightHash!=NULL)
+					*weightHash ^= getWeightHashKey(neuronKey, randomWeight, NEURON_WEIGHT_POSITIVE);
+			}
 		}
 	}
 
@@ -159,7 +819,7 @@ NeuronErrorCode getNeuronWeight(Neuron *myNeuron, int inputNumber, NeuronWeight
 		returnValue = NEURON_NUMBER_OF_INPUTS_ERROR;
 	
 	if (returnValue==NEURON_RETURN_VALUE_OK)
-		*inputWeight = myNeuron->weightArray[inputNumber];
+		*inputWeight = getStoredWeight(myNeuron, inputNumber);
 
 	return returnValue;
 }
@@ -172,14 +832,31 @@ NeuronErrorCode setNeuronWeight(Neuron *myNeuron, int inputNumber, NeuronWeight
 		returnValue = NEURON_NULL_POINTER_ERROR;
 	else if ((inputNumber < 0) || (inputNumber >= myNeuron->numberOfWeights))
 		returnValue = NEURON_NUMBER_OF_INPUTS_ERROR;
+	else if ((inputWeight!=NEURON_WEIGHT_POSITIVE) && (inputWeight!=NEURON_WEIGHT_NEGATIVE) &&
+			 ((inputWeight!=NEURON_WEIGHT_DISCONNECTED) || (!isSparseNeuron(myNeuron))))
+		returnValue = NEURON_WEIGHT_VALUE_ERROR;
 
 	if (returnValue==NEURON_RETURN_VALUE_OK)
-		myNeuron->weightArray[inputNumber] = inputWeight;
+	{
+		if (isSparseNeuron(myNeuron))
+		{
+			int wordIndex = inputNumber / NEURON_DATA_BITS_PER_WORD;
+			bool isConnectedWord = getConnectionMask(myNeuron)[wordIndex]!=0;
+
+			storeWeight(myNeuron, inputNumber, inputWeight);
+
+			//The list only changes when a word gets its first connection or loses its last one
+			if (isConnectedWord != (getConnectionMask(myNeuron)[wordIndex]!=0))
+				updateConnectedWordList(myNeuron);
+		}
+		else if (isPositiveWeight(myNeuron, inputNumber) != (inputWeight==NEURON_WEIGHT_POSITIVE))
+			flipWeight(myNeuron, inputNumber);
+	}
 
 	return returnValue;
 }
 
-NeuronErrorCode computeNeuronOutput(Neuron *myNeuron, NeuronData *inputArray, NeuronData *neuronOutput)
+NeuronErrorCode computeNeuronOutput(const Neuron *myNeuron, const NeuronData *inputArray, NeuronData *neuronOutput)
 {
 	NeuronErrorCode returnValue = NEURON_RETURN_VALUE_OK;
 
@@ -190,8 +867,9 @@ NeuronErrorCode computeNeuronOutput(Neuron *myNeuron, NeuronData *inputArray, Ne
 	{
 		int inputSum = 0;
 
+		//The value of a weight is its factor in the weighted sum
 		for (int i=0; i < myNeuron->numberOfWeights; i++)
-			inputSum = inputSum + inputArray[i] * myNeuron->weightArray[i];
+			inputSum = inputSum + getStoredWeight(myNeuron, i) * (int) inputArray[i];
 		
 		if (inputSum>0)
 			*neuronOutput = NEURON_DATA_ONE;
@@ -202,60 +880,138 @@ NeuronErrorCode computeNeuronOutput(Neuron *myNeuron, NeuronData *inputArray, Ne
 	return returnValue;
 }
 
+NeuronErrorCode computeNeuronBinaryOutput(const Neuron *myNeuron, NeuronKernel myKernel, const uint64_t *packedInputArray, NeuronData *neuronOutput)
+{
+	NeuronErrorCode returnValue = NEURON_RETURN_VALUE_OK;
+
+	if ((myNeuron==NULL) || (packedInputArray==NULL) || (neuronOutput==NULL))
+		returnValue = NEURON_NULL_POINTER_ERROR;
+	else if (!isValidNeuronKernel(myKernel))
+		returnValue = NEURON_KERNEL_ERROR;
+
+	if (returnValue==NEURON_RETURN_VALUE_OK)
+	{
+		int numberOfActiveInputs = 0;
+
+		if (!isSparseNeuron(myNeuron))
+			numberOfActiveInputs = popcountKernelArray[myKernel](packedInputArray, packedInputArray, myNeuron->numberOfWords);
+
+		*neuronOutput = computeBinaryNeuronOutput(myNeuron, packedInputArray, numberOfActiveInputs, myKernel);
+	}
+
+	return returnValue;
+}
+
 //Neural layer operations
 
-NeuronErrorCode createNeuralLayer(NeuralLayer **myNeuralLayer, int numberOfInputs, int numberOfNeurons)
+NeuronErrorCode getNeuralLayerSize(int numberOfInputs, int numberOfNeurons, bool isSparse, size_t *size)
 {
 	NeuronErrorCode returnValue = NEURON_RETURN_VALUE_OK;
 
-	int i=0;
-
-	if (myNeuralLayer==NULL)
+	if (size==NULL)
 		returnValue = NEURON_NULL_POINTER_ERROR;
 
-	if ((numberOfInputs<NEURAL_LAYER_MINIMUM_NUMBER_OF_INPUTS) || (numberOfInputs<numberOfNeurons) || (numberOfInputs>INT_MAX))
+	if ((numberOfInputs<NEURAL_LAYER_MINIMUM_NUMBER_OF_INPUTS) || (numberOfInputs>INT_MAX))
 		returnValue = NEURON_NUMBER_OF_INPUTS_ERROR;
 
 	if ((numberOfNeurons<NEURAL_LAYER_MINIMUM_NUMBER_OF_NEURONS) || (numberOfNeurons>INT_MAX))
 		returnValue = NEURON_NUMBER_OF_NEURONS_ERROR;
 
-	//Create neural layer structure
 	if (returnValue==NEURON_RETURN_VALUE_OK)
-	{
-		*myNeuralLayer = malloc(sizeof(NeuralLayer));
+		*size = sizeof(NeuralLayer) + getNeuronSize(numberOfInputs, isSparse) * numberOfNeurons;
 
-		if (*myNeuralLayer==NULL)
-			returnValue = NEURON_MEMORY_ALLOCATION_ERROR;
-	}
+	return returnValue;
+}
+
+NeuronErrorCode initializeNeuralLayer(NeuralLayer *myNeuralLayer, int numberOfInputs, int numberOfNeurons, bool isSparse, RandomGenerator *myGenerator)
+{
+	size_t dummy;
+
+	NeuronErrorCode returnValue = getNeuralLayerSize(numberOfInputs, numberOfNeurons, isSparse, &dummy);
+
+	if ((returnValue==NEURON_RETURN_VALUE_OK) && ((myNeuralLayer==NULL) || (myGenerator==NULL)))
+		returnValue = NEURON_NULL_POINTER_ERROR;
 
-	//Create neuron array
 	if (returnValue==NEURON_RETURN_VALUE_OK)
 	{
-		(*myNeuralLayer)->neuronArray = malloc(sizeof(Neuron*) * numberOfNeurons);
+		memset(myNeuralLayer, 0, sizeof(NeuralLayer));
 
-		if ((*myNeuralLayer)->neuronArray==NULL)
-			returnValue = NEURON_MEMORY_ALLOCATION_ERROR;
+		myNeuralLayer->numberOfInputs = numberOfInputs;
+		myNeuralLayer->numberOfNeurons = numberOfNeurons;
+		myNeuralLayer->neuronSizeInWords = getNeuronSize(numberOfInputs, isSparse) / sizeof(uint64_t);
+		myNeuralLayer->isSparse = isSparse;
+
+		for (int i=0; i<numberOfNeurons; i++)
+			initializeNeuron(getNeuronAt(myNeuralLayer, i), numberOfInputs, isSparse, myGenerator);
 	}
 
-	//Create neurons
-	while ((returnValue==NEURON_RETURN_VALUE_OK) && (i<numberOfNeurons))
+	return returnValue;
+}
+
+//Check that a neural layer built elsewhere, for example loaded from a file, has the expected layout
+NeuronErrorCode checkNeuralLayer(const NeuralLayer *myNeuralLayer, int numberOfInputs, int numberOfNeurons, bool isSparse)
+{
+	NeuronErrorCode returnValue = NEURON_RETURN_VALUE_OK;
+
+	if (myNeuralLayer==NULL)
+		returnValue = NEURON_NULL_POINTER_ERROR;
+	else if ((myNeuralLayer->numberOfInputs!=numberOfInputs) || (myNeuralLayer->numberOfNeurons!=numberOfNeurons) ||
+			 (myNeuralLayer->isSparse!=isSparse) ||
+			 (myNeuralLayer->neuronSizeInWords!=(int) (getNeuronSize(numberOfInputs, isSparse) / sizeof(uint64_t))))
+
+		returnValue = NEURON_DIFFERENT_NEURAL_LAYERS_ERROR;
+
+	//The neuron headers give the size of the weight arrays read by the kernels
+	for (int i=0; (returnValue==NEURON_RETURN_VALUE_OK) && (i<numberOfNeurons); i++)
 	{
-		Neuron *myNeuron;
+		const Neuron *myNeuron = getConstNeuronAt(myNeuralLayer, i);
 
-		returnValue = createNeuron(&myNeuron, numberOfInputs);
+		if ((myNeuron->numberOfWeights!=numberOfInputs) || (myNeuron->numberOfWords!=getNeuronDataWords(numberOfInputs, isSparse)))
+			returnValue = NEURON_DIFFERENT_NEURONS_ERROR;
 
-		if (returnValue==NEURON_RETURN_VALUE_OK)
-			(*myNeuralLayer)->neuronArray[i] = myNeuron;
+		//The connected word list is read by the sparse kernels as word indexes
+		if ((returnValue==NEURON_RETURN_VALUE_OK) && isSparse)
+		{
+			int numberOfMaskWords = getNumberOfMaskWords(myNeuron);
+			const uint32_t *connectedWordList = getConnectedWordList(myNeuron);
+
+			if (connectedWordList[0] > (uint32_t) numberOfMaskWords)
+				returnValue = NEURON_DIFFERENT_NEURONS_ERROR;
 
-		i++;
+			for (uint32_t j=1; (returnValue==NEURON_RETURN_VALUE_OK) && (j<=connectedWordList[0]); j++)
+			{
+				if (connectedWordList[j] >= (uint32_t) numberOfMaskWords)
+					returnValue = NEURON_DIFFERENT_NEURONS_ERROR;
+			}
+		}
 	}
 
+	return returnValue;
+}
+
+NeuronErrorCode createNeuralLayer(NeuralLayer **myNeuralLayer, int numberOfInputs, int numberOfNeurons, bool isSparse, RandomGenerator *myGenerator)
+{
+	NeuronErrorCode returnValue = NEURON_RETURN_VALUE_OK;
+
+	size_t size = 0;
+
+	if ((myNeuralLayer==NULL) || (myGenerator==NULL))
+		returnValue = NEURON_NULL_POINTER_ERROR;
+	else
+		returnValue = getNeuralLayerSize(numberOfInputs, numberOfNeurons, isSparse, &size);
+
+	//Create neural layer structure and neurons in a single block
 	if (returnValue==NEURON_RETURN_VALUE_OK)
 	{
-		(*myNeuralLayer)->numberOfInputs = numberOfInputs;
-		(*myNeuralLayer)->numberOfNeurons = numberOfNeurons;
+		*myNeuralLayer = malloc(size);
+
+		if (*myNeuralLayer==NULL)
+			returnValue = NEURON_MEMORY_ALLOCATION_ERROR;
 	}
 
+	if (returnValue==NEURON_RETURN_VALUE_OK)
+		returnValue = initializeNeuralLayer(*myNeuralLayer, numberOfInputs, numberOfNeurons, isSparse, myGenerator);
+
 	return returnValue;
 }
 
@@ -263,22 +1019,11 @@ NeuronErrorCode destroyNeuralLayer(NeuralLayer **myNeuralLayer)
 {
 	NeuronErrorCode returnValue = NEURON_RETURN_VALUE_OK;
 
-	int i=0;
-
 	if ((myNeuralLayer==NULL) || (*myNeuralLayer==NULL))
 		returnValue = NEURON_NULL_POINTER_ERROR;
 
-	//Destroy neurons
-	while ((returnValue==NEURON_RETURN_VALUE_OK) && (i < (*myNeuralLayer)->numberOfNeurons))
-	{
-		Neuron *myNeuron = (*myNeuralLayer)->neuronArray[i];
-		returnValue = destroyNeuron(&myNeuron);
-		i++;
-	}
-
 	if (returnValue==NEURON_RETURN_VALUE_OK)
 	{
-		free((*myNeuralLayer)->neuronArray);
 		free(*myNeuralLayer);
 		*myNeuralLayer = NULL;
 	}
@@ -286,7 +1031,7 @@ NeuronErrorCode destroyNeuralLayer(NeuralLayer **myNeuralLayer)
 	return returnValue;
 }
 
-NeuronErrorCode computeNeuralLayerOutput(NeuralLayer *myNeuralLayer, NeuronData *inputArray, NeuronData *outputArray)
+NeuronErrorCode computeNeuralLayerOutput(const NeuralLayer *myNeuralLayer, const NeuronData *inputArray, NeuronData *outputArray)
 {
 	NeuronErrorCode returnValue = NEURON_RETURN_VALUE_OK;
 
@@ -297,7 +1042,7 @@ NeuronErrorCode computeNeuralLayerOutput(NeuralLayer *myNeuralLayer, NeuronData
 
 	while ((returnValue==NEURON_RETURN_VALUE_OK) && (neuronIndex < myNeuralLayer->numberOfNeurons))
 	{
-		Neuron *myNeuron = myNeuralLayer->neuronArray[neuronIndex];
+		const Neuron *myNeuron = getConstNeuronAt(myNeuralLayer, neuronIndex);
 
 		returnValue = computeNeuronOutput(myNeuron, inputArray, &(outputArray[neuronIndex]));
 
@@ -307,6 +1052,143 @@ NeuronErrorCode computeNeuralLayerOutput(NeuralLayer *myNeuralLayer, NeuronData
 	return returnValue;
 }
 
+NeuronErrorCode computeNeuralLayerBinaryOutput(const NeuralLayer *myNeuralLayer, NeuronKernel myKernel, const uint64_t *packedInputArray, uint64_t *packedOutputArray)
+{
+	NeuronErrorCode returnValue = NEURON_RETURN_VALUE_OK;
+
+	if ((myNeuralLayer==NULL) || (packedInputArray==NULL) || (packedOutputArray==NULL))
+		returnValue = NEURON_NULL_POINTER_ERROR;
+	else if (!isValidNeuronKernel(myKernel))
+		returnValue = NEURON_KERNEL_ERROR;
+
+	if (returnValue==NEURON_RETURN_VALUE_OK)
+	{
+		int numberOfWords = NEURON_DATA_NUMBER_OF_WORDS(myNeuralLayer->numberOfInputs);
+		int numberOfActiveInputs = 0;
+
+		//The number of active inputs is shared by all the neurons of a dense layer
+		if (!myNeuralLayer->isSparse)
+			numberOfActiveInputs = popcountKernelArray[myKernel](packedInputArray, packedInputArray, numberOfWords);
+
+		memset(packedOutputArray, 0, sizeof(uint64_t) * NEURON_DATA_NUMBER_OF_WORDS(myNeuralLayer->numberOfNeurons));
+
+		for (int neuronIndex=0; neuronIndex < myNeuralLayer->numberOfNeurons; neuronIndex++)
+		{
+			const Neuron *myNeuron = getConstNeuronAt(myNeuralLayer, neuronIndex);
+
+			uint64_t neuronOutput = computeBinaryNeuronOutput(myNeuron, packedInputArray, numberOfActiveInputs, myKernel);
+
+			packedOutputArray[neuronIndex / NEURON_DATA_BITS_PER_WORD] |= neuronOutput << (neuronIndex % NEURON_DATA_BITS_PER_WORD);
+		}
+	}
+
+	return returnValue;
+}
+
+NeuronErrorCode computeNeuralLayerBinaryOutputBatch(const NeuralLayer *myNeuralLayer, NeuronKernel myKernel, const uint64_t *packedInputArray, int numberOfSamples, uint64_t *packedOutputArray)
+{
+	NeuronErrorCode returnValue = NEURON_RETURN_VALUE_OK;
+
+	if ((myNeuralLayer==NULL) || (packedInputArray==NULL) || (packedOutputArray==NULL))
+		returnValue = NEURON_NULL_POINTER_ERROR;
+	else if (!isValidNeuronKernel(myKernel))
+		returnValue = NEURON_KERNEL_ERROR;
+	else if (numberOfSamples<0)
+		returnValue = NEURON_NUMBER_OF_SAMPLES_ERROR;
+
+	if (returnValue==NEURON_RETURN_VALUE_OK)
+	{
+		int numberOfInputWords = NEURON_DATA_NUMBER_OF_WORDS(myNeuralLayer->numberOfInputs);
+		int numberOfOutputWords = NEURON_DATA_NUMBER_OF_WORDS(myNeuralLayer->numberOfNeurons);
+
+		int activeInputArray[NEURAL_LAYER_BATCH_TILE_SIZE];
+
+		memset(packedOutputArray, 0, sizeof(uint64_t) * numberOfOutputWords * numberOfSamples);
+
+		//The samples are processed in tiles so each neuron is reused by all the samples of a tile while it is in the cache
+		for (int firstSample=0; firstSample < numberOfSamples; firstSample += NEURAL_LAYER_BATCH_TILE_SIZE)
+		{
+			int tileSize = numberOfSamples - firstSample;
+
+			if (tileSize > NEURAL_LAYER_BATCH_TILE_SIZE)
+				tileSize = NEURAL_LAYER_BATCH_TILE_SIZE;
+
+			//The sparse neurons count their own active inputs
+			for (int i=0; i < tileSize; i++)
+			{
+				const uint64_t *sampleInput = &packedInputArray[(size_t) (firstSample + i) * numberOfInputWords];
+
+				activeInputArray[i] = myNeuralLayer->isSparse ? 0 : popcountKernelArray[myKernel](sampleInput, sampleInput, numberOfInputWords);
+			}
+
+			for (int neuronIndex=0; neuronIndex < myNeuralLayer->numberOfNeurons; neuronIndex++)
+			{
+				const Neuron *myNeuron = getConstNeuronAt(myNeuralLayer, neuronIndex);
+
+				uint64_t neuronBit = UINT64_C(1) << (neuronIndex % NEURON_DATA_BITS_PER_WORD);
+				int neuronWord = neuronIndex / NEURON_DATA_BITS_PER_WORD;
+
+				for (int i=0; i < tileSize; i++)
+				{
+					size_t sampleIndex = firstSample + i;
+
+					const uint64_t *sampleInput = &packedInputArray[sampleIndex * numberOfInputWords];
+
+					if (computeBinaryNeuronOutput(myNeuron, sampleInput, activeInputArray[i], myKernel)==NEURON_DATA_ONE)
+						packedOutputArray[sampleIndex * numberOfOutputWords + neuronWord] |= neuronBit;
+				}
+			}
+		}
+	}
+
+	return returnValue;
+}
+
+NeuronErrorCode computeNeuralLayerBitSlicedOutput(const NeuralLayer *myNeuralLayer, const uint64_t *inputSliceArray, uint64_t *outputSliceArray)
+{
+	NeuronErrorCode returnValue = NEURON_RETURN_VALUE_OK;
+
+	if ((myNeuralLayer==NULL) || (inputSliceArray==NULL) || (outputSliceArray==NULL))
+		returnValue = NEURON_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURON_RETURN_VALUE_OK)
+	{
+		SlicedCounter activeCounter;
+
+		int numberOfInputs = myNeuralLayer->numberOfInputs;
+		int numberOfCounterBits = 1;
+
+		//A counter needs one bit more than the number of inputs of the layer to hold twice the count
+		while ((numberOfInputs >> (numberOfCounterBits - 1))!=0)
+			numberOfCounterBits++;
+
+		clearSlicedCounter(&activeCounter, numberOfCounterBits);
+
+		//The active inputs are shared by all the neurons of a dense layer
+		if (!myNeuralLayer->isSparse)
+		{
+			for (int firstInput=0; firstInput < numberOfInputs; firstInput += NEURON_DATA_BITS_PER_WORD)
+			{
+				int wordBits = numberOfInputs - firstInput;
+				uint64_t inputMask = (wordBits < NEURON_DATA_BITS_PER_WORD) ? (UINT64_C(1) << wordBits) - 1 : ~UINT64_C(0);
+
+				addSlicedInputWord(&activeCounter, &inputSliceArray[firstInput], inputMask);
+			}
+
+			flushSlicedCounter(&activeCounter);
+		}
+
+		for (int neuronIndex=0; neuronIndex < myNeuralLayer->numberOfNeurons; neuronIndex++)
+		{
+			const Neuron *myNeuron = getConstNeuronAt(myNeuralLayer, neuronIndex);
+
+			outputSliceArray[neuronIndex] = computeBitSlicedNeuronOutput(myNeuron, inputSliceArray, activeCounter.counter, numberOfCounterBits);
+		}
+	}
+
+	return returnValue;
+}
+
 NeuronErrorCode getNumberOfNeurons(NeuralLayer* myNeuralLayer, int *numberOfNeurons)
 {
 	NeuronErrorCode returnValue = NEURON_RETURN_VALUE_OK;
@@ -330,7 +1212,7 @@ NeuronErrorCode getNeuron(NeuralLayer *myNeuralLayer, int neuronNumber, Neuron *
 		returnValue = NEURON_NUMBER_OF_NEURONS_ERROR;
 
 	if (returnValue==NEURON_RETURN_VALUE_OK)
-		*myNeuron = myNeuralLayer->neuronArray[neuronNumber];
+		*myNeuron = getNeuronAt(myNeuralLayer, neuronNumber);
 
 	return returnValue;
 }
@@ -339,31 +1221,33 @@ NeuronErrorCode cloneNeuralLayer(NeuralLayer *myNeuralLayer, NeuralLayer *myNeur
 {
 	NeuronErrorCode returnValue = NEURON_RETURN_VALUE_OK;
 
-	int i=0;
-
 	if ((myNeuralLayer==NULL) || (myNeuralLayerClone==NULL))
 		returnValue = NEURON_NULL_POINTER_ERROR;
-	else if (myNeuralLayer->numberOfNeurons!=myNeuralLayerClone->numberOfNeurons)
+	else if ((myNeuralLayer->numberOfNeurons!=myNeuralLayerClone->numberOfNeurons) ||
+			 (myNeuralLayer->numberOfInputs!=myNeuralLayerClone->numberOfInputs) ||
+			 (myNeuralLayer->isSparse!=myNeuralLayerClone->isSparse))
 		returnValue = NEURON_DIFFERENT_NEURAL_LAYERS_ERROR;
 
-	while ((returnValue==NEURON_RETURN_VALUE_OK) && (i < myNeuralLayer->numberOfNeurons))
+	//The neurons are contiguous so all the weights are copied at once
+	if (returnValue==NEURON_RETURN_VALUE_OK)
 	{
-		Neuron *myNeuron = myNeuralLayer->neuronArray[i];
-		Neuron *myNeuronClone = myNeuralLayerClone->neuronArray[i];
-
-		returnValue = cloneNeuron(myNeuron, myNeuronClone);
+		size_t size = sizeof(uint64_t) * myNeuralLayer->neuronSizeInWords * myNeuralLayer->numberOfNeurons;
 
-		i++;
+		memcpy(myNeuralLayerClone->neuronData, myNeuralLayer->neuronData, size);
 	}
 
 	return returnValue;
 }
 
-NeuronErrorCode mutateNeuralLayer(NeuralLayer *myNeuralLayer, bool isMassiveMutation)
+//The index of the mutated neuron is returned in mutantNeuronIndex, which can be NULL
+/*The weight hash of the neural layer with the key layerKey is updated as in mutateNeuron, each neuron
+ *with the key NEURON_HASH_KEY(layerKey, neuronIndex)*/
+NeuronErrorCode mutateNeuralLayer(NeuralLayer *myNeuralLayer, bool isMassiveMutation, RandomGenerator *myGenerator, int *mutantNeuronIndex,
+								  uint64_t layerKey, uint64_t *weightHash)
 {
 	NeuronErrorCode returnValue = NEURON_RETURN_VALUE_OK;
 
-	if (myNeuralLayer==NULL)
+	if ((myNeuralLayer==NULL) || (myGenerator==NULL))
 		returnValue = NEURON_NULL_POINTER_ERROR;
 	
 	if (returnValue==NEURON_RETURN_VALUE_OK)
@@ -374,19 +1258,140 @@ NeuronErrorCode mutateNeuralLayer(NeuralLayer *myNeuralLayer, bool isMassiveMuta
 
 			while ((i < myNeuralLayer->numberOfNeurons) && (returnValue==NEURON_RETURN_VALUE_OK))
 			{
-				Neuron *mutantNeuron = myNeuralLayer->neuronArray[i];
-				returnValue = mutateNeuron(mutantNeuron);
+				Neuron *mutantNeuron = getNeuronAt(myNeuralLayer, i);
+				returnValue = mutateNeuron(mutantNeuron, myGenerator, NEURON_HASH_KEY(layerKey, i), weightHash);
 
 				i++;
 			}
+
+			if (mutantNeuronIndex!=NULL)
+				*mutantNeuronIndex = NEURAL_LAYER_ALL_NEURONS;
 		}
 		else
 		{
-			int mutantNeuronIndex = rand() % myNeuralLayer->numberOfNeurons;
-			Neuron *mutantNeuron = myNeuralLayer->neuronArray[mutantNeuronIndex];
-			returnValue = mutateNeuron(mutantNeuron);
+			int randomNeuronIndex = getRandomInteger(myGenerator, myNeuralLayer->numberOfNeurons);
+			Neuron *mutantNeuron = getNeuronAt(myNeuralLayer, randomNeuronIndex);
+			returnValue = mutateNeuron(mutantNeuron, myGenerator, NEURON_HASH_KEY(layerKey, randomNeuronIndex), weightHash);
+
+			if (mutantNeuronIndex!=NULL)
+				*mutantNeuronIndex = randomNeuronIndex;
 		}
 	}
 	
 	return returnValue;
 }
+
+NeuronErrorCode getNeuralLayerWeightHash(const NeuralLayer *myNeuralLayer, uint64_t layerKey, uint64_t *weightHash)
+{
+	NeuronErrorCode returnValue = NEURON_RETURN_VALUE_OK;
+
+	if ((myNeuralLayer==NULL) || (weightHash==NULL))
+		returnValue = NEURON_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURON_RETURN_VALUE_OK)
+	{
+		*weightHash = 0;
+
+		for (int neuronIndex=0; neuronIndex < myNeuralLayer->numberOfNeurons; neuronIndex++)
+			*weightHash ^= computeNeuronWeightHash(getConstNeuronAt(myNeuralLayer, neuronIndex), NEURON_HASH_KEY(layerKey, neuronIndex));
+	}
+
+	return returnValue;
+}
+
+//Binary engine operations
+
+NeuronErrorCode packNeuronDataArray(const NeuronData *inputArray, int numberOfInputs, uint64_t *packedInputArray)
+{
+	NeuronErrorCode returnValue = NEURON_RETURN_VALUE_OK;
+
+	if ((inputArray==NULL) || (packedInputArray==NULL))
+		returnValue = NEURON_NULL_POINTER_ERROR;
+	else if (numberOfInputs<0)
+		returnValue = NEURON_NUMBER_OF_INPUTS_ERROR;
+
+	if (returnValue==NEURON_RETURN_VALUE_OK)
+	{
+		memset(packedInputArray, 0, sizeof(uint64_t) * NEURON_DATA_NUMBER_OF_WORDS(numberOfInputs));
+
+		for (int i=0; i<numberOfInputs; i++)
+		{
+			if (inputArray[i]!=NEURON_DATA_ZERO)
+				packedInputArray[i / NEURON_DATA_BITS_PER_WORD] |= UINT64_C(1) << (i % NEURON_DATA_BITS_PER_WORD);
+		}
+	}
+
+	return returnValue;
+}
+
+NeuronErrorCode unpackNeuronDataArray(const uint64_t *packedInputArray, int numberOfInputs, NeuronData *inputArray)
+{
+	NeuronErrorCode returnValue = NEURON_RETURN_VALUE_OK;
+
+	if ((inputArray==NULL) || (packedInputArray==NULL))
+		returnValue = NEURON_NULL_POINTER_ERROR;
+	else if (numberOfInputs<0)
+		returnValue = NEURON_NUMBER_OF_INPUTS_ERROR;
+
+	if (returnValue==NEURON_RETURN_VALUE_OK)
+	{
+		for (int i=0; i<numberOfInputs; i++)
+		{
+			uint64_t word = packedInputArray[i / NEURON_DATA_BITS_PER_WORD];
+
+			inputArray[i] = ((word >> (i % NEURON_DATA_BITS_PER_WORD)) & 1) ? NEURON_DATA_ONE : NEURON_DATA_ZERO;
+		}
+	}
+
+	return returnValue;
+}
+
+/*The packed weights of a neuron can be saved and restored as numberOfWords 64-bit words, which
+ *include the connection mask and the connected word list of a sparse neuron*/
+NeuronErrorCode getNeuronPackedWeights(Neuron *myNeuron, uint64_t **packedWeightArray, int *numberOfWords)
+{
+	NeuronErrorCode returnValue = NEURON_RETURN_VALUE_OK;
+
+	if ((myNeuron==NULL) || (packedWeightArray==NULL) || (numberOfWords==NULL))
+		returnValue = NEURON_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURON_RETURN_VALUE_OK)
+	{
+		*packedWeightArray = myNeuron->weightMask;
+		*numberOfWords = myNeuron->numberOfWords;
+	}
+
+	return returnValue;
+}
+
+//The connection mask of a dense neuron is NULL because all its inputs are connected
+NeuronErrorCode getNeuronConnectionMask(Neuron *myNeuron, const uint64_t **connectionMask)
+{
+	NeuronErrorCode returnValue = NEURON_RETURN_VALUE_OK;
+
+	if ((myNeuron==NULL) || (connectionMask==NULL))
+		returnValue = NEURON_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURON_RETURN_VALUE_OK)
+		*connectionMask = isSparseNeuron(myNeuron) ? getConnectionMask(myNeuron) : NULL;
+
+	return returnValue;
+}
+
+NeuronErrorCode getNumberOfConnections(Neuron *myNeuron, int *numberOfConnections)
+{
+	NeuronErrorCode returnValue = NEURON_RETURN_VALUE_OK;
+
+	if ((myNeuron==NULL) || (numberOfConnections==NULL))
+		returnValue = NEURON_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURON_RETURN_VALUE_OK)
+	{
+		if (isSparseNeuron(myNeuron))
+			*numberOfConnections = scalarPopcountKernel(getConnectionMask(myNeuron), getConnectionMask(myNeuron), getNumberOfMaskWords(myNeuron));
+		else
+			*numberOfConnections = myNeuron->numberOfWeights;
+	}
+
+	return returnValue;
+}
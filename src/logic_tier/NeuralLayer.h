@@ -13,10 +13,27 @@
 #include <time.h>
 #include <limits.h>
 #include <string.h>
+#include <stdint.h>
+
+#include "Random.h"
 
 #define NEURAL_LAYER_MINIMUM_NUMBER_OF_INPUTS 2
 #define NEURAL_LAYER_MINIMUM_NUMBER_OF_NEURONS 1
 
+//Mutant neuron index of a massive mutation
+#define NEURAL_LAYER_ALL_NEURONS -1
+
+//Binary engine: weights and activations are packed in 64-bit words, one bit per input
+#define NEURON_DATA_BITS_PER_WORD 64
+#define NEURON_DATA_NUMBER_OF_WORDS(numberOfBits) (((numberOfBits) + NEURON_DATA_BITS_PER_WORD - 1) / NEURON_DATA_BITS_PER_WORD)
+
+/*Key of a neuron in the weight hash, made of the key of its neural layer and its index. The low half
+ *of the key is left for the inputs of the neuron*/
+#define NEURON_HASH_KEY(layerKey, neuronIndex) ((layerKey) ^ ((uint64_t) (neuronIndex) << 32))
+
+//Number of samples that share each neuron while it is in the cache during a batch
+#define NEURAL_LAYER_BATCH_TILE_SIZE 64
+
 typedef enum
 {
 	NEURON_DATA_ZERO,
@@ -26,9 +43,19 @@ typedef enum
 typedef enum
 {
 	NEURON_WEIGHT_POSITIVE = 1,
-	NEURON_WEIGHT_NEGATIVE = -1
+	NEURON_WEIGHT_NEGATIVE = -1,
+	NEURON_WEIGHT_DISCONNECTED = 0 //Only in the neurons of sparse layers
 } NeuronWeight;
 
+//Popcount kernels of the binary engine, sorted from slowest to fastest
+typedef enum
+{
+	NEURON_KERNEL_SCALAR,
+	NEURON_KERNEL_SSE42,
+	NEURON_KERNEL_AVX2,
+	NEURON_KERNEL_AVX512
+} NeuronKernel;
+
 typedef enum
 {
 	NEURON_RETURN_VALUE_OK = 0,
@@ -37,29 +64,50 @@ typedef enum
 	NEURON_NUMBER_OF_INPUTS_ERROR = -3,
 	NEURON_NUMBER_OF_NEURONS_ERROR = -4,
 	NEURON_DIFFERENT_NEURONS_ERROR = -5,
-	NEURON_DIFFERENT_NEURAL_LAYERS_ERROR = -6
+	NEURON_DIFFERENT_NEURAL_LAYERS_ERROR = -6,
+	NEURON_WEIGHT_VALUE_ERROR = -7,
+	NEURON_KERNEL_ERROR = -8,
+	NEURON_NUMBER_OF_SAMPLES_ERROR = -9
 } NeuronErrorCode;
 
 typedef struct neuron Neuron;
 typedef struct neuralLayer NeuralLayer;
 
 //Neuron operations
-NeuronErrorCode createNeuron(Neuron **myNeuron, int numberOfInputs);
+NeuronErrorCode createNeuron(Neuron **myNeuron, int numberOfInputs, RandomGenerator *myGenerator);
 NeuronErrorCode destroyNeuron(Neuron **myNeuron);
 NeuronErrorCode cloneNeuron(Neuron *myNeuron, Neuron *myNeuronClone);
-NeuronErrorCode mutateNeuron(Neuron *myNeuron);
+NeuronErrorCode mutateNeuron(Neuron *myNeuron, RandomGenerator *myGenerator, uint64_t neuronKey, uint64_t *weightHash);
 NeuronErrorCode getNumberOfInputs(Neuron *myNeuron, int *numberOfInputs);
 NeuronErrorCode getNeuronWeight(Neuron *myNeuron, int inputNumber, NeuronWeight *inputWeight);
 NeuronErrorCode setNeuronWeight(Neuron *myNeuron, int inputNumber, NeuronWeight inputWeight);
-NeuronErrorCode computeNeuronOutput(Neuron *myNeuron, NeuronData *inputArray, NeuronData *neuronOutput);
+NeuronErrorCode computeNeuronOutput(const Neuron *myNeuron, const NeuronData *inputArray, NeuronData *neuronOutput);
+NeuronErrorCode computeNeuronBinaryOutput(const Neuron *myNeuron, NeuronKernel myKernel, const uint64_t *packedInputArray, NeuronData *neuronOutput);
 
 //Neural layer operations
-NeuronErrorCode createNeuralLayer(NeuralLayer **myNeuralLayer, int numberOfInputs, int numberOfNeurons);
+NeuronErrorCode getNeuralLayerSize(int numberOfInputs, int numberOfNeurons, bool isSparse, size_t *size);
+NeuronErrorCode initializeNeuralLayer(NeuralLayer *myNeuralLayer, int numberOfInputs, int numberOfNeurons, bool isSparse, RandomGenerator *myGenerator);
+NeuronErrorCode checkNeuralLayer(const NeuralLayer *myNeuralLayer, int numberOfInputs, int numberOfNeurons, bool isSparse);
+NeuronErrorCode createNeuralLayer(NeuralLayer **myNeuralLayer, int numberOfInputs, int numberOfNeurons, bool isSparse, RandomGenerator *myGenerator);
 NeuronErrorCode destroyNeuralLayer(NeuralLayer **myNeuralLayer);
-NeuronErrorCode computeNeuralLayerOutput(NeuralLayer *myNeuralLayer, NeuronData *inputArray, NeuronData *outputArray);
+NeuronErrorCode computeNeuralLayerOutput(const NeuralLayer *myNeuralLayer, const NeuronData *inputArray, NeuronData *outputArray);
+NeuronErrorCode computeNeuralLayerBinaryOutput(const NeuralLayer *myNeuralLayer, NeuronKernel myKernel, const uint64_t *packedInputArray, uint64_t *packedOutputArray);
+NeuronErrorCode computeNeuralLayerBinaryOutputBatch(const NeuralLayer *myNeuralLayer, NeuronKernel myKernel, const uint64_t *packedInputArray, int numberOfSamples, uint64_t *packedOutputArray);
+NeuronErrorCode computeNeuralLayerBitSlicedOutput(const NeuralLayer *myNeuralLayer, const uint64_t *inputSliceArray, uint64_t *outputSliceArray);
 NeuronErrorCode getNumberOfNeurons(NeuralLayer* myNeuralLayer, int *numberOfNeurons);
 NeuronErrorCode getNeuron(NeuralLayer *myNeuralLayer, int neuronNumber, Neuron **myNeuron);
 NeuronErrorCode cloneNeuralLayer(NeuralLayer *myNeuralLayer, NeuralLayer *myNeuralLayerClone);
-NeuronErrorCode mutateNeuralLayer(NeuralLayer *myNeuralLayer, bool isMassiveMutation);
+NeuronErrorCode mutateNeuralLayer(NeuralLayer *myNeuralLayer, bool isMassiveMutation, RandomGenerator *myGenerator, int *mutantNeuronIndex,
+								  uint64_t layerKey, uint64_t *weightHash);
+NeuronErrorCode getNeuralLayerWeightHash(const NeuralLayer *myNeuralLayer, uint64_t layerKey, uint64_t *weightHash);
+
+//Binary engine operations
+NeuronErrorCode packNeuronDataArray(const NeuronData *inputArray, int numberOfInputs, uint64_t *packedInputArray);
+NeuronErrorCode unpackNeuronDataArray(const uint64_t *packedInputArray, int numberOfInputs, NeuronData *inputArray);
+NeuronErrorCode getNeuronPackedWeights(Neuron *myNeuron, uint64_t **packedWeightArray, int *numberOfWords);
+NeuronErrorCode getNeuronConnectionMask(Neuron *myNeuron, const uint64_t **connectionMask);
+NeuronErrorCode getNumberOfConnections(Neuron *myNeuron, int *numberOfConnections);
+NeuronErrorCode isNeuronKernelSupported(NeuronKernel myKernel, bool *isSupported);
+NeuronErrorCode getBestNeuronKernel(NeuronKernel *myKernel);
 
 #endif /* LOGIC_TIER_NEURAL_LAYER_H_ */
@@ -7,433 +7,2116 @@
 
 #include "NeuralNetwork.h"
 
-typedef struct neuralNetwork
+//The neural network, its neural layers and its buffers are stored in a single cache-line-aligned arena
+#define NEURAL_NETWORK_ARENA_ALIGNMENT 64
+
+//Location of a mutation log entry that holds the whole layer region instead of a single neuron
+#define MUTATION_LOG_LAYER_REGION UINT64_MAX
+//Location of a mutation log entry that holds the weight hash before a mutation
+#define MUTATION_LOG_WEIGHT_HASH (UINT64_MAX - 1)
+#define MUTATION_LOG_HEADER_SIZE 2
+#define MUTATION_LOG_MINIMUM_CAPACITY 64
+
+/*An inference context holds the input, scratch and output buffers of a computation, so several
+ *threads can compute the output of the same neural network, each one with its own context. The batch
+ *buffers hold the layer input and the layer output of a tile of samples, or the slices of the
+ *bit-sliced engine*/
+typedef struct neuralNetworkContext
 {
 	int numberOfInputs;
+	int maximumLayerWidth;
+	int numberOfOutputs;
 	NeuronData *inputLayer;
 	NeuronData *neuralLayerInputArray;
 	NeuronData *neuralLayerOutputArray;
+	uint64_t *packedLayerInputArray;
+	uint64_t *packedLayerOutputArray;
+	NeuronData *neuralNetworkOutputArray;
+	void *batchInputBuffer;
+	void *batchOutputBuffer;
+} NeuralNetworkContext;
+
+/*The activation cache stores the packed input and the packed output of every neural layer for each
+ *test case. Each mutation starts a new epoch and stamps the mutated neurons with it, so a test case
+ *computed at an older epoch only has to recompute the neurons mutated since then*/
+typedef struct
+{
+	int numberOfTestCases;
+	int numberOfWords;
+	uint64_t mutationEpoch;
+	uint64_t *neuronEpochArray;
+	uint64_t *testCaseEpochArray;
+	uint64_t *activationArray;
+	size_t size;
+} ActivationCache;
+
+/*The mutation log is a stack of the weights overwritten by the mutations since the last commit. Each
+ *entry holds the saved words followed by their number and their location, so the entries are
+ *restored from the last one to the first one*/
+typedef struct
+{
+	bool isEnabled;
+	size_t numberOfWords;
+	size_t capacity;
+	uint64_t *wordArray;
+} MutationLog;
+
+/*The neural layers are stored one after another in the layer region and they are located by
+ *their offset from the start of the region. The output layer is the last neural layer. Each hidden
+ *layer has its own width, and the scratch buffers are sized for the widest layer. The neural
+ *network context is used by the functions that do not receive a context. The weight hash follows
+ *the mutations while it is valid, and it is computed again from the weights when it is requested
+ *after the weights have been replaced or handed out to the caller*/
+typedef struct neuralNetwork
+{
+	int numberOfInputs;
 	int numberOfHiddenLayers;
-	NeuralLayer **hiddenLayerArray;
 	int numberOfOutputs;
-	NeuralLayer *outputLayer;
-	NeuronData *neuralNetworkOutputArray;
+	int maximumLayerWidth;
+	int *hiddenLayerWidthArray;
+	NeuralNetworkConnectivity connectivity;
+	size_t *layerOffsetArray;
+	unsigned char *layerRegion;
+	size_t layerRegionSize;
+	NeuralNetworkEngine engine;
+	NeuronKernel kernel;
+	RandomGenerator generator;
+	NeuralNetworkContext context;
+	ActivationCache *activationCache;
+	MutationLog mutationLog;
+	uint64_t weightHash;
+	bool isWeightHashValid;
+	NeuralNetworkReleaseFunction releaseFunction;
 } NeuralNetwork;
 
-NeuralNetworkErrorCode createNeuralNetwork(NeuralNetwork **myNeuralNetwork, int numberOfInputs, int numberOfHiddenLayers, int numberOfOutputs)
+static inline size_t alignArenaSize(size_t size)
+{
+	return (size + NEURAL_NETWORK_ARENA_ALIGNMENT - 1) / NEURAL_NETWORK_ARENA_ALIGNMENT * NEURAL_NETWORK_ARENA_ALIGNMENT;
+}
+
+static inline NeuralLayer *getNeuralLayerAt(const NeuralNetwork *myNeuralNetwork, int layerIndex)
+{
+	return (NeuralLayer *) (myNeuralNetwork->layerRegion + myNeuralNetwork->layerOffsetArray[layerIndex]);
+}
+
+//The layer index 0 is the first hidden layer and the layer index numberOfHiddenLayers is the output layer
+static inline int getNumberOfLayerInputs(const NeuralNetwork *myNeuralNetwork, int layerIndex)
+{
+	return (layerIndex==0) ? myNeuralNetwork->numberOfInputs : myNeuralNetwork->hiddenLayerWidthArray[layerIndex - 1];
+}
+
+static inline int getNumberOfLayerNeurons(const NeuralNetwork *myNeuralNetwork, int layerIndex)
+{
+	return (layerIndex < myNeuralNetwork->numberOfHiddenLayers) ? myNeuralNetwork->hiddenLayerWidthArray[layerIndex] : myNeuralNetwork->numberOfOutputs;
+}
+
+//Without a width array every hidden layer is as wide as the input layer
+static inline int getTopologyHiddenLayerWidth(const int *hiddenLayerWidthArray, int hiddenLayerIndex, int numberOfInputs)
+{
+	return (hiddenLayerWidthArray==NULL) ? numberOfInputs : hiddenLayerWidthArray[hiddenLayerIndex];
+}
+
+/*Each batch buffer holds a tile of samples as wide as the widest layer, unpacked for the integer
+ *engine or packed for the binary engine. The bit-sliced engine keeps the input and output slices in
+ *one batch buffer and the slices of two hidden layers in the other one*/
+static inline size_t getBatchBufferSize(int maximumLayerWidth)
+{
+	size_t integerBufferSize = sizeof(NeuronData) * maximumLayerWidth * NEURAL_LAYER_BATCH_TILE_SIZE;
+	size_t binaryBufferSize = sizeof(uint64_t) * NEURON_DATA_NUMBER_OF_WORDS(maximumLayerWidth) * NEURAL_LAYER_BATCH_TILE_SIZE;
+	size_t bitSlicedBufferSize = sizeof(uint64_t) * 2 * (size_t) maximumLayerWidth;
+	size_t bufferSize = (integerBufferSize > binaryBufferSize) ? integerBufferSize : binaryBufferSize;
+
+	return alignArenaSize((bufferSize > bitSlicedBufferSize) ? bufferSize : bitSlicedBufferSize);
+}
+
+static inline size_t getContextBuffersSize(int numberOfInputs, int maximumLayerWidth, int numberOfOutputs)
+{
+	return alignArenaSize(sizeof(NeuronData) * numberOfInputs) +
+		   alignArenaSize(sizeof(NeuronData) * maximumLayerWidth) * 2 +
+		   alignArenaSize(sizeof(uint64_t) * NEURON_DATA_NUMBER_OF_WORDS(maximumLayerWidth)) * 2 +
+		   alignArenaSize(sizeof(NeuronData) * numberOfOutputs) +
+		   getBatchBufferSize(maximumLayerWidth) * 2;
+}
+
+//Place the context buffers at the start of an aligned and zeroed memory block of getContextBuffersSize bytes
+static void initializeContext(NeuralNetworkContext *myContext, unsigned char *buffers, int numberOfInputs, int maximumLayerWidth, int numberOfOutputs)
+{
+	int numberOfWords = NEURON_DATA_NUMBER_OF_WORDS(maximumLayerWidth);
+
+	myContext->numberOfInputs = numberOfInputs;
+	myContext->maximumLayerWidth = maximumLayerWidth;
+	myContext->numberOfOutputs = numberOfOutputs;
+
+	myContext->inputLayer = (NeuronData *) buffers;
+	buffers += alignArenaSize(sizeof(NeuronData) * numberOfInputs);
+
+	myContext->neuralLayerInputArray = (NeuronData *) buffers;
+	buffers += alignArenaSize(sizeof(NeuronData) * maximumLayerWidth);
+
+	myContext->neuralLayerOutputArray = (NeuronData *) buffers;
+	buffers += alignArenaSize(sizeof(NeuronData) * maximumLayerWidth);
+
+	myContext->packedLayerInputArray = (uint64_t *) buffers;
+	buffers += alignArenaSize(sizeof(uint64_t) * numberOfWords);
+
+	myContext->packedLayerOutputArray = (uint64_t *) buffers;
+	buffers += alignArenaSize(sizeof(uint64_t) * numberOfWords);
+
+	myContext->neuralNetworkOutputArray = (NeuronData *) buffers;
+	buffers += alignArenaSize(sizeof(NeuronData) * numberOfOutputs);
+
+	myContext->batchInputBuffer = buffers;
+	buffers += getBatchBufferSize(maximumLayerWidth);
+
+	myContext->batchOutputBuffer = buffers;
+}
+
+//The neural network is only read, so any number of contexts can use it at the same time
+static NeuralNetworkErrorCode computeIntegerOutput(const NeuralNetwork *myNeuralNetwork, NeuralNetworkContext *myContext)
 {
 	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
-	static bool randomSeedInitialized = false;
+	NeuronData *layerInputArray = myContext->neuralLayerInputArray;
+	NeuronData *layerOutputArray = myContext->neuralLayerOutputArray;
+	NeuronData *auxArray;
 
-	int neuronsPerHiddenLayer = numberOfInputs;
+	int hiddenLayerIndex=0;
+	
 	NeuronErrorCode result;
-	int i=0;
 
-	//Initialize random seed
-	if (!randomSeedInitialized)
+	//The first hidden layer input is the input layer
+	int size = sizeof(NeuronData) * myNeuralNetwork->numberOfInputs;
+
+	memcpy(layerInputArray, myContext->inputLayer, size);
+
+	//Feed hidden layers
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (hiddenLayerIndex<myNeuralNetwork->numberOfHiddenLayers))
 	{
-		srand(time(NULL));
-		randomSeedInitialized = true;
+		result = computeNeuralLayerOutput(getNeuralLayerAt(myNeuralNetwork, hiddenLayerIndex), layerInputArray, layerOutputArray);
+
+		if (result!=NEURON_RETURN_VALUE_OK)
+			returnValue = NEURAL_NETWORK_NEURON_ERROR;
+
+		//The hidden layer output is the input of the next layer
+		auxArray = layerInputArray;
+		layerInputArray = layerOutputArray;
+		layerOutputArray = auxArray;
+
+		hiddenLayerIndex++;
 	}
 
-	if (myNeuralNetwork==NULL)
-		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	//Feed output layer
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		result = computeNeuralLayerOutput(getNeuralLayerAt(myNeuralNetwork, myNeuralNetwork->numberOfHiddenLayers), layerInputArray, myContext->neuralNetworkOutputArray);
+		
+		if (result!=NEURON_RETURN_VALUE_OK)
+			returnValue = NEURAL_NETWORK_NEURON_ERROR;
+	}
 
-	if ((numberOfInputs<NEURAL_NETWORK_MINIMUM_NUMBER_OF_INPUTS) || (numberOfInputs>INT_MAX))
-		returnValue = NEURAL_NETWORK_NUMBER_OF_INPUTS_ERROR;
+	return returnValue;
+}
 
-	if ((numberOfHiddenLayers<NEURAL_NETWORK_MINIMUM_NUMBER_OF_HIDDEN_LAYERS) || (numberOfHiddenLayers>INT_MAX))
-		returnValue = NEURAL_NETWORK_NUMBER_OF_HIDDEN_LAYERS_ERROR;
+static NeuralNetworkErrorCode computeBinaryOutput(const NeuralNetwork *myNeuralNetwork, NeuralNetworkContext *myContext)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
-	if ((numberOfOutputs<NEURAL_NETWORK_MINIMUM_NUMBER_OF_NEURONS_PER_LAYER) || (numberOfOutputs>INT_MAX))
-		returnValue = NEURAL_NETWORK_NUMBER_OF_NEURONS_PER_LAYER_ERROR;
+	uint64_t *packedInputArray = myContext->packedLayerInputArray;
+	uint64_t *packedOutputArray = myContext->packedLayerOutputArray;
+	uint64_t *auxArray;
+
+	int hiddenLayerIndex=0;
+
+	//The first hidden layer input is the packed input layer
+	NeuronErrorCode result = packNeuronDataArray(myContext->inputLayer, myNeuralNetwork->numberOfInputs, packedInputArray);
+
+	if (result!=NEURON_RETURN_VALUE_OK)
+		returnValue = NEURAL_NETWORK_NEURON_ERROR;
+
+	//Feed hidden layers
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (hiddenLayerIndex<myNeuralNetwork->numberOfHiddenLayers))
+	{
+		result = computeNeuralLayerBinaryOutput(getNeuralLayerAt(myNeuralNetwork, hiddenLayerIndex), myNeuralNetwork->kernel, packedInputArray, packedOutputArray);
+
+		if (result!=NEURON_RETURN_VALUE_OK)
+			returnValue = NEURAL_NETWORK_NEURON_ERROR;
+
+		//The hidden layer output is the input of the next layer
+		auxArray = packedInputArray;
+		packedInputArray = packedOutputArray;
+		packedOutputArray = auxArray;
+
+		hiddenLayerIndex++;
+	}
+
+	//Feed output layer
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		result = computeNeuralLayerBinaryOutput(getNeuralLayerAt(myNeuralNetwork, myNeuralNetwork->numberOfHiddenLayers), myNeuralNetwork->kernel, packedInputArray, packedOutputArray);
+
+		if (result==NEURON_RETURN_VALUE_OK)
+			result = unpackNeuronDataArray(packedOutputArray, myNeuralNetwork->numberOfOutputs, myContext->neuralNetworkOutputArray);
+
+		if (result!=NEURON_RETURN_VALUE_OK)
+			returnValue = NEURAL_NETWORK_NEURON_ERROR;
+	}
+
+	return returnValue;
+}
+
+//Key of a neural layer in the weight hash, the layer index 0 is the first hidden layer
+static inline uint64_t getLayerHashKey(int layerIndex)
+{
+	return mixRandomBits((uint64_t) layerIndex + 1);
+}
+
+//Pointer to the weight hash updated by the mutations, or NULL if the weight hash must be computed again anyway
+static inline uint64_t *getMutationWeightHash(NeuralNetwork *myNeuralNetwork)
+{
+	return myNeuralNetwork->isWeightHashValid ? &(myNeuralNetwork->weightHash) : NULL;
+}
+
+//Activation slot 0 is the input layer and activation slot i+1 is the output of the neural layer i
+static inline uint64_t *getCachedActivation(const ActivationCache *myCache, int numberOfNeuralLayers, int testCaseIndex, int activationSlot)
+{
+	return myCache->activationArray + ((size_t) testCaseIndex * (numberOfNeuralLayers + 1) + activationSlot) * myCache->numberOfWords;
+}
+
+//Stamp the mutated neurons of a neural layer with the current mutation epoch
+static void markMutatedNeurons(NeuralNetwork *myNeuralNetwork, int layerIndex, int mutantNeuronIndex)
+{
+	ActivationCache *myCache = myNeuralNetwork->activationCache;
+
+	if (myCache!=NULL)
+	{
+		uint64_t *layerEpochArray = myCache->neuronEpochArray + (size_t) layerIndex * myNeuralNetwork->maximumLayerWidth;
+
+		int numberOfNeurons = getNumberOfLayerNeurons(myNeuralNetwork, layerIndex);
+
+		if (mutantNeuronIndex==NEURAL_LAYER_ALL_NEURONS)
+		{
+			for (int i=0; i<numberOfNeurons; i++)
+				layerEpochArray[i] = myCache->mutationEpoch;
+		}
+		else
+			layerEpochArray[mutantNeuronIndex] = myCache->mutationEpoch;
+	}
+}
+
+//All the test cases are computed from scratch after the weights are replaced
+static void invalidateActivationCache(NeuralNetwork *myNeuralNetwork)
+{
+	ActivationCache *myCache = myNeuralNetwork->activationCache;
+
+	if (myCache!=NULL)
+		memset(myCache->testCaseEpochArray, 0, sizeof(uint64_t) * myCache->numberOfTestCases);
+}
+
+//Push a copy of numberOfWords words to the mutation log, if it is enabled
+static NeuralNetworkErrorCode logMutation(NeuralNetwork *myNeuralNetwork, const uint64_t *wordArray, size_t numberOfWords, uint64_t location)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	MutationLog *myLog = &(myNeuralNetwork->mutationLog);
+
+	if (myLog->isEnabled)
+	{
+		size_t requiredCapacity = myLog->numberOfWords + numberOfWords + MUTATION_LOG_HEADER_SIZE;
+
+		//The capacity is doubled, so the log stops growing after the first massive mutation
+		if (requiredCapacity > myLog->capacity)
+		{
+			size_t newCapacity = (myLog->capacity < MUTATION_LOG_MINIMUM_CAPACITY) ? MUTATION_LOG_MINIMUM_CAPACITY : myLog->capacity;
+
+			while (newCapacity < requiredCapacity)
+				newCapacity *= 2;
+
+			uint64_t *newWordArray = realloc(myLog->wordArray, sizeof(uint64_t) * newCapacity);
+
+			if (newWordArray==NULL)
+			{
+				returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+			}
+			else
+			{
+				myLog->wordArray = newWordArray;
+				myLog->capacity = newCapacity;
+			}
+		}
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		{
+			memcpy(myLog->wordArray + myLog->numberOfWords, wordArray, sizeof(uint64_t) * numberOfWords);
+			myLog->numberOfWords += numberOfWords;
+
+			myLog->wordArray[myLog->numberOfWords++] = numberOfWords;
+			myLog->wordArray[myLog->numberOfWords++] = location;
+		}
+	}
+
+	return returnValue;
+}
+
+//Save the weights of a neuron before it is mutated
+static NeuralNetworkErrorCode logNeuronMutation(NeuralNetwork *myNeuralNetwork, int layerIndex, int neuronIndex, Neuron *myNeuron)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	uint64_t *packedWeightArray = NULL;
+	int numberOfWords = 0;
+
+	if (myNeuralNetwork->mutationLog.isEnabled)
+	{
+		if (getNeuronPackedWeights(myNeuron, &packedWeightArray, &numberOfWords)!=NEURON_RETURN_VALUE_OK)
+			returnValue = NEURAL_NETWORK_NEURON_ERROR;
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			returnValue = logMutation(myNeuralNetwork, packedWeightArray, numberOfWords, ((uint64_t) layerIndex << 32) | (uint32_t) neuronIndex);
+	}
+
+	return returnValue;
+}
+
+/*Compute the output of a test case from the cached activations of its last computation. Only the
+ *neurons mutated since then are computed again, and a neural layer is only computed again if its
+ *input has changed. The cached activations are replaced with the new ones*/
+static NeuralNetworkErrorCode computeCachedBinaryOutput(NeuralNetwork *myNeuralNetwork, int testCaseIndex)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	ActivationCache *myCache = myNeuralNetwork->activationCache;
+	NeuralNetworkContext *myContext = &(myNeuralNetwork->context);
+
+	int numberOfNeuralLayers = myNeuralNetwork->numberOfHiddenLayers + 1;
+	uint64_t testCaseEpoch = myCache->testCaseEpochArray[testCaseIndex];
+	uint64_t *cachedInputArray = getCachedActivation(myCache, numberOfNeuralLayers, testCaseIndex, 0);
+	size_t inputSize = sizeof(uint64_t) * NEURON_DATA_NUMBER_OF_WORDS(myNeuralNetwork->numberOfInputs);
+	bool isCacheValid = false;
+	bool isInputChanged = false;
+	int layerIndex = 0;
+
+	NeuronErrorCode result = packNeuronDataArray(myContext->inputLayer, myNeuralNetwork->numberOfInputs, myContext->packedLayerInputArray);
+
+	if (result!=NEURON_RETURN_VALUE_OK)
+		returnValue = NEURAL_NETWORK_NEURON_ERROR;
+
+	//The cached activations are only valid for the same input
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		isCacheValid = (testCaseEpoch!=0) && (memcmp(cachedInputArray, myContext->packedLayerInputArray, inputSize)==0);
+
+		if (!isCacheValid)
+		{
+			memcpy(cachedInputArray, myContext->packedLayerInputArray, inputSize);
+			isInputChanged = true;
+		}
+	}
+
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (layerIndex<numberOfNeuralLayers))
+	{
+		NeuralLayer *myNeuralLayer = getNeuralLayerAt(myNeuralNetwork, layerIndex);
+		const uint64_t *layerInputArray = getCachedActivation(myCache, numberOfNeuralLayers, testCaseIndex, layerIndex);
+		uint64_t *layerOutputArray = getCachedActivation(myCache, numberOfNeuralLayers, testCaseIndex, layerIndex + 1);
+
+		int numberOfNeurons = getNumberOfLayerNeurons(myNeuralNetwork, layerIndex);
+		size_t outputSize = sizeof(uint64_t) * NEURON_DATA_NUMBER_OF_WORDS(numberOfNeurons);
+
+		if (isInputChanged)
+		{
+			//Every neuron depends on every input, so the whole neural layer is computed again
+			result = computeNeuralLayerBinaryOutput(myNeuralLayer, myNeuralNetwork->kernel, layerInputArray, myContext->packedLayerOutputArray);
+
+			//Without valid cached activations the next layers can not be skipped, even if this output matches the old one
+			isInputChanged = (!isCacheValid) || (memcmp(layerOutputArray, myContext->packedLayerOutputArray, outputSize)!=0);
+
+			if (isInputChanged)
+				memcpy(layerOutputArray, myContext->packedLayerOutputArray, outputSize);
+		}
+		else
+		{
+			const uint64_t *layerEpochArray = myCache->neuronEpochArray + (size_t) layerIndex * myNeuralNetwork->maximumLayerWidth;
+			int neuronIndex = 0;
+
+			//Compute again the neurons mutated after the test case was cached
+			while ((result==NEURON_RETURN_VALUE_OK) && (neuronIndex<numberOfNeurons))
+			{
+				if (layerEpochArray[neuronIndex] > testCaseEpoch)
+				{
+					Neuron *myNeuron = NULL;
+					NeuronData neuronOutput = NEURON_DATA_ZERO;
+
+					result = getNeuron(myNeuralLayer, neuronIndex, &myNeuron);
+
+					if (result==NEURON_RETURN_VALUE_OK)
+						result = computeNeuronBinaryOutput(myNeuron, myNeuralNetwork->kernel, layerInputArray, &neuronOutput);
+
+					if (result==NEURON_RETURN_VALUE_OK)
+					{
+						uint64_t neuronBit = (uint64_t) 1 << (neuronIndex % NEURON_DATA_BITS_PER_WORD);
+						uint64_t *outputWord = &(layerOutputArray[neuronIndex / NEURON_DATA_BITS_PER_WORD]);
+
+						//The next neural layer is only computed again if this neuron output has changed
+						if (((*outputWord & neuronBit)!=0) != (neuronOutput==NEURON_DATA_ONE))
+						{
+							*outputWord ^= neuronBit;
+							isInputChanged = true;
+						}
+					}
+				}
+
+				neuronIndex++;
+			}
+		}
+
+		if (result!=NEURON_RETURN_VALUE_OK)
+			returnValue = NEURAL_NETWORK_NEURON_ERROR;
+
+		layerIndex++;
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		result = unpackNeuronDataArray(getCachedActivation(myCache, numberOfNeuralLayers, testCaseIndex, numberOfNeuralLayers), myNeuralNetwork->numberOfOutputs, myContext->neuralNetworkOutputArray);
+
+		if (result!=NEURON_RETURN_VALUE_OK)
+			returnValue = NEURAL_NETWORK_NEURON_ERROR;
+	}
+
+	//A failed computation leaves the cached activations of the test case invalid
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		myCache->testCaseEpochArray[testCaseIndex] = myCache->mutationEpoch;
+	else
+		myCache->testCaseEpochArray[testCaseIndex] = 0;
+
+	return returnValue;
+}
+
+static NeuralNetworkErrorCode computeContextOutput(const NeuralNetwork *myNeuralNetwork, NeuralNetworkContext *myContext)
+{
+	NeuralNetworkErrorCode returnValue;
+
+	//Feed the neural layers with the selected engine, a single sample of the bit-sliced engine uses the binary engine
+	if (myNeuralNetwork->engine!=NEURAL_NETWORK_ENGINE_INTEGER)
+		returnValue = computeBinaryOutput(myNeuralNetwork, myContext);
+	else
+		returnValue = computeIntegerOutput(myNeuralNetwork, myContext);
+
+	return returnValue;
+}
+
+//Compute a tile of at most NEURAL_LAYER_BATCH_TILE_SIZE samples with the batch buffers of the context
+static NeuralNetworkErrorCode computeIntegerOutputTile(const NeuralNetwork *myNeuralNetwork, NeuralNetworkContext *myContext, const NeuronData *inputArray, int numberOfSamples, NeuronData *outputArray)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	int numberOfInputs = myNeuralNetwork->numberOfInputs;
+	int numberOfOutputs = myNeuralNetwork->numberOfOutputs;
+	int numberOfLayers = myNeuralNetwork->numberOfHiddenLayers + 1;
+	int layerIndex = 0;
+
+	//Every sample needs its own layer input and layer output arrays, as wide as the widest layer
+	NeuronData *layerInputArray = myContext->batchInputBuffer;
+	NeuronData *layerOutputArray = myContext->batchOutputBuffer;
+
+	memcpy(layerInputArray, inputArray, sizeof(NeuronData) * numberOfInputs * numberOfSamples);
+
+	//Feed the neural layers one by one with all the samples
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (layerIndex<numberOfLayers))
+	{
+		NeuralLayer *myNeuralLayer = getNeuralLayerAt(myNeuralNetwork, layerIndex);
+		int numberOfLayerInputs = getNumberOfLayerInputs(myNeuralNetwork, layerIndex);
+		int numberOfLayerNeurons = getNumberOfLayerNeurons(myNeuralNetwork, layerIndex);
+		int sampleIndex = 0;
+
+		while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (sampleIndex<numberOfSamples))
+		{
+			NeuronData *sampleInput = &layerInputArray[(size_t) sampleIndex * numberOfLayerInputs];
+			NeuronData *sampleOutput;
+
+			//The output layer writes directly in the output array
+			if (layerIndex<numberOfLayers-1)
+				sampleOutput = &layerOutputArray[(size_t) sampleIndex * numberOfLayerNeurons];
+			else
+				sampleOutput = &outputArray[(size_t) sampleIndex * numberOfOutputs];
+
+			if (computeNeuralLayerOutput(myNeuralLayer, sampleInput, sampleOutput)!=NEURON_RETURN_VALUE_OK)
+				returnValue = NEURAL_NETWORK_NEURON_ERROR;
+
+			sampleIndex++;
+		}
+
+		//The layer output is the input of the next layer
+		NeuronData *auxArray = layerInputArray;
+		layerInputArray = layerOutputArray;
+		layerOutputArray = auxArray;
+
+		layerIndex++;
+	}
+
+	return returnValue;
+}
+
+//Compute a tile of at most NEURAL_LAYER_BATCH_TILE_SIZE samples with the batch buffers of the context
+static NeuralNetworkErrorCode computeBinaryOutputTile(const NeuralNetwork *myNeuralNetwork, NeuralNetworkContext *myContext, const NeuronData *inputArray, int numberOfSamples, NeuronData *outputArray)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	int numberOfInputs = myNeuralNetwork->numberOfInputs;
+	int numberOfOutputs = myNeuralNetwork->numberOfOutputs;
+	int numberOfLayers = myNeuralNetwork->numberOfHiddenLayers + 1;
+	int numberOfWords = NEURON_DATA_NUMBER_OF_WORDS(numberOfInputs);
+	int layerIndex = 0;
+	int sampleIndex = 0;
+
+	//Every sample needs its own packed layer input and packed layer output arrays, as wide as the widest layer
+	uint64_t *packedInputArray = myContext->batchInputBuffer;
+	uint64_t *packedOutputArray = myContext->batchOutputBuffer;
+
+	//Pack the input samples
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (sampleIndex<numberOfSamples))
+	{
+		const NeuronData *sampleInput = &inputArray[(size_t) sampleIndex * numberOfInputs];
+
+		if (packNeuronDataArray(sampleInput, numberOfInputs, &packedInputArray[(size_t) sampleIndex * numberOfWords])!=NEURON_RETURN_VALUE_OK)
+			returnValue = NEURAL_NETWORK_NEURON_ERROR;
+
+		sampleIndex++;
+	}
+
+	//Feed the neural layers one by one with all the samples
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (layerIndex<numberOfLayers))
+	{
+		NeuralLayer *myNeuralLayer = getNeuralLayerAt(myNeuralNetwork, layerIndex);
+
+		if (computeNeuralLayerBinaryOutputBatch(myNeuralLayer, myNeuralNetwork->kernel, packedInputArray, numberOfSamples, packedOutputArray)!=NEURON_RETURN_VALUE_OK)
+			returnValue = NEURAL_NETWORK_NEURON_ERROR;
+
+		//The layer output is the input of the next layer
+		uint64_t *auxArray = packedInputArray;
+		packedInputArray = packedOutputArray;
+		packedOutputArray = auxArray;
+
+		layerIndex++;
+	}
+
+	sampleIndex = 0;
+
+	//Unpack the output samples
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (sampleIndex<numberOfSamples))
+	{
+		const uint64_t *sampleOutput = &packedInputArray[(size_t) sampleIndex * NEURON_DATA_NUMBER_OF_WORDS(numberOfOutputs)];
+
+		if (unpackNeuronDataArray(sampleOutput, numberOfOutputs, &outputArray[(size_t) sampleIndex * numberOfOutputs])!=NEURON_RETURN_VALUE_OK)
+			returnValue = NEURAL_NETWORK_NEURON_ERROR;
+
+		sampleIndex++;
+	}
+
+	return returnValue;
+}
+
+/*Feed the neural layers with 64 samples at a time, one sample per bit of each input slice. The hidden
+ *layers alternate between the two halves of sliceBuffer, each one as wide as the widest layer*/
+static NeuralNetworkErrorCode computeBitSlicedOutput(const NeuralNetwork *myNeuralNetwork, const uint64_t *inputSliceArray, uint64_t *outputSliceArray, uint64_t *sliceBuffer)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	int numberOfLayers = myNeuralNetwork->numberOfHiddenLayers + 1;
+	const uint64_t *layerInputArray = inputSliceArray;
+	int layerIndex = 0;
+
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (layerIndex<numberOfLayers))
+	{
+		uint64_t *layerOutputArray;
+
+		//The output layer writes directly in the output slices
+		if (layerIndex<numberOfLayers-1)
+			layerOutputArray = &sliceBuffer[(size_t) (layerIndex % 2) * myNeuralNetwork->maximumLayerWidth];
+		else
+			layerOutputArray = outputSliceArray;
+
+		if (computeNeuralLayerBitSlicedOutput(getNeuralLayerAt(myNeuralNetwork, layerIndex), layerInputArray, layerOutputArray)!=NEURON_RETURN_VALUE_OK)
+			returnValue = NEURAL_NETWORK_NEURON_ERROR;
+
+		//The layer output is the input of the next layer
+		layerInputArray = layerOutputArray;
+
+		layerIndex++;
+	}
+
+	return returnValue;
+}
+
+//The input and output slices of each group of 64 samples are stored in the batch buffers of the context
+static NeuralNetworkErrorCode computeBitSlicedOutputBatch(const NeuralNetwork *myNeuralNetwork, NeuralNetworkContext *myContext, const NeuronData *inputArray, int numberOfSamples, NeuronData *outputArray)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	int numberOfInputs = myNeuralNetwork->numberOfInputs;
+	int numberOfOutputs = myNeuralNetwork->numberOfOutputs;
+
+	uint64_t *inputSliceArray = myContext->batchInputBuffer;
+	uint64_t *outputSliceArray = &inputSliceArray[numberOfInputs];
+
+	for (int firstSample=0; (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (firstSample < numberOfSamples); firstSample += NEURON_DATA_BITS_PER_WORD)
+	{
+		int groupSize = numberOfSamples - firstSample;
+
+		if (groupSize > NEURON_DATA_BITS_PER_WORD)
+			groupSize = NEURON_DATA_BITS_PER_WORD;
+
+		//Transpose the samples of the group: bit i of each input slice belongs to sample firstSample + i
+		memset(inputSliceArray, 0, sizeof(uint64_t) * numberOfInputs);
+
+		for (int i=0; i < groupSize; i++)
+		{
+			const NeuronData *sampleInput = &inputArray[(size_t) (firstSample + i) * numberOfInputs];
+
+			for (int j=0; j < numberOfInputs; j++)
+				inputSliceArray[j] |= (uint64_t) (sampleInput[j]!=NEURON_DATA_ZERO) << i;
+		}
+
+		returnValue = computeBitSlicedOutput(myNeuralNetwork, inputSliceArray, outputSliceArray, myContext->batchOutputBuffer);
+
+		//The unused bits of the last group are discarded
+		for (int i=0; (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (i < groupSize); i++)
+		{
+			NeuronData *sampleOutput = &outputArray[(size_t) (firstSample + i) * numberOfOutputs];
+
+			for (int j=0; j < numberOfOutputs; j++)
+				sampleOutput[j] = ((outputSliceArray[j] >> i) & 1) ? NEURON_DATA_ONE : NEURON_DATA_ZERO;
+		}
+	}
+
+	return returnValue;
+}
+
+/*Feed a batch with the selected engine. The integer and binary engines compute the samples in tiles
+ *that fit in the batch buffers of the context, so a batch of any size needs no allocation*/
+static NeuralNetworkErrorCode computeContextOutputBatch(const NeuralNetwork *myNeuralNetwork, NeuralNetworkContext *myContext, const NeuronData *inputArray, int numberOfSamples, NeuronData *outputArray)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if (myNeuralNetwork->engine==NEURAL_NETWORK_ENGINE_BIT_SLICED)
+	{
+		returnValue = computeBitSlicedOutputBatch(myNeuralNetwork, myContext, inputArray, numberOfSamples, outputArray);
+	}
+	else
+	{
+		for (int firstSample=0; (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (firstSample < numberOfSamples); firstSample += NEURAL_LAYER_BATCH_TILE_SIZE)
+		{
+			const NeuronData *tileInputArray = &inputArray[(size_t) firstSample * myNeuralNetwork->numberOfInputs];
+			NeuronData *tileOutputArray = &outputArray[(size_t) firstSample * myNeuralNetwork->numberOfOutputs];
+			int tileSize = numberOfSamples - firstSample;
+
+			if (tileSize > NEURAL_LAYER_BATCH_TILE_SIZE)
+				tileSize = NEURAL_LAYER_BATCH_TILE_SIZE;
+
+			if (myNeuralNetwork->engine==NEURAL_NETWORK_ENGINE_BINARY)
+				returnValue = computeBinaryOutputTile(myNeuralNetwork, myContext, tileInputArray, tileSize, tileOutputArray);
+			else
+				returnValue = computeIntegerOutputTile(myNeuralNetwork, myContext, tileInputArray, tileSize, tileOutputArray);
+		}
+	}
+
+	return returnValue;
+}
+
+//Set random weights in all the neural layers with the random generator of the neural network
+static NeuralNetworkErrorCode initializeNeuralLayers(NeuralNetwork *myNeuralNetwork)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	int i=0;
+
+	myNeuralNetwork->isWeightHashValid = false;
+
+	//Initialize hidden layers and output layer, each one fed by the previous one
+	while ((i<=myNeuralNetwork->numberOfHiddenLayers) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK))
+	{
+		if (initializeNeuralLayer(getNeuralLayerAt(myNeuralNetwork, i), getNumberOfLayerInputs(myNeuralNetwork, i), getNumberOfLayerNeurons(myNeuralNetwork, i),
+								  myNeuralNetwork->connectivity==NEURAL_NETWORK_CONNECTIVITY_SPARSE, &(myNeuralNetwork->generator))!=NEURON_RETURN_VALUE_OK)
+			returnValue = NEURAL_NETWORK_NEURON_ERROR;
+
+		i++;
+	}
+
+	return returnValue;
+}
+
+/*Compute the size of the layer region of a topology and, if layerOffsetArray is not NULL, the offset
+ *of each neural layer. Every neural layer starts at a cache line and is fed by the previous one*/
+static NeuralNetworkErrorCode getLayerRegionLayout(int numberOfInputs, int numberOfHiddenLayers, const int *hiddenLayerWidthArray, int numberOfOutputs,
+												   NeuralNetworkConnectivity connectivity, size_t *layerOffsetArray, size_t *layerRegionSize)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	int numberOfLayerInputs = numberOfInputs;
+	size_t regionSize = 0;
+	int layerIndex = 0;
+
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (layerIndex<=numberOfHiddenLayers))
+	{
+		int numberOfLayerNeurons = numberOfOutputs;
+		size_t layerSize = 0;
+
+		if (layerIndex<numberOfHiddenLayers)
+			numberOfLayerNeurons = getTopologyHiddenLayerWidth(hiddenLayerWidthArray, layerIndex, numberOfInputs);
+
+		if (getNeuralLayerSize(numberOfLayerInputs, numberOfLayerNeurons, connectivity==NEURAL_NETWORK_CONNECTIVITY_SPARSE, &layerSize)!=NEURON_RETURN_VALUE_OK)
+			returnValue = NEURAL_NETWORK_NEURON_ERROR;
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		{
+			if (layerOffsetArray!=NULL)
+				layerOffsetArray[layerIndex] = regionSize;
+
+			regionSize += alignArenaSize(layerSize);
+		}
+
+		numberOfLayerInputs = numberOfLayerNeurons;
+		layerIndex++;
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		*layerRegionSize = regionSize;
+
+	return returnValue;
+}
+
+/*Create the arena of a neural network. The layer region is stored inside the arena, or it is the
+ *given external layer region, which must have the size of the layer region of this topology*/
+static NeuralNetworkErrorCode createArena(NeuralNetwork **myNeuralNetwork, int numberOfInputs, int numberOfHiddenLayers, const int *hiddenLayerWidthArray, int numberOfOutputs,
+										  NeuralNetworkConnectivity connectivity, void *externalLayerRegion, size_t externalLayerRegionSize)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	int maximumLayerWidth = 0;
+	NeuronErrorCode result;
+	int i=0;
+
+	size_t layerRegionSize = 0;
+	size_t arenaSize = 0;
+
+	NeuralNetwork *newNeuralNetwork = NULL;
+
+	if (myNeuralNetwork==NULL)
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if ((numberOfInputs<NEURAL_NETWORK_MINIMUM_NUMBER_OF_INPUTS) || (numberOfInputs>INT_MAX))
+		returnValue = NEURAL_NETWORK_NUMBER_OF_INPUTS_ERROR;
+
+	if ((numberOfHiddenLayers<NEURAL_NETWORK_MINIMUM_NUMBER_OF_HIDDEN_LAYERS) || (numberOfHiddenLayers>INT_MAX))
+		returnValue = NEURAL_NETWORK_NUMBER_OF_HIDDEN_LAYERS_ERROR;
+
+	if ((numberOfOutputs<NEURAL_NETWORK_MINIMUM_NUMBER_OF_NEURONS_PER_LAYER) || (numberOfOutputs>INT_MAX))
+		returnValue = NEURAL_NETWORK_NUMBER_OF_NEURONS_PER_LAYER_ERROR;
+
+	//The enum is unsigned so a single comparison checks the range
+	if (connectivity>NEURAL_NETWORK_CONNECTIVITY_SPARSE)
+		returnValue = NEURAL_NETWORK_CONNECTIVITY_ERROR;
+
+	//The scratch buffers must hold the input layer, every hidden layer and the output layer
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		maximumLayerWidth = (numberOfInputs > numberOfOutputs) ? numberOfInputs : numberOfOutputs;
+
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (i<numberOfHiddenLayers))
+	{
+		int hiddenLayerWidth = getTopologyHiddenLayerWidth(hiddenLayerWidthArray, i, numberOfInputs);
+
+		if (hiddenLayerWidth<NEURAL_NETWORK_MINIMUM_HIDDEN_LAYER_WIDTH)
+			returnValue = NEURAL_NETWORK_NUMBER_OF_NEURONS_PER_LAYER_ERROR;
+		else if (hiddenLayerWidth>maximumLayerWidth)
+			maximumLayerWidth = hiddenLayerWidth;
+
+		i++;
+	}
+
+	//Compute the size of the neural layers
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getLayerRegionLayout(numberOfInputs, numberOfHiddenLayers, hiddenLayerWidthArray, numberOfOutputs, connectivity, NULL, &layerRegionSize);
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (externalLayerRegion!=NULL) && (externalLayerRegionSize!=layerRegionSize))
+		returnValue = NEURAL_NETWORK_LAYER_REGION_ERROR;
+
+	//Create the arena
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		arenaSize = alignArenaSize(sizeof(NeuralNetwork)) +
+					alignArenaSize(sizeof(int) * numberOfHiddenLayers) +
+					alignArenaSize(sizeof(size_t) * (numberOfHiddenLayers + 1)) +
+					((externalLayerRegion==NULL) ? layerRegionSize : 0) +
+					getContextBuffersSize(numberOfInputs, maximumLayerWidth, numberOfOutputs);
+
+		newNeuralNetwork = aligned_alloc(NEURAL_NETWORK_ARENA_ALIGNMENT, arenaSize);
+
+		if (newNeuralNetwork==NULL)
+			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+	}
+
+	//Place the layer region and the arrays inside the arena
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		unsigned char *arenaCursor = (unsigned char *) newNeuralNetwork;
+
+		memset(arenaCursor, 0, arenaSize);
+		arenaCursor += alignArenaSize(sizeof(NeuralNetwork));
+
+		newNeuralNetwork->numberOfInputs = numberOfInputs;
+		newNeuralNetwork->numberOfHiddenLayers = numberOfHiddenLayers;
+		newNeuralNetwork->numberOfOutputs = numberOfOutputs;
+		newNeuralNetwork->maximumLayerWidth = maximumLayerWidth;
+		newNeuralNetwork->connectivity = connectivity;
+
+		newNeuralNetwork->hiddenLayerWidthArray = (int *) arenaCursor;
+		arenaCursor += alignArenaSize(sizeof(int) * numberOfHiddenLayers);
+
+		for (i=0; i<numberOfHiddenLayers; i++)
+			newNeuralNetwork->hiddenLayerWidthArray[i] = getTopologyHiddenLayerWidth(hiddenLayerWidthArray, i, numberOfInputs);
+
+		newNeuralNetwork->layerOffsetArray = (size_t *) arenaCursor;
+		arenaCursor += alignArenaSize(sizeof(size_t) * (numberOfHiddenLayers + 1));
+
+		if (externalLayerRegion==NULL)
+		{
+			newNeuralNetwork->layerRegion = arenaCursor;
+			arenaCursor += layerRegionSize;
+		}
+		else
+			newNeuralNetwork->layerRegion = externalLayerRegion;
+
+		newNeuralNetwork->layerRegionSize = layerRegionSize;
+
+		//Create the input layer, the auxiliary arrays and the output array
+		initializeContext(&(newNeuralNetwork->context), arenaCursor, numberOfInputs, maximumLayerWidth, numberOfOutputs);
+
+		newNeuralNetwork->engine = NEURAL_NETWORK_ENGINE_BINARY;
+
+		//Every neural network gets a different seed, setNeuralNetworkRandomSeed makes it reproducible
+		seedRandomGenerator(&(newNeuralNetwork->generator), getRandomSeed());
+
+		//Place the hidden layers and the output layer in the layer region
+		returnValue = getLayerRegionLayout(numberOfInputs, numberOfHiddenLayers, hiddenLayerWidthArray, numberOfOutputs, connectivity, newNeuralNetwork->layerOffsetArray, &layerRegionSize);
+	}
+
+	//Select the fastest popcount kernel supported by the CPU
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		result = getBestNeuronKernel(&(newNeuralNetwork->kernel));
+
+		if (result!=NEURON_RETURN_VALUE_OK)
+			returnValue = NEURAL_NETWORK_NEURON_ERROR;
+	}
+
+	//The caller's pointer is only set by a successfully created arena
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		*myNeuralNetwork = newNeuralNetwork;
+	else
+		free(newNeuralNetwork);
+
+	return returnValue;
+}
+
+//Every hidden layer has as many neurons as the input layer
+NeuralNetworkErrorCode createNeuralNetwork(NeuralNetwork **myNeuralNetwork, int numberOfInputs, int numberOfHiddenLayers, int numberOfOutputs)
+{
+	return createNeuralNetworkWithTopology(myNeuralNetwork, numberOfInputs, numberOfHiddenLayers, NULL, numberOfOutputs, NEURAL_NETWORK_CONNECTIVITY_DENSE);
+}
+
+/*Create a neural network whose hidden layer i has hiddenLayerWidthArray[i] neurons, narrower or wider
+ *than the input layer. The array holds numberOfHiddenLayers widths and it is copied, a NULL array
+ *makes every hidden layer as wide as the input layer. The neurons of a sparse neural network start
+ *with all their inputs connected*/
+NeuralNetworkErrorCode createNeuralNetworkWithTopology(NeuralNetwork **myNeuralNetwork, int numberOfInputs, int numberOfHiddenLayers, const int *hiddenLayerWidthArray, int numberOfOutputs,
+													   NeuralNetworkConnectivity connectivity)
+{
+	NeuralNetworkErrorCode returnValue = createArena(myNeuralNetwork, numberOfInputs, numberOfHiddenLayers, hiddenLayerWidthArray, numberOfOutputs, connectivity, NULL, 0);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		returnValue = initializeNeuralLayers(*myNeuralNetwork);
+
+		if (returnValue!=NEURAL_NETWORK_RETURN_VALUE_OK)
+			destroyNeuralNetwork(myNeuralNetwork);
+	}
+
+	return returnValue;
+}
+
+/*Create a neural network whose neural layers are stored in a layer region owned by the caller, such
+ *as a memory-mapped model file. The layer region must be an image of the layer region of a neural
+ *network with the same topology (see getNeuralNetworkLayerRegion) aligned to 64 bytes. It is used in
+ *place without any copy, and it is given to releaseFunction, if it is not NULL, when the neural
+ *network is destroyed*/
+NeuralNetworkErrorCode createNeuralNetworkFromLayerRegion(NeuralNetwork **myNeuralNetwork, int numberOfInputs, int numberOfHiddenLayers, const int *hiddenLayerWidthArray, int numberOfOutputs,
+														  NeuralNetworkConnectivity connectivity, void *layerRegion, size_t layerRegionSize, NeuralNetworkReleaseFunction releaseFunction)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	NeuralNetwork *newNeuralNetwork = NULL;
+
+	int layerIndex = 0;
+
+	if ((myNeuralNetwork==NULL) || (layerRegion==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else if (((uintptr_t) layerRegion % NEURAL_NETWORK_ARENA_ALIGNMENT)!=0)
+		returnValue = NEURAL_NETWORK_LAYER_REGION_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = createArena(&newNeuralNetwork, numberOfInputs, numberOfHiddenLayers, hiddenLayerWidthArray, numberOfOutputs, connectivity, layerRegion, layerRegionSize);
+
+	//The layer headers must match the topology, the weights are not checked
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (layerIndex<=numberOfHiddenLayers))
+	{
+		NeuronErrorCode result = checkNeuralLayer(getNeuralLayerAt(newNeuralNetwork, layerIndex), getNumberOfLayerInputs(newNeuralNetwork, layerIndex), getNumberOfLayerNeurons(newNeuralNetwork, layerIndex),
+												  connectivity==NEURAL_NETWORK_CONNECTIVITY_SPARSE);
+
+		if (result!=NEURON_RETURN_VALUE_OK)
+			returnValue = NEURAL_NETWORK_LAYER_REGION_ERROR;
+
+		layerIndex++;
+	}
+
+	//The layer region is only released by a successfully created neural network, the caller's pointer is untouched on error
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		newNeuralNetwork->releaseFunction = releaseFunction;
+
+		*myNeuralNetwork = newNeuralNetwork;
+	}
+	else if (newNeuralNetwork!=NULL)
+		destroyNeuralNetwork(&newNeuralNetwork);
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode destroyNeuralNetwork(NeuralNetwork **myNeuralNetwork)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myNeuralNetwork==NULL) || (*myNeuralNetwork==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	//The whole neural network is freed at once, except the activation cache, the mutation log and an external layer region
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		if ((*myNeuralNetwork)->releaseFunction!=NULL)
+			(*myNeuralNetwork)->releaseFunction((*myNeuralNetwork)->layerRegion, (*myNeuralNetwork)->layerRegionSize);
+
+		free((*myNeuralNetwork)->activationCache);
+		free((*myNeuralNetwork)->mutationLog.wordArray);
+		free(*myNeuralNetwork);
+		*myNeuralNetwork = NULL;
+	}
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode getInputLayer(NeuralNetwork *myNeuralNetwork, NeuronData **myInputLayer, int *numberOfInputs)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myNeuralNetwork==NULL) || (myInputLayer==NULL) || (numberOfInputs==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		*myInputLayer = myNeuralNetwork->context.inputLayer;
+		*numberOfInputs = myNeuralNetwork->numberOfInputs;
+	}
+
+	return returnValue;
+}
+
+/*The layer region holds all the neural layers in a position-independent layout, so it can be saved
+ *as it is and used again with createNeuralNetworkFromLayerRegion*/
+NeuralNetworkErrorCode getNeuralNetworkLayerRegion(const NeuralNetwork *myNeuralNetwork, const void **layerRegion, size_t *layerRegionSize)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myNeuralNetwork==NULL) || (layerRegion==NULL) || (layerRegionSize==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		*layerRegion = myNeuralNetwork->layerRegion;
+		*layerRegionSize = myNeuralNetwork->layerRegionSize;
+	}
+
+	return returnValue;
+}
+
+/*Replace the weights with a copy of a layer region taken from a neural network with the same topology,
+ *such as a training checkpoint. If the layer headers do not match the topology the neural network
+ *gets random weights and an error is returned*/
+NeuralNetworkErrorCode setNeuralNetworkLayerRegion(NeuralNetwork *myNeuralNetwork, const void *layerRegion, size_t layerRegionSize)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	int layerIndex = 0;
+
+	if ((myNeuralNetwork==NULL) || (layerRegion==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else if (layerRegionSize!=myNeuralNetwork->layerRegionSize)
+		returnValue = NEURAL_NETWORK_LAYER_REGION_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		memcpy(myNeuralNetwork->layerRegion, layerRegion, layerRegionSize);
+
+		invalidateActivationCache(myNeuralNetwork);
+		myNeuralNetwork->mutationLog.numberOfWords = 0;
+		myNeuralNetwork->isWeightHashValid = false;
+	}
+
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (layerIndex<=myNeuralNetwork->numberOfHiddenLayers))
+	{
+		NeuronErrorCode result = checkNeuralLayer(getNeuralLayerAt(myNeuralNetwork, layerIndex), getNumberOfLayerInputs(myNeuralNetwork, layerIndex),
+												  getNumberOfLayerNeurons(myNeuralNetwork, layerIndex), myNeuralNetwork->connectivity==NEURAL_NETWORK_CONNECTIVITY_SPARSE);
+
+		if (result!=NEURON_RETURN_VALUE_OK)
+			returnValue = NEURAL_NETWORK_LAYER_REGION_ERROR;
+
+		layerIndex++;
+	}
+
+	if (returnValue==NEURAL_NETWORK_LAYER_REGION_ERROR)
+		initializeNeuralLayers(myNeuralNetwork);
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode getNumberOfHiddenLayers(NeuralNetwork *myNeuralNetwork, int *numberOfHiddenLayers)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myNeuralNetwork==NULL) || (numberOfHiddenLayers==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		*numberOfHiddenLayers = myNeuralNetwork->numberOfHiddenLayers;
+
+	return returnValue;
+}
+
+//The hidden layer i has hiddenLayerWidthArray[i] neurons
+NeuralNetworkErrorCode getHiddenLayerWidthArray(const NeuralNetwork *myNeuralNetwork, const int **hiddenLayerWidthArray, int *numberOfHiddenLayers)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myNeuralNetwork==NULL) || (hiddenLayerWidthArray==NULL) || (numberOfHiddenLayers==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		*hiddenLayerWidthArray = myNeuralNetwork->hiddenLayerWidthArray;
+		*numberOfHiddenLayers = myNeuralNetwork->numberOfHiddenLayers;
+	}
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode getNeuralNetworkConnectivity(const NeuralNetwork *myNeuralNetwork, NeuralNetworkConnectivity *connectivity)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myNeuralNetwork==NULL) || (connectivity==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		*connectivity = myNeuralNetwork->connectivity;
+
+	return returnValue;
+}
+
+/*Count the connected weights of all the neurons, every weight of a dense neural network is connected.
+ *A fitness function can subtract a fraction of this number to favour smaller neural networks*/
+NeuralNetworkErrorCode getNeuralNetworkNumberOfConnections(const NeuralNetwork *myNeuralNetwork, long long *numberOfConnections)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	long long connectionCount = 0;
+	int layerIndex = 0;
+
+	if ((myNeuralNetwork==NULL) || (numberOfConnections==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (layerIndex<=myNeuralNetwork->numberOfHiddenLayers))
+	{
+		NeuralLayer *myNeuralLayer = getNeuralLayerAt(myNeuralNetwork, layerIndex);
+		int numberOfNeurons = getNumberOfLayerNeurons(myNeuralNetwork, layerIndex);
+
+		for (int i=0; (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (i<numberOfNeurons); i++)
+		{
+			Neuron *myNeuron = NULL;
+			int numberOfNeuronConnections = 0;
+
+			NeuronErrorCode result = getNeuron(myNeuralLayer, i, &myNeuron);
+
+			if (result==NEURON_RETURN_VALUE_OK)
+				result = getNumberOfConnections(myNeuron, &numberOfNeuronConnections);
+
+			if (result==NEURON_RETURN_VALUE_OK)
+				connectionCount += numberOfNeuronConnections;
+			else
+				returnValue = NEURAL_NETWORK_NEURON_ERROR;
+		}
+
+		layerIndex++;
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		*numberOfConnections = connectionCount;
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode getHiddenLayer(NeuralNetwork *myNeuralNetwork, int hiddenLayerNumber, NeuralLayer **myHiddenLayer)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myNeuralNetwork==NULL) || (myHiddenLayer==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+    else if ((hiddenLayerNumber<0) || (hiddenLayerNumber>=myNeuralNetwork->numberOfHiddenLayers))
+		returnValue = NEURAL_NETWORK_NUMBER_OF_HIDDEN_LAYERS_ERROR;
+
+	//The caller can change the weights of the neural layer, so the weight hash and the cached activations are dropped
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		*myHiddenLayer = getNeuralLayerAt(myNeuralNetwork, hiddenLayerNumber);
+		myNeuralNetwork->isWeightHashValid = false;
+
+		invalidateActivationCache(myNeuralNetwork);
+	}
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode getOutputLayer(NeuralNetwork *myNeuralNetwork, NeuralLayer **myOutputLayer, int *numberOfOutputs)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myNeuralNetwork==NULL) || (myOutputLayer==NULL) || (numberOfOutputs==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	//The caller can change the weights of the neural layer, so the weight hash and the cached activations are dropped
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		*myOutputLayer = getNeuralLayerAt(myNeuralNetwork, myNeuralNetwork->numberOfHiddenLayers);
+		*numberOfOutputs = myNeuralNetwork->numberOfOutputs;
+		myNeuralNetwork->isWeightHashValid = false;
+
+		invalidateActivationCache(myNeuralNetwork);
+	}
+
+	return returnValue;
+}
+
+//Unlike getOutputLayer, the neural network is left untouched
+NeuralNetworkErrorCode getNeuralNetworkNumberOfOutputs(const NeuralNetwork *myNeuralNetwork, int *numberOfOutputs)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myNeuralNetwork==NULL) || (numberOfOutputs==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		*numberOfOutputs = myNeuralNetwork->numberOfOutputs;
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode setNeuralNetworkInput(NeuralNetwork *myNeuralNetwork, int inputNumber, NeuronData input)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if (myNeuralNetwork==NULL)
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+    else if ((inputNumber<0) || (inputNumber>=myNeuralNetwork->numberOfInputs))
+		returnValue = NEURAL_NETWORK_NUMBER_OF_INPUTS_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		myNeuralNetwork->context.inputLayer[inputNumber] = input;
+
+	return returnValue;
+}
+
+//Set all the inputs at once from 64-bit words with one bit per input, the bits after the last input are ignored
+NeuralNetworkErrorCode setNeuralNetworkPackedInput(NeuralNetwork *myNeuralNetwork, const uint64_t *packedInputArray)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myNeuralNetwork==NULL) || (packedInputArray==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else if (unpackNeuronDataArray(packedInputArray, myNeuralNetwork->numberOfInputs, myNeuralNetwork->context.inputLayer)!=NEURON_RETURN_VALUE_OK)
+		returnValue = NEURAL_NETWORK_NEURON_ERROR;
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode computeNeuralNetworkOutput(NeuralNetwork *myNeuralNetwork, NeuronData **outputArray, int *numberOfOutputs)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myNeuralNetwork==NULL) || (outputArray==NULL) || (numberOfOutputs==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = computeContextOutput(myNeuralNetwork, &(myNeuralNetwork->context));
+    
+	//Get neural network output
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		*outputArray = myNeuralNetwork->context.neuralNetworkOutputArray;
+		*numberOfOutputs = myNeuralNetwork->numberOfOutputs;
+	}
+
+	return returnValue;
+}
+
+/*Compute the output of a batch of samples layer by layer with the buffers of the neural network. The
+ *input array holds numberOfSamples rows of numberOfInputs values and the output array receives
+ *numberOfSamples rows of numberOfOutputs values*/
+NeuralNetworkErrorCode computeNeuralNetworkOutputBatch(NeuralNetwork *myNeuralNetwork, const NeuronData *inputArray, int numberOfSamples, NeuronData *outputArray)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myNeuralNetwork==NULL) || (inputArray==NULL) || (outputArray==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else if (numberOfSamples<1)
+		returnValue = NEURAL_NETWORK_NUMBER_OF_SAMPLES_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = computeContextOutputBatch(myNeuralNetwork, &(myNeuralNetwork->context), inputArray, numberOfSamples, outputArray);
+
+	return returnValue;
+}
+
+/*Compute the outputs of 64 samples in one pass with the bit-sliced engine, whatever the selected
+ *engine is. Word i of inputSliceArray holds input i of every sample, one sample per bit, and word i
+ *of outputSliceArray receives output i of every sample in the same bit. The hidden layers use the
+ *buffers of the neural network*/
+NeuralNetworkErrorCode computeNeuralNetworkBitSlicedOutput(NeuralNetwork *myNeuralNetwork, const uint64_t *inputSliceArray, uint64_t *outputSliceArray)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myNeuralNetwork==NULL) || (inputSliceArray==NULL) || (outputSliceArray==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = computeBitSlicedOutput(myNeuralNetwork, inputSliceArray, outputSliceArray, myNeuralNetwork->context.batchOutputBuffer);
+
+	return returnValue;
+}
+
+/*Keep the activations of numberOfTestCases test cases between mutations (0 disables the cache). The
+ *cache is emptied, so it must also be set again after changing the weights with setNeuronWeight*/
+NeuralNetworkErrorCode setNeuralNetworkActivationCache(NeuralNetwork *myNeuralNetwork, int numberOfTestCases)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	ActivationCache *myCache = NULL;
+
+	if (myNeuralNetwork==NULL)
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else if (numberOfTestCases<0)
+		returnValue = NEURAL_NETWORK_TEST_CASE_ERROR;
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (numberOfTestCases>0))
+	{
+		int numberOfNeuralLayers = myNeuralNetwork->numberOfHiddenLayers + 1;
+		int numberOfWords = NEURON_DATA_NUMBER_OF_WORDS(myNeuralNetwork->maximumLayerWidth);
+
+		//Every neural layer gets the slots of the widest layer
+		size_t neuronEpochArraySize = sizeof(uint64_t) * numberOfNeuralLayers * myNeuralNetwork->maximumLayerWidth;
+		size_t testCaseEpochArraySize = sizeof(uint64_t) * numberOfTestCases;
+		size_t activationArraySize = sizeof(uint64_t) * numberOfWords * (numberOfNeuralLayers + 1) * (size_t) numberOfTestCases;
+		size_t cacheSize = neuronEpochArraySize + testCaseEpochArraySize + activationArraySize;
+
+		//The arrays follow the cache header, so a clone copies all of them at once
+		myCache = aligned_alloc(NEURAL_NETWORK_ARENA_ALIGNMENT, alignArenaSize(alignArenaSize(sizeof(ActivationCache)) + cacheSize));
+
+		if (myCache==NULL)
+		{
+			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+		}
+		else
+		{
+			unsigned char *cacheCursor = (unsigned char *) myCache + alignArenaSize(sizeof(ActivationCache));
+
+			memset(cacheCursor, 0, cacheSize);
+
+			myCache->numberOfTestCases = numberOfTestCases;
+			myCache->numberOfWords = numberOfWords;
+			myCache->size = cacheSize;
+
+			//The test cases are empty until the first computation at epoch 1
+			myCache->mutationEpoch = 1;
+
+			myCache->neuronEpochArray = (uint64_t *) cacheCursor;
+			cacheCursor += neuronEpochArraySize;
+
+			myCache->testCaseEpochArray = (uint64_t *) cacheCursor;
+			cacheCursor += testCaseEpochArraySize;
+
+			myCache->activationArray = (uint64_t *) cacheCursor;
+		}
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		free(myNeuralNetwork->activationCache);
+		myNeuralNetwork->activationCache = myCache;
+	}
+
+	return returnValue;
+}
+
+/*Compute the output of the input layer as the test case testCaseIndex. With the activation cache
+ *enabled only the neurons affected by the mutations since the last computation of the test case are
+ *computed, always with the binary engine. Without cache the output is computed from scratch*/
+NeuralNetworkErrorCode computeNeuralNetworkCachedOutput(NeuralNetwork *myNeuralNetwork, int testCaseIndex, NeuronData **outputArray, int *numberOfOutputs)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myNeuralNetwork==NULL) || (outputArray==NULL) || (numberOfOutputs==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else if (testCaseIndex<0)
+		returnValue = NEURAL_NETWORK_TEST_CASE_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		if (myNeuralNetwork->activationCache==NULL)
+			returnValue = computeContextOutput(myNeuralNetwork, &(myNeuralNetwork->context));
+		else if (testCaseIndex>=myNeuralNetwork->activationCache->numberOfTestCases)
+			returnValue = NEURAL_NETWORK_TEST_CASE_ERROR;
+		else
+			returnValue = computeCachedBinaryOutput(myNeuralNetwork, testCaseIndex);
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		*outputArray = myNeuralNetwork->context.neuralNetworkOutputArray;
+		*numberOfOutputs = myNeuralNetwork->numberOfOutputs;
+	}
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode getNeuralNetworkOutput(NeuralNetwork *myNeuralNetwork, NeuronData **outputArray, int *numberOfOutputs)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myNeuralNetwork==NULL) || (outputArray==NULL) || (numberOfOutputs==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		*outputArray = myNeuralNetwork->context.neuralNetworkOutputArray;
+		*numberOfOutputs = myNeuralNetwork->numberOfOutputs;
+	}
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode createNeuralNetworkContext(const NeuralNetwork *myNeuralNetwork, NeuralNetworkContext **myContext)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	size_t contextSize = 0;
+
+	if ((myNeuralNetwork==NULL) || (myContext==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	//The context and its buffers are stored in a single cache-line-aligned block
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		contextSize = alignArenaSize(sizeof(NeuralNetworkContext)) + getContextBuffersSize(myNeuralNetwork->numberOfInputs, myNeuralNetwork->maximumLayerWidth, myNeuralNetwork->numberOfOutputs);
+
+		*myContext = aligned_alloc(NEURAL_NETWORK_ARENA_ALIGNMENT, contextSize);
+
+		if (*myContext==NULL)
+			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		unsigned char *contextCursor = (unsigned char *) *myContext;
+
+		memset(contextCursor, 0, contextSize);
+		contextCursor += alignArenaSize(sizeof(NeuralNetworkContext));
+
+		initializeContext(*myContext, contextCursor, myNeuralNetwork->numberOfInputs, myNeuralNetwork->maximumLayerWidth, myNeuralNetwork->numberOfOutputs);
+	}
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode destroyNeuralNetworkContext(NeuralNetworkContext **myContext)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myContext==NULL) || (*myContext==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		free(*myContext);
+		*myContext = NULL;
+	}
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode setNeuralNetworkContextInput(NeuralNetworkContext *myContext, int inputNumber, NeuronData input)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if (myContext==NULL)
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else if ((inputNumber<0) || (inputNumber>=myContext->numberOfInputs))
+		returnValue = NEURAL_NETWORK_NUMBER_OF_INPUTS_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		myContext->inputLayer[inputNumber] = input;
+
+	return returnValue;
+}
+
+/*Compute the output of the neural network using the buffers of the context. The neural network is
+ *not modified, so several threads can share it as long as each thread uses its own context*/
+NeuralNetworkErrorCode computeNeuralNetworkContextOutput(const NeuralNetwork *myNeuralNetwork, NeuralNetworkContext *myContext, NeuronData **outputArray, int *numberOfOutputs)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myNeuralNetwork==NULL) || (myContext==NULL) || (outputArray==NULL) || (numberOfOutputs==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else if ((myContext->numberOfInputs!=myNeuralNetwork->numberOfInputs) || (myContext->numberOfOutputs!=myNeuralNetwork->numberOfOutputs) ||
+			 (myContext->maximumLayerWidth<myNeuralNetwork->maximumLayerWidth))
+		returnValue = NEURAL_NETWORK_CONTEXT_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = computeContextOutput(myNeuralNetwork, myContext);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		*outputArray = myContext->neuralNetworkOutputArray;
+		*numberOfOutputs = myContext->numberOfOutputs;
+	}
+
+	return returnValue;
+}
+
+//Compute the output of a batch of samples with the buffers of the context, see computeNeuralNetworkOutputBatch
+NeuralNetworkErrorCode computeNeuralNetworkContextOutputBatch(const NeuralNetwork *myNeuralNetwork, NeuralNetworkContext *myContext, const NeuronData *inputArray, int numberOfSamples, NeuronData *outputArray)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myNeuralNetwork==NULL) || (myContext==NULL) || (inputArray==NULL) || (outputArray==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else if ((myContext->numberOfInputs!=myNeuralNetwork->numberOfInputs) || (myContext->numberOfOutputs!=myNeuralNetwork->numberOfOutputs) ||
+			 (myContext->maximumLayerWidth<myNeuralNetwork->maximumLayerWidth))
+		returnValue = NEURAL_NETWORK_CONTEXT_ERROR;
+	else if (numberOfSamples<1)
+		returnValue = NEURAL_NETWORK_NUMBER_OF_SAMPLES_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = computeContextOutputBatch(myNeuralNetwork, myContext, inputArray, numberOfSamples, outputArray);
+
+	return returnValue;
+}
+
+//Compute the outputs of 64 samples with the buffers of the context, see computeNeuralNetworkBitSlicedOutput
+NeuralNetworkErrorCode computeNeuralNetworkContextBitSlicedOutput(const NeuralNetwork *myNeuralNetwork, NeuralNetworkContext *myContext, const uint64_t *inputSliceArray, uint64_t *outputSliceArray)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myNeuralNetwork==NULL) || (myContext==NULL) || (inputSliceArray==NULL) || (outputSliceArray==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else if ((myContext->numberOfInputs!=myNeuralNetwork->numberOfInputs) || (myContext->numberOfOutputs!=myNeuralNetwork->numberOfOutputs) ||
+			 (myContext->maximumLayerWidth<myNeuralNetwork->maximumLayerWidth))
+		returnValue = NEURAL_NETWORK_CONTEXT_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = computeBitSlicedOutput(myNeuralNetwork, inputSliceArray, outputSliceArray, myContext->batchOutputBuffer);
+
+	return returnValue;
+}
+
+//Neural networks with the same topology have the same layout of their layer regions
+static bool isSameTopology(const NeuralNetwork *firstNeuralNetwork, const NeuralNetwork *secondNeuralNetwork)
+{
+	return (firstNeuralNetwork->numberOfInputs==secondNeuralNetwork->numberOfInputs) &&
+		   (firstNeuralNetwork->numberOfHiddenLayers==secondNeuralNetwork->numberOfHiddenLayers) &&
+		   (firstNeuralNetwork->numberOfOutputs==secondNeuralNetwork->numberOfOutputs) &&
+		   (firstNeuralNetwork->connectivity==secondNeuralNetwork->connectivity) &&
+		   (memcmp(firstNeuralNetwork->hiddenLayerWidthArray, secondNeuralNetwork->hiddenLayerWidthArray, sizeof(int) * firstNeuralNetwork->numberOfHiddenLayers)==0);
+}
+
+NeuralNetworkErrorCode cloneNeuralNetwork(NeuralNetwork *myNeuralNetwork, NeuralNetwork *myNeuralNetworkClone)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myNeuralNetwork==NULL) || (myNeuralNetworkClone==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	//Check if neural networks are different
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (!isSameTopology(myNeuralNetwork, myNeuralNetworkClone)))
+		returnValue = NEURAL_NETWORK_DIFFERENT_NEURAL_NETWORKS_ERROR;
+
+	//Both neural networks have the same layout, so all the neural layers are copied at once
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		memcpy(myNeuralNetworkClone->layerRegion, myNeuralNetwork->layerRegion, myNeuralNetwork->layerRegionSize);
+
+		myNeuralNetworkClone->weightHash = myNeuralNetwork->weightHash;
+		myNeuralNetworkClone->isWeightHashValid = myNeuralNetwork->isWeightHashValid;
+
+		//The previous mutations of the clone can not be reverted over the new weights
+		myNeuralNetworkClone->mutationLog.numberOfWords = 0;
+	}
+
+	/*The clone inherits the cached activations, so a mutated clone only computes the neurons that
+	 *differ from the original neural network*/
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myNeuralNetworkClone->activationCache!=NULL))
+	{
+		ActivationCache *myCache = myNeuralNetwork->activationCache;
+		ActivationCache *myCloneCache = myNeuralNetworkClone->activationCache;
+
+		if ((myCache!=NULL) && (myCache->size==myCloneCache->size))
+		{
+			memcpy(myCloneCache->neuronEpochArray, myCache->neuronEpochArray, myCache->size);
+			myCloneCache->mutationEpoch = myCache->mutationEpoch;
+		}
+		else
+			invalidateActivationCache(myNeuralNetworkClone);
+	}
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode mutateNeuralNetwork(NeuralNetwork *myNeuralNetwork)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	bool isMassiveMutation = false;
+	int mutantNeuronIndex = 0;
+	int numberOfHiddenLayers;
+	NeuronErrorCode result;
+	int i=0;
+
+	if (myNeuralNetwork==NULL)
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue == NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		numberOfHiddenLayers = myNeuralNetwork->numberOfHiddenLayers;
+
+		if (myNeuralNetwork->activationCache!=NULL)
+			myNeuralNetwork->activationCache->mutationEpoch++;
+
+		//The weight hash is saved first, so it is restored after the weights of the mutation
+		if (myNeuralNetwork->isWeightHashValid)
+			returnValue = logMutation(myNeuralNetwork, &(myNeuralNetwork->weightHash), 1, MUTATION_LOG_WEIGHT_HASH);
+
+		int randomPercent = getRandomInteger(&(myNeuralNetwork->generator), 100) + 1;
+
+		if (randomPercent<=NEURAL_NETWORK_PERCENTAGE_OF_MASSIVE_MUTATIONS)
+			isMassiveMutation = true;
 
-	//Create neural network
-	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		*myNeuralNetwork = malloc(sizeof(NeuralNetwork));
+		if (isMassiveMutation)
+		{
+			//A massive mutation changes every neuron, so the whole layer region is saved
+			if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+				returnValue = logMutation(myNeuralNetwork, (const uint64_t *) myNeuralNetwork->layerRegion, myNeuralNetwork->layerRegionSize / sizeof(uint64_t), MUTATION_LOG_LAYER_REGION);
 
-		if (*myNeuralNetwork==NULL)
-			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
-	}
+			//Mutate hidden layers
+			while ((i<numberOfHiddenLayers) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK))
+			{
+				result = mutateNeuralLayer(getNeuralLayerAt(myNeuralNetwork, i), isMassiveMutation, &(myNeuralNetwork->generator), &mutantNeuronIndex,
+										   getLayerHashKey(i), getMutationWeightHash(myNeuralNetwork));
 
-	//Create input layer
-	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		(*myNeuralNetwork)->numberOfInputs = numberOfInputs;
-		(*myNeuralNetwork)->inputLayer = malloc(sizeof(NeuronData)*numberOfInputs);
+				if (result==NEURON_RETURN_VALUE_OK)
+					markMutatedNeurons(myNeuralNetwork, i, mutantNeuronIndex);
+				else
+					returnValue = NEURAL_NETWORK_NEURON_ERROR;
 
-		if ((*myNeuralNetwork)->inputLayer==NULL)
-			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
-	}
+				i++;
+			}
 
-	//Create auxiliary arrays
-	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		(*myNeuralNetwork)->neuralLayerInputArray = malloc(sizeof(NeuronData)*numberOfInputs);
-		(*myNeuralNetwork)->neuralLayerOutputArray = malloc(sizeof(NeuronData)*numberOfInputs);
+			//Mutate output layer
+			if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			{
+				result = mutateNeuralLayer(getNeuralLayerAt(myNeuralNetwork, numberOfHiddenLayers), isMassiveMutation, &(myNeuralNetwork->generator), &mutantNeuronIndex,
+										   getLayerHashKey(numberOfHiddenLayers), getMutationWeightHash(myNeuralNetwork));
 
-		if (((*myNeuralNetwork)->neuralLayerInputArray==NULL) || ((*myNeuralNetwork)->neuralLayerOutputArray==NULL))
-			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
-	}
+				if (result==NEURON_RETURN_VALUE_OK)
+					markMutatedNeurons(myNeuralNetwork, numberOfHiddenLayers, mutantNeuronIndex);
+				else
+					returnValue = NEURAL_NETWORK_NEURON_ERROR;
+			}
+		}
+		else
+		{
+			//The number of neural layers is the number of hidden layers plus the output layer
+			int numberOfNeuralLayers = numberOfHiddenLayers + 1;
+			int mutantNeuronLayer = getRandomInteger(&(myNeuralNetwork->generator), numberOfNeuralLayers);
+			Neuron *mutantNeuron = NULL;
 
-	//Create hidden layer array
-	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		(*myNeuralNetwork)->numberOfHiddenLayers = numberOfHiddenLayers;
-		(*myNeuralNetwork)->hiddenLayerArray = malloc(sizeof(NeuralLayer*)*numberOfHiddenLayers);
+			//The mutant neuron is selected here as mutateNeuralLayer does, so its weights can be saved first
+			mutantNeuronIndex = getRandomInteger(&(myNeuralNetwork->generator), getNumberOfLayerNeurons(myNeuralNetwork, mutantNeuronLayer));
 
- 		if ((*myNeuralNetwork)->hiddenLayerArray==NULL)
-			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
-	}
+			result = getNeuron(getNeuralLayerAt(myNeuralNetwork, mutantNeuronLayer), mutantNeuronIndex, &mutantNeuron);
 
-	//Create hidden layers
- 	while ((i<numberOfHiddenLayers) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK))
-	{
-		NeuralLayer **myHiddenLayer = &((*myNeuralNetwork)->hiddenLayerArray[i]);
+			if (result!=NEURON_RETURN_VALUE_OK)
+				returnValue = NEURAL_NETWORK_NEURON_ERROR;
 
-		result = createNeuralLayer(myHiddenLayer, numberOfInputs, neuronsPerHiddenLayer);
+			if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+				returnValue = logNeuronMutation(myNeuralNetwork, mutantNeuronLayer, mutantNeuronIndex, mutantNeuron);
 
-		if (result!=NEURON_RETURN_VALUE_OK)
-			returnValue = NEURAL_NETWORK_NEURON_ERROR;
+			if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			{
+				result = mutateNeuron(mutantNeuron, &(myNeuralNetwork->generator), NEURON_HASH_KEY(getLayerHashKey(mutantNeuronLayer), mutantNeuronIndex),
+									  getMutationWeightHash(myNeuralNetwork));
 
-		i++;
+				if (result==NEURON_RETURN_VALUE_OK)
+					markMutatedNeurons(myNeuralNetwork, mutantNeuronLayer, mutantNeuronIndex);
+				else
+					returnValue = NEURAL_NETWORK_NEURON_ERROR;
+			}
+		}
 	}
 
- 	//Create output layer
-	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		NeuralLayer **myOutputLayer = &((*myNeuralNetwork)->outputLayer);
+	return returnValue;
+}
 
-		result = createNeuralLayer(myOutputLayer, numberOfInputs, numberOfOutputs);
+/*Record the weights changed by mutateNeuralNetwork, so the mutations can be undone with
+ *revertNeuralNetworkMutation instead of cloning the neural network again*/
+NeuralNetworkErrorCode setNeuralNetworkMutationLog(NeuralNetwork *myNeuralNetwork, bool isEnabled)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
-		if (result!=NEURON_RETURN_VALUE_OK)
-			returnValue = NEURAL_NETWORK_NEURON_ERROR;
-	}
+	if (myNeuralNetwork==NULL)
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
 
-	//Create neural network output array
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
 	{
-		(*myNeuralNetwork)->numberOfOutputs = numberOfOutputs;
-		(*myNeuralNetwork)->neuralNetworkOutputArray = malloc(sizeof(NeuronData)*numberOfOutputs);
+		MutationLog *myLog = &(myNeuralNetwork->mutationLog);
 
-		if ((*myNeuralNetwork)->neuralNetworkOutputArray==NULL)
-			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+		if (!isEnabled)
+		{
+			free(myLog->wordArray);
+			myLog->wordArray = NULL;
+			myLog->capacity = 0;
+		}
+
+		myLog->isEnabled = isEnabled;
+		myLog->numberOfWords = 0;
 	}
 
 	return returnValue;
 }
 
-NeuralNetworkErrorCode destroyNeuralNetwork(NeuralNetwork **myNeuralNetwork)
+//Restore the weights changed by the mutations since the last commit, from the last one to the first one
+NeuralNetworkErrorCode revertNeuralNetworkMutation(NeuralNetwork *myNeuralNetwork)
 {
 	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
-	int i=0;
 
-	if ((myNeuralNetwork==NULL) || (*myNeuralNetwork==NULL))
+	MutationLog *myLog = NULL;
+
+	if (myNeuralNetwork==NULL)
 		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else if (!myNeuralNetwork->mutationLog.isEnabled)
+		returnValue = NEURAL_NETWORK_MUTATION_LOG_ERROR;
 
+	//The restored neurons are stamped as mutated, so the activation cache computes them again
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
 	{
-		//Free input layer
-		free((*myNeuralNetwork)->inputLayer);
+		myLog = &(myNeuralNetwork->mutationLog);
 
-		//Free auxiliary arrays
-		free((*myNeuralNetwork)->neuralLayerInputArray);
-		free((*myNeuralNetwork)->neuralLayerOutputArray);
+		if ((myNeuralNetwork->activationCache!=NULL) && (myLog->numberOfWords>0))
+			myNeuralNetwork->activationCache->mutationEpoch++;
+	}
 
-		//Destroy hidden layers
-		while ((i<(*myNeuralNetwork)->numberOfHiddenLayers) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK))
-		{
-			NeuronErrorCode result = destroyNeuralLayer(&((*myNeuralNetwork)->hiddenLayerArray[i]));
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myLog->numberOfWords>0))
+	{
+		uint64_t location = myLog->wordArray[myLog->numberOfWords - 1];
+		size_t numberOfWords = myLog->wordArray[myLog->numberOfWords - 2];
+		const uint64_t *savedWordArray = myLog->wordArray + myLog->numberOfWords - MUTATION_LOG_HEADER_SIZE - numberOfWords;
 
-			if (result!=NEURON_RETURN_VALUE_OK)
-				returnValue = NEURAL_NETWORK_NEURON_ERROR;
+		if (location==MUTATION_LOG_LAYER_REGION)
+		{
+			memcpy(myNeuralNetwork->layerRegion, savedWordArray, sizeof(uint64_t) * numberOfWords);
+			myNeuralNetwork->isWeightHashValid = false;
 
-			i++;
+			for (int layerIndex=0; layerIndex<=myNeuralNetwork->numberOfHiddenLayers; layerIndex++)
+				markMutatedNeurons(myNeuralNetwork, layerIndex, NEURAL_LAYER_ALL_NEURONS);
 		}
-	}
-
-	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		//Free hidden layer array
-		free((*myNeuralNetwork)->hiddenLayerArray);
+		else if (location==MUTATION_LOG_WEIGHT_HASH)
+		{
+			//The weights of the mutation have been restored, so the hash before the mutation is valid again
+			myNeuralNetwork->weightHash = savedWordArray[0];
+			myNeuralNetwork->isWeightHashValid = true;
+		}
+		else
+		{
+			int layerIndex = (int) (location >> 32);
+			int neuronIndex = (int) (location & UINT32_MAX);
+			Neuron *myNeuron = NULL;
+			uint64_t *packedWeightArray = NULL;
+			int numberOfNeuronWords = 0;
 
-		//Destroy output layer
-		NeuronErrorCode result = destroyNeuralLayer(&((*myNeuralNetwork)->outputLayer));
+			NeuronErrorCode result = getNeuron(getNeuralLayerAt(myNeuralNetwork, layerIndex), neuronIndex, &myNeuron);
 
-		if (result!=NEURON_RETURN_VALUE_OK)
-			returnValue = NEURAL_NETWORK_NEURON_ERROR;
-	}
+			if (result==NEURON_RETURN_VALUE_OK)
+				result = getNeuronPackedWeights(myNeuron, &packedWeightArray, &numberOfNeuronWords);
 
-	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		//Free neural network output array
-		free((*myNeuralNetwork)->neuralNetworkOutputArray);
+			if (result==NEURON_RETURN_VALUE_OK)
+			{
+				memcpy(packedWeightArray, savedWordArray, sizeof(uint64_t) * numberOfWords);
+				markMutatedNeurons(myNeuralNetwork, layerIndex, neuronIndex);
+				myNeuralNetwork->isWeightHashValid = false;
+			}
+			else
+				returnValue = NEURAL_NETWORK_NEURON_ERROR;
+		}
 
-		//Free neural network memory
-		free(*myNeuralNetwork);
-		*myNeuralNetwork = NULL;
+		myLog->numberOfWords -= numberOfWords + MUTATION_LOG_HEADER_SIZE;
 	}
 
 	return returnValue;
 }
 
-NeuralNetworkErrorCode getInputLayer(NeuralNetwork *myNeuralNetwork, NeuronData **myInputLayer, int *numberOfInputs)
+//Keep the mutations since the last commit, they can not be reverted anymore
+NeuralNetworkErrorCode commitNeuralNetworkMutation(NeuralNetwork *myNeuralNetwork)
 {
 	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
-	if ((myNeuralNetwork==NULL) || (myInputLayer==NULL) || (numberOfInputs==NULL))
+	if (myNeuralNetwork==NULL)
 		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else if (!myNeuralNetwork->mutationLog.isEnabled)
+		returnValue = NEURAL_NETWORK_MUTATION_LOG_ERROR;
 
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		*myInputLayer = myNeuralNetwork->inputLayer;
-		*numberOfInputs = myNeuralNetwork->numberOfInputs;
-	}
+		myNeuralNetwork->mutationLog.numberOfWords = 0;
 
 	return returnValue;
 }
 
-NeuralNetworkErrorCode getNumberOfHiddenLayers(NeuralNetwork *myNeuralNetwork, int *numberOfHiddenLayers)
+//The random generator is not copied by cloneNeuralNetwork, so each clone mutates in its own way
+NeuralNetworkErrorCode setNeuralNetworkRandomSeed(NeuralNetwork *myNeuralNetwork, uint64_t seed)
 {
 	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
-	if ((myNeuralNetwork==NULL) || (numberOfHiddenLayers==NULL))
+	if (myNeuralNetwork==NULL)
 		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
 
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-		*numberOfHiddenLayers = myNeuralNetwork->numberOfHiddenLayers;
+		seedRandomGenerator(&(myNeuralNetwork->generator), seed);
 
 	return returnValue;
 }
 
-NeuralNetworkErrorCode getHiddenLayer(NeuralNetwork *myNeuralNetwork, int hiddenLayerNumber, NeuralLayer **myHiddenLayer)
+//The state of the random generator, saved with the weights, lets a training go on with the same mutations
+NeuralNetworkErrorCode getNeuralNetworkRandomState(const NeuralNetwork *myNeuralNetwork, RandomGenerator *myGenerator)
 {
 	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
-	if ((myNeuralNetwork==NULL) || (myHiddenLayer==NULL))
+	if ((myNeuralNetwork==NULL) || (myGenerator==NULL))
 		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
-    else if ((hiddenLayerNumber<0) || (hiddenLayerNumber>=myNeuralNetwork->numberOfHiddenLayers))
-		returnValue = NEURAL_NETWORK_NUMBER_OF_HIDDEN_LAYERS_ERROR;
 
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-		*myHiddenLayer = myNeuralNetwork->hiddenLayerArray[hiddenLayerNumber];
+		*myGenerator = myNeuralNetwork->generator;
 
 	return returnValue;
 }
 
-NeuralNetworkErrorCode getOutputLayer(NeuralNetwork *myNeuralNetwork, NeuralLayer **myOutputLayer, int *numberOfOutputs)
+NeuralNetworkErrorCode setNeuralNetworkRandomState(NeuralNetwork *myNeuralNetwork, const RandomGenerator *myGenerator)
 {
 	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
-	if ((myNeuralNetwork==NULL) || (myOutputLayer==NULL) || (numberOfOutputs==NULL))
+	if ((myNeuralNetwork==NULL) || (myGenerator==NULL))
 		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
 
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		*myOutputLayer = myNeuralNetwork->outputLayer;
-		*numberOfOutputs = myNeuralNetwork->numberOfOutputs;
-	}
+		myNeuralNetwork->generator = *myGenerator;
 
 	return returnValue;
 }
 
-NeuralNetworkErrorCode setNeuralNetworkInput(NeuralNetwork *myNeuralNetwork, int inputNumber, NeuronData input)
+//Replace all the weights with random weights, as if the neural network had just been created
+NeuralNetworkErrorCode randomizeNeuralNetwork(NeuralNetwork *myNeuralNetwork)
 {
 	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
 	if (myNeuralNetwork==NULL)
 		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
-    else if ((inputNumber<0) || (inputNumber>=myNeuralNetwork->numberOfInputs))
-		returnValue = NEURAL_NETWORK_NUMBER_OF_INPUTS_ERROR;
 
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-		myNeuralNetwork->inputLayer[inputNumber] = input;
+	{
+		invalidateActivationCache(myNeuralNetwork);
+		myNeuralNetwork->mutationLog.numberOfWords = 0;
+
+		returnValue = initializeNeuralLayers(myNeuralNetwork);
+	}
 
 	return returnValue;
 }
 
-NeuralNetworkErrorCode computeNeuralNetworkOutput(NeuralNetwork *myNeuralNetwork, NeuronData **outputArray, int *numberOfOutputs)
+/*64-bit Zobrist hash of all the weights. Two neural networks with the same topology and the same weights
+ *have the same hash. The mutations update it in constant time per changed weight and the reverted
+ *mutations restore it from the mutation log. It is computed again from all the weights after
+ *randomizeNeuralNetwork or a call to getHiddenLayer or getOutputLayer, which let the caller change the
+ *weights*/
+NeuralNetworkErrorCode getNeuralNetworkWeightHash(NeuralNetwork *myNeuralNetwork, uint64_t *weightHash)
 {
 	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
-	NeuronData *auxNeuralNetwork;
-
-	int hiddenLayerIndex=0;
-	
-	NeuronErrorCode result;
+	int layerIndex = 0;
+	uint64_t layerHash = 0;
 
-	if ((myNeuralNetwork==NULL) || (outputArray==NULL) || (numberOfOutputs==NULL))
+	if ((myNeuralNetwork==NULL) || (weightHash==NULL))
 		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else if (!myNeuralNetwork->isWeightHashValid)
+		myNeuralNetwork->weightHash = 0;
 
-	//The first hidden layer input is the input layer
-	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (!myNeuralNetwork->isWeightHashValid) && (layerIndex<=myNeuralNetwork->numberOfHiddenLayers))
 	{
-		int size = sizeof(NeuronData) * myNeuralNetwork->numberOfInputs;
-	
-		memcpy(myNeuralNetwork->neuralLayerInputArray, myNeuralNetwork->inputLayer, size);
+		if (getNeuralLayerWeightHash(getNeuralLayerAt(myNeuralNetwork, layerIndex), getLayerHashKey(layerIndex), &layerHash)!=NEURON_RETURN_VALUE_OK)
+			returnValue = NEURAL_NETWORK_NEURON_ERROR;
+		else
+			myNeuralNetwork->weightHash ^= layerHash;
+
+		layerIndex++;
 	}
 
-	//Feed hidden layers
-	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (hiddenLayerIndex<myNeuralNetwork->numberOfHiddenLayers))
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
 	{
-		result = computeNeuralLayerOutput(myNeuralNetwork->hiddenLayerArray[hiddenLayerIndex], myNeuralNetwork->neuralLayerInputArray, myNeuralNetwork->neuralLayerOutputArray);
+		myNeuralNetwork->isWeightHashValid = true;
+		*weightHash = myNeuralNetwork->weightHash;
+	}
 
-		if (result!=NEURON_RETURN_VALUE_OK)
-			returnValue = NEURAL_NETWORK_NEURON_ERROR;
+	return returnValue;
+}
 
-		//The hidden layer output is the input of the next layer
-		auxNeuralNetwork = myNeuralNetwork->neuralLayerInputArray;
-		myNeuralNetwork->neuralLayerInputArray = myNeuralNetwork->neuralLayerOutputArray;
-		myNeuralNetwork->neuralLayerOutputArray = auxNeuralNetwork;
+/*Add the weights of a neuron that differ from the same neuron of the reference neural network. The
+ *flips are counted even when the flip array is full*/
+static NeuralNetworkErrorCode findNeuronWeightFlips(Neuron *myNeuron, Neuron *referenceNeuron, int layerIndex, int neuronIndex, NeuralNetworkWeightFlip *flipArray,
+													int maximumNumberOfFlips, int *numberOfFlips)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
-		hiddenLayerIndex++;
-	}
+	uint64_t *packedWeightArray = NULL;
+	uint64_t *referencePackedWeightArray = NULL;
+	const uint64_t *connectionMask = NULL;
+	const uint64_t *referenceConnectionMask = NULL;
+	int numberOfWords = 0;
+	int numberOfReferenceWords = 0;
+	int numberOfInputs = 0;
 
-	//Feed output layer
-	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		result = computeNeuralLayerOutput(myNeuralNetwork->outputLayer, myNeuralNetwork->neuralLayerInputArray, myNeuralNetwork->neuralNetworkOutputArray);
-		
-		if (result!=NEURON_RETURN_VALUE_OK)
-			returnValue = NEURAL_NETWORK_NEURON_ERROR;
-    }
-    
-	//Get neural network output
-	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	NeuronErrorCode result = getNeuronPackedWeights(myNeuron, &packedWeightArray, &numberOfWords);
+
+	if (result==NEURON_RETURN_VALUE_OK)
+		result = getNeuronPackedWeights(referenceNeuron, &referencePackedWeightArray, &numberOfReferenceWords);
+
+	if (result==NEURON_RETURN_VALUE_OK)
+		result = getNeuronConnectionMask(myNeuron, &connectionMask);
+
+	if (result==NEURON_RETURN_VALUE_OK)
+		result = getNeuronConnectionMask(referenceNeuron, &referenceConnectionMask);
+
+	if (result==NEURON_RETURN_VALUE_OK)
+		result = getNumberOfInputs(myNeuron, &numberOfInputs);
+
+	if (result!=NEURON_RETURN_VALUE_OK)
+		returnValue = NEURAL_NETWORK_NEURON_ERROR;
+
+	//Most neurons are not mutated between two generations, so the whole neuron is compared first
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (memcmp(packedWeightArray, referencePackedWeightArray, sizeof(uint64_t) * numberOfWords)!=0))
 	{
-		*outputArray = myNeuralNetwork->neuralNetworkOutputArray;
-		*numberOfOutputs = myNeuralNetwork->numberOfOutputs;
+		for (int wordIndex=0; (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (wordIndex < NEURON_DATA_NUMBER_OF_WORDS(numberOfInputs)); wordIndex++)
+		{
+			uint64_t changedBits = packedWeightArray[wordIndex] ^ referencePackedWeightArray[wordIndex];
+
+			if (connectionMask!=NULL)
+				changedBits |= connectionMask[wordIndex] ^ referenceConnectionMask[wordIndex];
+
+			//The bits after the last input are not weights
+			if ((wordIndex==NEURON_DATA_NUMBER_OF_WORDS(numberOfInputs) - 1) && ((numberOfInputs % NEURON_DATA_BITS_PER_WORD)!=0))
+				changedBits &= (UINT64_C(1) << (numberOfInputs % NEURON_DATA_BITS_PER_WORD)) - 1;
+
+			//The sign of a disconnected weight can change without changing the weight
+			while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (changedBits!=0))
+			{
+				int weightIndex = wordIndex * NEURON_DATA_BITS_PER_WORD + __builtin_ctzll(changedBits);
+				NeuronWeight inputWeight;
+				NeuronWeight referenceInputWeight;
+
+				result = getNeuronWeight(myNeuron, weightIndex, &inputWeight);
+
+				if (result==NEURON_RETURN_VALUE_OK)
+					result = getNeuronWeight(referenceNeuron, weightIndex, &referenceInputWeight);
+
+				if (result!=NEURON_RETURN_VALUE_OK)
+				{
+					returnValue = NEURAL_NETWORK_NEURON_ERROR;
+				}
+				else if (inputWeight!=referenceInputWeight)
+				{
+					if (*numberOfFlips < maximumNumberOfFlips)
+					{
+						flipArray[*numberOfFlips].layerIndex = layerIndex;
+						flipArray[*numberOfFlips].neuronIndex = neuronIndex;
+						flipArray[*numberOfFlips].weightIndex = weightIndex;
+						flipArray[*numberOfFlips].weight = inputWeight;
+					}
+
+					(*numberOfFlips)++;
+				}
+
+				changedBits &= changedBits - 1;
+			}
+		}
 	}
 
 	return returnValue;
 }
 
-NeuralNetworkErrorCode getNeuralNetworkOutput(NeuralNetwork *myNeuralNetwork, NeuronData **outputArray, int *numberOfOutputs)
+/*Get the weights of a neural network that differ from the reference neural network, layer by layer,
+ *neuron by neuron and weight by weight. Applying the flips to the reference neural network with
+ *flipNeuralNetworkWeights gives the weights of the neural network. The number of flips is the number
+ *of changed weights even if it is higher than maximumNumberOfFlips, then only the first ones are
+ *stored in the flip array and the call can be repeated with a larger array*/
+NeuralNetworkErrorCode getNeuralNetworkWeightFlips(NeuralNetwork *myNeuralNetwork, NeuralNetwork *referenceNeuralNetwork, NeuralNetworkWeightFlip *flipArray, int maximumNumberOfFlips, int *numberOfFlips)
 {
 	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
-	if ((myNeuralNetwork==NULL) || (outputArray==NULL) || (numberOfOutputs==NULL))
+	if ((myNeuralNetwork==NULL) || (referenceNeuralNetwork==NULL) || (numberOfFlips==NULL) || ((flipArray==NULL) && (maximumNumberOfFlips > 0)))
 		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else if (!isSameTopology(myNeuralNetwork, referenceNeuralNetwork))
+		returnValue = NEURAL_NETWORK_DIFFERENT_NEURAL_NETWORKS_ERROR;
 
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		*numberOfFlips = 0;
+
+	for (int layerIndex=0; (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (layerIndex<=myNeuralNetwork->numberOfHiddenLayers); layerIndex++)
 	{
-		*outputArray = myNeuralNetwork->neuralNetworkOutputArray;
-		*numberOfOutputs = myNeuralNetwork->numberOfOutputs;
+		NeuralLayer *myNeuralLayer = getNeuralLayerAt(myNeuralNetwork, layerIndex);
+		NeuralLayer *referenceNeuralLayer = getNeuralLayerAt(referenceNeuralNetwork, layerIndex);
+
+		for (int neuronIndex=0; (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (neuronIndex < getNumberOfLayerNeurons(myNeuralNetwork, layerIndex)); neuronIndex++)
+		{
+			Neuron *myNeuron = NULL;
+			Neuron *referenceNeuron = NULL;
+
+			NeuronErrorCode result = getNeuron(myNeuralLayer, neuronIndex, &myNeuron);
+
+			if (result==NEURON_RETURN_VALUE_OK)
+				result = getNeuron(referenceNeuralLayer, neuronIndex, &referenceNeuron);
+
+			if (result==NEURON_RETURN_VALUE_OK)
+				returnValue = findNeuronWeightFlips(myNeuron, referenceNeuron, layerIndex, neuronIndex, flipArray, maximumNumberOfFlips, numberOfFlips);
+			else
+				returnValue = NEURAL_NETWORK_NEURON_ERROR;
+		}
 	}
 
 	return returnValue;
 }
 
-NeuralNetworkErrorCode cloneNeuralNetwork(NeuralNetwork *myNeuralNetwork, NeuralNetwork *myNeuralNetworkClone)
+/*Set the weights given by getNeuralNetworkWeightFlips. The weights before an invalid flip have
+ *already been set when the error is returned. The mutations since the last commit can not be
+ *reverted anymore*/
+NeuralNetworkErrorCode flipNeuralNetworkWeights(NeuralNetwork *myNeuralNetwork, const NeuralNetworkWeightFlip *flipArray, int numberOfFlips)
 {
 	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
-	int i=0;
-	int numberOfHiddenLayers=0;
-	NeuronErrorCode result;
+	int i = 0;
 
-	if ((myNeuralNetwork==NULL) || (myNeuralNetworkClone==NULL))
+	if ((myNeuralNetwork==NULL) || ((flipArray==NULL) && (numberOfFlips > 0)))
 		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
 
-	//Check if neural networks are different
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
 	{
-		if ((myNeuralNetwork->numberOfInputs!=myNeuralNetworkClone->numberOfInputs) ||
-			(myNeuralNetwork->numberOfHiddenLayers!=myNeuralNetworkClone->numberOfHiddenLayers) ||
-			(myNeuralNetwork->numberOfOutputs!=myNeuralNetworkClone->numberOfOutputs))
-
-			returnValue = NEURAL_NETWORK_DIFFERENT_NEURAL_NETWORKS_ERROR;
-		else
-			numberOfHiddenLayers = myNeuralNetwork->numberOfHiddenLayers;
+		invalidateActivationCache(myNeuralNetwork);
+		myNeuralNetwork->mutationLog.numberOfWords = 0;
+		myNeuralNetwork->isWeightHashValid = false;
 	}
 
-	//Clone hidden layers
-	while ((i<numberOfHiddenLayers) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK))
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (i < numberOfFlips))
 	{
-		NeuralLayer *myHiddenLayer = myNeuralNetwork->hiddenLayerArray[i];
-		NeuralLayer *myHiddenLayerClone = myNeuralNetworkClone->hiddenLayerArray[i];
+		const NeuralNetworkWeightFlip *myFlip = &flipArray[i];
+		Neuron *myNeuron = NULL;
 
-		result = cloneNeuralLayer(myHiddenLayer, myHiddenLayerClone);
+		if ((myFlip->layerIndex < 0) || (myFlip->layerIndex > myNeuralNetwork->numberOfHiddenLayers))
+			returnValue = NEURAL_NETWORK_NEURON_ERROR;
+		else if ((getNeuron(getNeuralLayerAt(myNeuralNetwork, myFlip->layerIndex), myFlip->neuronIndex, &myNeuron)!=NEURON_RETURN_VALUE_OK) ||
+				 (setNeuronWeight(myNeuron, myFlip->weightIndex, myFlip->weight)!=NEURON_RETURN_VALUE_OK))
 
-		if (result!=NEURON_RETURN_VALUE_OK)
 			returnValue = NEURAL_NETWORK_NEURON_ERROR;
 
 		i++;
 	}
 
-	//Clone output layer
-	if (returnValue == NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		result = cloneNeuralLayer(myNeuralNetwork->outputLayer, myNeuralNetworkClone->outputLayer);
+	return returnValue;
+}
 
-		if (result!=NEURON_RETURN_VALUE_OK)
-			returnValue = NEURAL_NETWORK_NEURON_ERROR;
-	}
+NeuralNetworkErrorCode getNeuralNetworkEngine(NeuralNetwork *myNeuralNetwork, NeuralNetworkEngine *myEngine)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myNeuralNetwork==NULL) || (myEngine==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		*myEngine = myNeuralNetwork->engine;
 
 	return returnValue;
 }
 
-NeuralNetworkErrorCode mutateNeuralNetwork(NeuralNetwork *myNeuralNetwork)
+NeuralNetworkErrorCode setNeuralNetworkEngine(NeuralNetwork *myNeuralNetwork, NeuralNetworkEngine myEngine)
 {
 	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
-	bool isMassiveMutation = false;
-	int numberOfHiddenLayers;
-	NeuronErrorCode result;
-	int i=0;
-
 	if (myNeuralNetwork==NULL)
 		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else if (myEngine > NEURAL_NETWORK_ENGINE_BIT_SLICED)
+		returnValue = NEURAL_NETWORK_ENGINE_ERROR;
 
-	if (returnValue == NEURAL_NETWORK_RETURN_VALUE_OK)
-	{
-		numberOfHiddenLayers = myNeuralNetwork->numberOfHiddenLayers;
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		myNeuralNetwork->engine = myEngine;
 
-		int randomPercent = (rand() % 100) + 1;
+	return returnValue;
+}
 
-		if (randomPercent<=NEURAL_NETWORK_PERCENTAGE_OF_MASSIVE_MUTATIONS)
-			isMassiveMutation = true;
+NeuralNetworkErrorCode getNeuralNetworkKernel(NeuralNetwork *myNeuralNetwork, NeuronKernel *myKernel)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
-		if (isMassiveMutation)
-		{
-			//Mutate hidden layers
-			while ((i<numberOfHiddenLayers) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK))
-			{
-				result = mutateNeuralLayer(myNeuralNetwork->hiddenLayerArray[i], isMassiveMutation);
+	if ((myNeuralNetwork==NULL) || (myKernel==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
 
-				if (result!=NEURON_RETURN_VALUE_OK)
-					returnValue = NEURAL_NETWORK_NEURON_ERROR;
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		*myKernel = myNeuralNetwork->kernel;
 
-				i++;
-			}
+	return returnValue;
+}
 
-			//Mutate output layer
-			if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
-			{
-				result = mutateNeuralLayer(myNeuralNetwork->outputLayer, isMassiveMutation);
+NeuralNetworkErrorCode setNeuralNetworkKernel(NeuralNetwork *myNeuralNetwork, NeuronKernel myKernel)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
-				if (result!=NEURON_RETURN_VALUE_OK)
-					returnValue = NEURAL_NETWORK_NEURON_ERROR;
-			}
-		}
-		else
-		{
-			//The number of neural layers is the number of hidden layers plus the output layer
-			int numberOfNeuralLayers = numberOfHiddenLayers + 1;
-			int mutantNeuronLayer = rand() % numberOfNeuralLayers;
+	bool isSupported = false;
 
-			if (mutantNeuronLayer<numberOfHiddenLayers)
-				result = mutateNeuralLayer(myNeuralNetwork->hiddenLayerArray[mutantNeuronLayer], isMassiveMutation);
-			else
-				result = mutateNeuralLayer(myNeuralNetwork->outputLayer, isMassiveMutation);
+	if (myNeuralNetwork==NULL)
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else if (isNeuronKernelSupported(myKernel, &isSupported)!=NEURON_RETURN_VALUE_OK)
+		returnValue = NEURAL_NETWORK_KERNEL_ERROR;
+	else if (!isSupported)
+		returnValue = NEURAL_NETWORK_KERNEL_ERROR;
 
-			if (result!=NEURON_RETURN_VALUE_OK)
-				returnValue = NEURAL_NETWORK_NEURON_ERROR;
-		}
-	}
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		myNeuralNetwork->kernel = myKernel;
 
 	return returnValue;
 }
-
@@ -14,10 +14,36 @@
 #define NEURAL_NETWORK_MINIMUM_NUMBER_OF_HIDDEN_LAYERS 1
 #define NEURAL_NETWORK_MINIMUM_NUMBER_OF_NEURONS_PER_LAYER 1
 
+//A hidden layer is the input of the next neural layer, so it needs as many neurons as a neural layer needs inputs
+#define NEURAL_NETWORK_MINIMUM_HIDDEN_LAYER_WIDTH NEURAL_LAYER_MINIMUM_NUMBER_OF_INPUTS
+
 #define NEURAL_NETWORK_PERCENTAGE_OF_MASSIVE_MUTATIONS 1
 
 typedef struct neuralNetwork NeuralNetwork;
 
+/*Input, scratch and output buffers of an inference. A trained neural network can be shared by
+ *several threads if each thread computes its outputs with its own context*/
+typedef struct neuralNetworkContext NeuralNetworkContext;
+
+/*The integer engine computes each neuron as a weighted sum of the input array, the binary engine
+ *packs the activations in 64-bit words and computes each neuron with a masked popcount. The
+ *bit-sliced engine computes 64 samples of a batch at once, with one sample per bit of each word,
+ *and uses the binary engine for a single sample. All the engines give identical outputs*/
+typedef enum
+{
+	NEURAL_NETWORK_ENGINE_INTEGER,
+	NEURAL_NETWORK_ENGINE_BINARY,
+	NEURAL_NETWORK_ENGINE_BIT_SLICED
+} NeuralNetworkEngine;
+
+/*Every input of a dense neuron is connected. A weight of a sparse neuron can also be disconnected,
+ *the mutations add and remove connections and the binary engine skips the words without connections*/
+typedef enum
+{
+	NEURAL_NETWORK_CONNECTIVITY_DENSE,
+	NEURAL_NETWORK_CONNECTIVITY_SPARSE
+} NeuralNetworkConnectivity;
+
 typedef enum
 {
 	NEURAL_NETWORK_RETURN_VALUE_OK = 0,
@@ -29,21 +55,84 @@ typedef enum
 	NEURAL_NETWORK_NUMBER_OF_OUTPUT_NEURONS_ERROR = -6,
 	NEURAL_NETWORK_DIFFERENT_NEURAL_NETWORKS_ERROR = -7,
 	NEURAL_NETWORK_NEURON_ERROR = -8,
-	NEURAL_NETWORK_JSON_GLIB_ERROR = -9,
+	NEURAL_NETWORK_JSON_SYNTAX_ERROR = -9,
 	NEURAL_NETWORK_FILE_LOAD_ERROR = -10,
-	NEURAL_NETWORK_FILE_SAVE_ERROR = -11
+	NEURAL_NETWORK_FILE_SAVE_ERROR = -11,
+	NEURAL_NETWORK_ENGINE_ERROR = -12,
+	NEURAL_NETWORK_KERNEL_ERROR = -13,
+	NEURAL_NETWORK_NUMBER_OF_SAMPLES_ERROR = -14,
+	NEURAL_NETWORK_CONTEXT_ERROR = -15,
+	NEURAL_NETWORK_EVOLVER_PARAMETER_ERROR = -16,
+	NEURAL_NETWORK_THREAD_ERROR = -17,
+	NEURAL_NETWORK_TEST_CASE_ERROR = -18,
+	NEURAL_NETWORK_MUTATION_LOG_ERROR = -19,
+	NEURAL_NETWORK_LAYER_REGION_ERROR = -20,
+	NEURAL_NETWORK_FILE_FORMAT_ERROR = -21,
+	NEURAL_NETWORK_FILE_CHECKSUM_ERROR = -22,
+	NEURAL_NETWORK_JSON_SCHEMA_ERROR = -23,
+	NEURAL_NETWORK_CONNECTIVITY_ERROR = -24,
+	NEURAL_NETWORK_CHECKPOINT_ERROR = -25,
+	NEURAL_NETWORK_JOURNAL_ERROR = -26
 } NeuralNetworkErrorCode;
 
+/*A weight that differs between two neural networks with the same topology, with its new value. The
+ *layer index 0 is the first hidden layer and the layer index numberOfHiddenLayers is the output layer*/
+typedef struct
+{
+	int layerIndex;
+	int neuronIndex;
+	int weightIndex;
+	NeuronWeight weight;
+} NeuralNetworkWeightFlip;
+
+//Release an external layer region when its neural network is destroyed
+typedef void (*NeuralNetworkReleaseFunction)(void *layerRegion, size_t layerRegionSize);
+
 NeuralNetworkErrorCode createNeuralNetwork(NeuralNetwork **myNeuralNetwork, int numberOfInputs, int numberOfHiddenLayers, int numberOfOutputs);
+NeuralNetworkErrorCode createNeuralNetworkWithTopology(NeuralNetwork **myNeuralNetwork, int numberOfInputs, int numberOfHiddenLayers, const int *hiddenLayerWidthArray, int numberOfOutputs,
+													   NeuralNetworkConnectivity connectivity);
+NeuralNetworkErrorCode createNeuralNetworkFromLayerRegion(NeuralNetwork **myNeuralNetwork, int numberOfInputs, int numberOfHiddenLayers, const int *hiddenLayerWidthArray, int numberOfOutputs,
+														  NeuralNetworkConnectivity connectivity, void *layerRegion, size_t layerRegionSize, NeuralNetworkReleaseFunction releaseFunction);
 NeuralNetworkErrorCode destroyNeuralNetwork(NeuralNetwork **myNeuralNetwork);
+NeuralNetworkErrorCode getNeuralNetworkLayerRegion(const NeuralNetwork *myNeuralNetwork, const void **layerRegion, size_t *layerRegionSize);
+NeuralNetworkErrorCode setNeuralNetworkLayerRegion(NeuralNetwork *myNeuralNetwork, const void *layerRegion, size_t layerRegionSize);
 NeuralNetworkErrorCode getInputLayer(NeuralNetwork *myNeuralNetwork, NeuronData **myInputLayer, int *numberOfInputs);
 NeuralNetworkErrorCode getNumberOfHiddenLayers(NeuralNetwork *myNeuralNetwork, int *numberOfHiddenLayers);
+NeuralNetworkErrorCode getHiddenLayerWidthArray(const NeuralNetwork *myNeuralNetwork, const int **hiddenLayerWidthArray, int *numberOfHiddenLayers);
+NeuralNetworkErrorCode getNeuralNetworkConnectivity(const NeuralNetwork *myNeuralNetwork, NeuralNetworkConnectivity *connectivity);
+NeuralNetworkErrorCode getNeuralNetworkNumberOfConnections(const NeuralNetwork *myNeuralNetwork, long long *numberOfConnections);
 NeuralNetworkErrorCode getHiddenLayer(NeuralNetwork *myNeuralNetwork, int hiddenLayerNumber, NeuralLayer **myHiddenLayer);
 NeuralNetworkErrorCode getOutputLayer(NeuralNetwork *myNeuralNetwork, NeuralLayer **myOutputLayer, int *numberOfOutputs);
+NeuralNetworkErrorCode getNeuralNetworkNumberOfOutputs(const NeuralNetwork *myNeuralNetwork, int *numberOfOutputs);
 NeuralNetworkErrorCode setNeuralNetworkInput(NeuralNetwork *myNeuralNetwork, int inputNumber, NeuronData input);
+NeuralNetworkErrorCode setNeuralNetworkPackedInput(NeuralNetwork *myNeuralNetwork, const uint64_t *packedInputArray);
 NeuralNetworkErrorCode computeNeuralNetworkOutput(NeuralNetwork *myNeuralNetwork, NeuronData **outputArray, int *numberOfOutputs);
+NeuralNetworkErrorCode computeNeuralNetworkOutputBatch(NeuralNetwork *myNeuralNetwork, const NeuronData *inputArray, int numberOfSamples, NeuronData *outputArray);
+NeuralNetworkErrorCode computeNeuralNetworkBitSlicedOutput(NeuralNetwork *myNeuralNetwork, const uint64_t *inputSliceArray, uint64_t *outputSliceArray);
+NeuralNetworkErrorCode setNeuralNetworkActivationCache(NeuralNetwork *myNeuralNetwork, int numberOfTestCases);
+NeuralNetworkErrorCode computeNeuralNetworkCachedOutput(NeuralNetwork *myNeuralNetwork, int testCaseIndex, NeuronData **outputArray, int *numberOfOutputs);
 NeuralNetworkErrorCode getNeuralNetworkOutput(NeuralNetwork *myNeuralNetwork, NeuronData **outputArray, int *numberOfOutputs);
+NeuralNetworkErrorCode createNeuralNetworkContext(const NeuralNetwork *myNeuralNetwork, NeuralNetworkContext **myContext);
+NeuralNetworkErrorCode destroyNeuralNetworkContext(NeuralNetworkContext **myContext);
+NeuralNetworkErrorCode setNeuralNetworkContextInput(NeuralNetworkContext *myContext, int inputNumber, NeuronData input);
+NeuralNetworkErrorCode computeNeuralNetworkContextOutput(const NeuralNetwork *myNeuralNetwork, NeuralNetworkContext *myContext, NeuronData **outputArray, int *numberOfOutputs);
+NeuralNetworkErrorCode computeNeuralNetworkContextOutputBatch(const NeuralNetwork *myNeuralNetwork, NeuralNetworkContext *myContext, const NeuronData *inputArray, int numberOfSamples, NeuronData *outputArray);
+NeuralNetworkErrorCode computeNeuralNetworkContextBitSlicedOutput(const NeuralNetwork *myNeuralNetwork, NeuralNetworkContext *myContext, const uint64_t *inputSliceArray, uint64_t *outputSliceArray);
 NeuralNetworkErrorCode cloneNeuralNetwork(NeuralNetwork *myNeuralNetwork, NeuralNetwork *myNeuralNetworkClone);
 NeuralNetworkErrorCode mutateNeuralNetwork(NeuralNetwork *myNeuralNetwork);
+NeuralNetworkErrorCode setNeuralNetworkMutationLog(NeuralNetwork *myNeuralNetwork, bool isEnabled);
+NeuralNetworkErrorCode revertNeuralNetworkMutation(NeuralNetwork *myNeuralNetwork);
+NeuralNetworkErrorCode commitNeuralNetworkMutation(NeuralNetwork *myNeuralNetwork);
+NeuralNetworkErrorCode setNeuralNetworkRandomSeed(NeuralNetwork *myNeuralNetwork, uint64_t seed);
+NeuralNetworkErrorCode getNeuralNetworkRandomState(const NeuralNetwork *myNeuralNetwork, RandomGenerator *myGenerator);
+NeuralNetworkErrorCode setNeuralNetworkRandomState(NeuralNetwork *myNeuralNetwork, const RandomGenerator *myGenerator);
+NeuralNetworkErrorCode randomizeNeuralNetwork(NeuralNetwork *myNeuralNetwork);
+NeuralNetworkErrorCode getNeuralNetworkWeightHash(NeuralNetwork *myNeuralNetwork, uint64_t *weightHash);
+NeuralNetworkErrorCode getNeuralNetworkWeightFlips(NeuralNetwork *myNeuralNetwork, NeuralNetwork *referenceNeuralNetwork, NeuralNetworkWeightFlip *flipArray, int maximumNumberOfFlips, int *numberOfFlips);
+NeuralNetworkErrorCode flipNeuralNetworkWeights(NeuralNetwork *myNeuralNetwork, const NeuralNetworkWeightFlip *flipArray, int numberOfFlips);
+NeuralNetworkErrorCode getNeuralNetworkEngine(NeuralNetwork *myNeuralNetwork, NeuralNetworkEngine *myEngine);
+NeuralNetworkErrorCode setNeuralNetworkEngine(NeuralNetwork *myNeuralNetwork, NeuralNetworkEngine myEngine);
+NeuralNetworkErrorCode getNeuralNetworkKernel(NeuralNetwork *myNeuralNetwork, NeuronKernel *myKernel);
+NeuralNetworkErrorCode setNeuralNetworkKernel(NeuralNetwork *myNeuralNetwork, NeuronKernel myKernel);
 
 #endif /* LOGIC_TIER_NEURALNETWORK_H_ */
@@ -0,0 +1,212 @@
+/*
+ * PortfolioEvolver.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#include "PortfolioEvolver.h"
+
+/*State shared by the branches of a portfolio. The best neural network, its score and the first error
+ *of the branches are only used with the mutex locked. The stop request is set by the first branch
+ *that reaches the target score or fails, and cancels the evolvers of the other branches*/
+typedef struct
+{
+	pthread_mutex_t mutex;
+	atomic_bool stopRequest;
+	const EvolverParameters *parameters;
+	NeuralNetwork *startNeuralNetwork;
+	NeuralNetwork *bestNeuralNetwork;
+	int bestFitnessScore;
+	NeuralNetworkErrorCode returnValue;
+} Portfolio;
+
+typedef struct
+{
+	Portfolio *portfolio;
+	int branchIndex;
+	pthread_t thread;
+} PortfolioBranch;
+
+/*Run the evolver of a branch in its own thread. The first branch keeps the random seed and the neural
+ *network of the caller, the other branches start from their own random neural network and seed*/
+static NeuralNetworkErrorCode runBranch(PortfolioBranch *myBranch)
+{
+	Portfolio *myPortfolio = myBranch->portfolio;
+
+	EvolverParameters myParameters = *(myPortfolio->parameters);
+	NeuralNetwork *myNeuralNetwork = NULL;
+	Evolver *myEvolver = NULL;
+
+	int fitnessScore = INT_MIN;
+
+	myParameters.randomSeed += (uint64_t) myBranch->branchIndex;
+	myParameters.stopRequest = &(myPortfolio->stopRequest);
+	myParameters.checkpointFunction = NULL;
+	myParameters.journalFunction = NULL;
+
+	NeuralNetworkErrorCode returnValue = createNeuralNetworkWithTopology(&myNeuralNetwork, myParameters.numberOfInputs, myParameters.numberOfHiddenLayers,
+																		 myParameters.hiddenLayerWidthArray, myParameters.numberOfOutputs, myParameters.connectivity);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = cloneNeuralNetwork(myPortfolio->startNeuralNetwork, myNeuralNetwork);
+
+	//Only the first branch reports its progress
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myBranch->branchIndex > 0))
+	{
+		myParameters.progressFunction = NULL;
+
+		returnValue = setNeuralNetworkRandomSeed(myNeuralNetwork, myParameters.randomSeed);
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			returnValue = randomizeNeuralNetwork(myNeuralNetwork);
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = createEvolver(&myEvolver, &myParameters);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = runEvolver(myEvolver, myNeuralNetwork, &fitnessScore);
+
+	pthread_mutex_lock(&(myPortfolio->mutex));
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (fitnessScore > myPortfolio->bestFitnessScore))
+	{
+		returnValue = cloneNeuralNetwork(myNeuralNetwork, myPortfolio->bestNeuralNetwork);
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			myPortfolio->bestFitnessScore = fitnessScore;
+	}
+
+	if ((returnValue!=NEURAL_NETWORK_RETURN_VALUE_OK) && (myPortfolio->returnValue==NEURAL_NETWORK_RETURN_VALUE_OK))
+		myPortfolio->returnValue = returnValue;
+
+	pthread_mutex_unlock(&(myPortfolio->mutex));
+
+	//The other branches stop after their current generation
+	if ((returnValue!=NEURAL_NETWORK_RETURN_VALUE_OK) || (fitnessScore>=myParameters.targetFitnessScore))
+		atomic_store(&(myPortfolio->stopRequest), true);
+
+	if (myEvolver!=NULL)
+		destroyEvolver(&myEvolver);
+
+	if (myNeuralNetwork!=NULL)
+		destroyNeuralNetwork(&myNeuralNetwork);
+
+	return returnValue;
+}
+
+static void *runBranchThread(void *threadData)
+{
+	runBranch(threadData);
+
+	return NULL;
+}
+
+static bool isValidPortfolioParameters(int numberOfBranches)
+{
+	bool isValid = (numberOfBranches>=PORTFOLIO_EVOLVER_MINIMUM_NUMBER_OF_BRANCHES) &&
+				   (numberOfBranches<=PORTFOLIO_EVOLVER_MAXIMUM_NUMBER_OF_BRANCHES);
+
+	return isValid;
+}
+
+/*Race numberOfBranches independent evolutionary branches, each one in its own thread with its own
+ *evolver and random seed. Every branch restarts on its own when it stagnates, and the first branch
+ *that reaches the target score stops the other ones after their current generation, so the time to
+ *solve is the time of the fastest branch instead of the time of a serial sequence of restarts. The
+ *given neural network is replaced by the best neural network of all the branches.
+ *
+ *Each branch is created with the given evolver parameters, so the number of threads is the number of
+ *threads of each branch. The stop request is replaced, the branches do not take checkpoints or keep
+ *a journal and the progress function is only called by the first branch.
+ *
+ *All the branches run their own thread pool at the same time and share the user data, so the fitness
+ *function must be thread-safe across evolvers, not only across the threads of a single evolver*/
+NeuralNetworkErrorCode runPortfolioEvolver(const EvolverParameters *myParameters, int numberOfBranches, NeuralNetwork *myNeuralNetwork, int *fitnessScore)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	Portfolio myPortfolio;
+	PortfolioBranch *branchArray = NULL;
+
+	int numberOfThreads = 0;
+	bool isMutexCreated = false;
+
+	memset(&myPortfolio, 0, sizeof(Portfolio));
+
+	if ((myParameters==NULL) || (myNeuralNetwork==NULL) || (fitnessScore==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else if (!isValidPortfolioParameters(numberOfBranches))
+		returnValue = NEURAL_NETWORK_EVOLVER_PARAMETER_ERROR;
+
+	//The given neural network must have the topology of the evolver parameters
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = createNeuralNetworkWithTopology(&(myPortfolio.bestNeuralNetwork), myParameters->numberOfInputs, myParameters->numberOfHiddenLayers,
+													  myParameters->hiddenLayerWidthArray, myParameters->numberOfOutputs, myParameters->connectivity);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = cloneNeuralNetwork(myNeuralNetwork, myPortfolio.bestNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		atomic_init(&(myPortfolio.stopRequest), false);
+
+		myPortfolio.parameters = myParameters;
+		myPortfolio.startNeuralNetwork = myNeuralNetwork;
+		myPortfolio.bestFitnessScore = INT_MIN;
+		myPortfolio.returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+		if (pthread_mutex_init(&(myPortfolio.mutex), NULL)!=0)
+			returnValue = NEURAL_NETWORK_THREAD_ERROR;
+		else
+			isMutexCreated = true;
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		branchArray = calloc(numberOfBranches, sizeof(PortfolioBranch));
+
+		if (branchArray==NULL)
+			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+	}
+
+	//Create the branch threads
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (numberOfThreads < numberOfBranches))
+	{
+		branchArray[numberOfThreads].portfolio = &myPortfolio;
+		branchArray[numberOfThreads].branchIndex = numberOfThreads;
+
+		if (pthread_create(&(branchArray[numberOfThreads].thread), NULL, runBranchThread, &branchArray[numberOfThreads])!=0)
+			returnValue = NEURAL_NETWORK_THREAD_ERROR;
+		else
+			numberOfThreads++;
+	}
+
+	//The branches already created are stopped if the other ones can not be created
+	if (returnValue!=NEURAL_NETWORK_RETURN_VALUE_OK)
+		atomic_store(&(myPortfolio.stopRequest), true);
+
+	for (int i=0; i < numberOfThreads; i++)
+		pthread_join(branchArray[i].thread, NULL);
+
+	//All the branches have ended, so the best neural network can be read without locking the mutex
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = myPortfolio.returnValue;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = cloneNeuralNetwork(myPortfolio.bestNeuralNetwork, myNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		*fitnessScore = myPortfolio.bestFitnessScore;
+
+	if (isMutexCreated)
+		pthread_mutex_destroy(&(myPortfolio.mutex));
+
+	if (myPortfolio.bestNeuralNetwork!=NULL)
+		destroyNeuralNetwork(&(myPortfolio.bestNeuralNetwork));
+
+	free(branchArray);
+
+	return returnValue;
+}
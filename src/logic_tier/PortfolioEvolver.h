@@ -0,0 +1,18 @@
+/*
+ * PortfolioEvolver.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#ifndef LOGIC_TIER_PORTFOLIOEVOLVER_H_
+#define LOGIC_TIER_PORTFOLIOEVOLVER_H_
+
+#include "Evolver.h"
+
+#define PORTFOLIO_EVOLVER_MINIMUM_NUMBER_OF_BRANCHES 1
+#define PORTFOLIO_EVOLVER_MAXIMUM_NUMBER_OF_BRANCHES 1024
+
+NeuralNetworkErrorCode runPortfolioEvolver(const EvolverParameters *myParameters, int numberOfBranches, NeuralNetwork *myNeuralNetwork, int *fitnessScore);
+
+#endif /* LOGIC_TIER_PORTFOLIOEVOLVER_H_ */
@@ -0,0 +1,43 @@
+/*
+ * Random.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#include "Random.h"
+
+#include <stdatomic.h>
+
+//Number of seeds returned by getRandomSeed, so the seeds requested at the same time are different
+static atomic_uint_fast64_t seedCounter = 0;
+
+//The splitmix64 generator expands a 64-bit seed into the xoshiro256** state
+static uint64_t getSplitMixNumber(uint64_t *seed)
+{
+	*seed += UINT64_C(0x9E3779B97F4A7C15);
+
+	return mixRandomBits(*seed);
+}
+
+void seedRandomGenerator(RandomGenerator *myGenerator, uint64_t seed)
+{
+	for (int i=0; i<4; i++)
+		myGenerator->state[i] = getSplitMixNumber(&seed);
+}
+
+//Seed built from the current time and a counter, used when the caller does not provide a seed
+uint64_t getRandomSeed(void)
+{
+	struct timespec currentTime = {0};
+
+	uint64_t seedNumber = atomic_fetch_add(&seedCounter, 1);
+
+	timespec_get(&currentTime, TIME_UTC);
+
+	uint64_t seed = ((uint64_t) currentTime.tv_sec * UINT64_C(1000000000)) + (uint64_t) currentTime.tv_nsec;
+
+	seed ^= getSplitMixNumber(&seedNumber);
+
+	return getSplitMixNumber(&seed);
+}
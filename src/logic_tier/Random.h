@@ -0,0 +1,61 @@
+/*
+ * Random.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#ifndef LOGIC_TIER_RANDOM_H_
+#define LOGIC_TIER_RANDOM_H_
+
+#include <stdint.h>
+#include <time.h>
+
+/*State of a xoshiro256** pseudorandom number generator. Each neural network carries its own
+ *generator, so several threads can create and mutate neural networks without sharing any state
+ *and a training can be replayed bit for bit from its seed*/
+typedef struct
+{
+	uint64_t state[4];
+} RandomGenerator;
+
+void seedRandomGenerator(RandomGenerator *myGenerator, uint64_t seed);
+uint64_t getRandomSeed(void);
+
+static inline uint64_t rotateRandomBits(uint64_t bits, int shift)
+{
+	return (bits << shift) | (bits >> (64 - shift));
+}
+
+//Finalizer of the splitmix64 generator: a bijection that spreads every bit of the input over the whole output
+static inline uint64_t mixRandomBits(uint64_t bits)
+{
+	bits = (bits ^ (bits >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+	bits = (bits ^ (bits >> 27)) * UINT64_C(0x94D049BB133111EB);
+
+	return bits ^ (bits >> 31);
+}
+
+static inline uint64_t getRandomNumber(RandomGenerator *myGenerator)
+{
+	uint64_t *state = myGenerator->state;
+	uint64_t randomNumber = rotateRandomBits(state[1] * 5, 7) * 9;
+	uint64_t shiftedState = state[1] << 17;
+
+	state[2] ^= state[0];
+	state[3] ^= state[1];
+	state[1] ^= state[2];
+	state[0] ^= state[3];
+	state[2] ^= shiftedState;
+	state[3] = rotateRandomBits(state[3], 45);
+
+	return randomNumber;
+}
+
+//Random integer from 0 to upperBound - 1, the upper bound must be positive
+static inline int getRandomInteger(RandomGenerator *myGenerator, int upperBound)
+{
+	return (int) (((getRandomNumber(myGenerator) >> 32) * (uint64_t) upperBound) >> 32);
+}
+
+#endif /* LOGIC_TIER_RANDOM_H_ */
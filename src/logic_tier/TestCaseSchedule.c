@@ -0,0 +1,278 @@
+/*
+ * TestCaseSchedule.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#include "TestCaseSchedule.h"
+
+#include <stdatomic.h>
+
+/*The order array holds the indices of the test cases in evaluation order. The rejection counters are
+ *updated by several threads at the same time, while the order only changes in sortTestCaseSchedule,
+ *which must not run while the test cases are being evaluated*/
+typedef struct testCaseSchedule
+{
+	int numberOfTestCases;
+	int maximumTestCaseScore;
+	int *orderArray;
+	atomic_llong *rejectionCountArray;
+} TestCaseSchedule;
+
+NeuralNetworkErrorCode createTestCaseSchedule(TestCaseSchedule **mySchedule, int numberOfTestCases, int maximumTestCaseScore)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if (mySchedule==NULL)
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else if ((numberOfTestCases<1) || (maximumTestCaseScore<0) || (maximumTestCaseScore > INT_MAX / numberOfTestCases))
+		returnValue = NEURAL_NETWORK_TEST_CASE_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		*mySchedule = calloc(1, sizeof(TestCaseSchedule));
+
+		if (*mySchedule==NULL)
+			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		TestCaseSchedule *newSchedule = *mySchedule;
+
+		newSchedule->numberOfTestCases = numberOfTestCases;
+		newSchedule->maximumTestCaseScore = maximumTestCaseScore;
+		newSchedule->orderArray = malloc(sizeof(int) * numberOfTestCases);
+		newSchedule->rejectionCountArray = malloc(sizeof(atomic_llong) * numberOfTestCases);
+
+		if ((newSchedule->orderArray==NULL) || (newSchedule->rejectionCountArray==NULL))
+		{
+			destroyTestCaseSchedule(mySchedule);
+
+			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+		}
+	}
+
+	//The test cases start in their own order
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		for (int i=0; i < numberOfTestCases; i++)
+		{
+			(*mySchedule)->orderArray[i] = i;
+			atomic_init(&((*mySchedule)->rejectionCountArray[i]), 0);
+		}
+	}
+
+	return returnValue;
+}
+
+NeuralNetworkErrorCode destroyTestCaseSchedule(TestCaseSchedule **mySchedule)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((mySchedule==NULL) || (*mySchedule==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		free((*mySchedule)->orderArray);
+		free((*mySchedule)->rejectionCountArray);
+		free(*mySchedule);
+
+		*mySchedule = NULL;
+	}
+
+	return returnValue;
+}
+
+//With INT_MIN as the score to beat no neural network is rejected and every test case is evaluated
+NeuralNetworkErrorCode startTestCaseIteration(const TestCaseSchedule *mySchedule, int scoreToBeat, TestCaseIterator *myIterator)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((mySchedule==NULL) || (myIterator==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		myIterator->schedule = mySchedule;
+		myIterator->scoreToBeat = scoreToBeat;
+		myIterator->score = 0;
+		myIterator->numberOfVisitedTestCases = 0;
+		myIterator->currentTestCase = -1;
+		myIterator->isRejected = false;
+	}
+
+	return returnValue;
+}
+
+/*Get the index of the next test case, or false when all the test cases were evaluated or the neural
+ *network can not beat the score to beat even with the maximum score in every remaining test case*/
+bool getNextTestCase(TestCaseIterator *myIterator, int *testCaseIndex)
+{
+	const TestCaseSchedule *mySchedule = myIterator->schedule;
+
+	bool isAvailable = false;
+
+	int numberOfRemainingTestCases = mySchedule->numberOfTestCases - myIterator->numberOfVisitedTestCases;
+
+	long long maximumScore = (long long) myIterator->score + (long long) numberOfRemainingTestCases * mySchedule->maximumTestCaseScore;
+
+	//A neural network that evaluates all the test cases without beating the score is rejected by the last one
+	if (maximumScore <= myIterator->scoreToBeat)
+	{
+		myIterator->isRejected = true;
+	}
+	else if (numberOfRemainingTestCases > 0)
+	{
+		myIterator->currentTestCase = mySchedule->orderArray[myIterator->numberOfVisitedTestCases];
+		myIterator->numberOfVisitedTestCases++;
+
+		*testCaseIndex = myIterator->currentTestCase;
+		isAvailable = true;
+	}
+
+	return isAvailable;
+}
+
+//Add the score of the current test case
+NeuralNetworkErrorCode addTestCaseScore(TestCaseIterator *myIterator, int score)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if (myIterator==NULL)
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else if ((myIterator->currentTestCase<0) || (score<0) || (score > myIterator->schedule->maximumTestCaseScore))
+		returnValue = NEURAL_NETWORK_TEST_CASE_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		myIterator->score += score;
+
+	return returnValue;
+}
+
+/*Score of the evaluated test cases. If the neural network was rejected the score is not the score of
+ *all the test cases, but it is not higher than the score to beat either*/
+int getTestCaseIterationScore(const TestCaseIterator *myIterator)
+{
+	return myIterator->score;
+}
+
+//The test case that rejected the neural network is counted, the iteration can be recorded from any thread
+NeuralNetworkErrorCode recordTestCaseIteration(TestCaseSchedule *mySchedule, const TestCaseIterator *myIterator)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((mySchedule==NULL) || (myIterator==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else if (myIterator->schedule!=mySchedule)
+		returnValue = NEURAL_NETWORK_TEST_CASE_ERROR;
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && myIterator->isRejected && (myIterator->currentTestCase>=0))
+		atomic_fetch_add(&(mySchedule->rejectionCountArray[myIterator->currentTestCase]), 1);
+
+	return returnValue;
+}
+
+/*Move the test cases with more rejections to the front. The sort is stable, so the order does not
+ *change without new rejections. When a counter reaches the maximum all the counters are halved, so
+ *the old rejections fade away as the population evolves*/
+NeuralNetworkErrorCode sortTestCaseSchedule(TestCaseSchedule *mySchedule)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if (mySchedule==NULL)
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		int *orderArray = mySchedule->orderArray;
+		atomic_llong *rejectionCountArray = mySchedule->rejectionCountArray;
+
+		for (int i=1; i < mySchedule->numberOfTestCases; i++)
+		{
+			int testCaseIndex = orderArray[i];
+			long long numberOfRejections = atomic_load(&rejectionCountArray[testCaseIndex]);
+			int j = i;
+
+			while ((j > 0) && (atomic_load(&rejectionCountArray[orderArray[j-1]]) < numberOfRejections))
+			{
+				orderArray[j] = orderArray[j-1];
+				j--;
+			}
+
+			orderArray[j] = testCaseIndex;
+		}
+
+		if (atomic_load(&rejectionCountArray[orderArray[0]]) >= TEST_CASE_SCHEDULE_MAXIMUM_NUMBER_OF_REJECTIONS)
+		{
+			for (int i=0; i < mySchedule->numberOfTestCases; i++)
+				atomic_store(&rejectionCountArray[i], atomic_load(&rejectionCountArray[i]) / 2);
+		}
+	}
+
+	return returnValue;
+}
+
+//Copy the order and the rejection counters, each array holds one value per test case
+NeuralNetworkErrorCode getTestCaseScheduleState(const TestCaseSchedule *mySchedule, int *orderArray, long long *rejectionCountArray)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((mySchedule==NULL) || (orderArray==NULL) || (rejectionCountArray==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		for (int i=0; i < mySchedule->numberOfTestCases; i++)
+		{
+			orderArray[i] = mySchedule->orderArray[i];
+			rejectionCountArray[i] = atomic_load(&(mySchedule->rejectionCountArray[i]));
+		}
+	}
+
+	return returnValue;
+}
+
+//Restore a state taken with getTestCaseScheduleState, the order must hold every test case once
+NeuralNetworkErrorCode setTestCaseScheduleState(TestCaseSchedule *mySchedule, const int *orderArray, const long long *rejectionCountArray)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	bool *isListedArray = NULL;
+
+	if ((mySchedule==NULL) || (orderArray==NULL) || (rejectionCountArray==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		isListedArray = calloc(mySchedule->numberOfTestCases, sizeof(bool));
+
+		if (isListedArray==NULL)
+			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+	}
+
+	for (int i=0; (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (i < mySchedule->numberOfTestCases); i++)
+	{
+		int testCaseIndex = orderArray[i];
+
+		if ((testCaseIndex<0) || (testCaseIndex>=mySchedule->numberOfTestCases) || (isListedArray[testCaseIndex]) || (rejectionCountArray[i]<0))
+			returnValue = NEURAL_NETWORK_TEST_CASE_ERROR;
+		else
+			isListedArray[testCaseIndex] = true;
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		for (int i=0; i < mySchedule->numberOfTestCases; i++)
+		{
+			mySchedule->orderArray[i] = orderArray[i];
+			atomic_store(&(mySchedule->rejectionCountArray[i]), rejectionCountArray[i]);
+		}
+	}
+
+	free(isListedArray);
+
+	return returnValue;
+}
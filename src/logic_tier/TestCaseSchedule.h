@@ -0,0 +1,47 @@
+/*
+ * TestCaseSchedule.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#ifndef LOGIC_TIER_TESTCASESCHEDULE_H_
+#define LOGIC_TIER_TESTCASESCHEDULE_H_
+
+#include "NeuralNetwork.h"
+
+//Number of rejections of a test case that halves the rejection counters of the schedule
+#define TEST_CASE_SCHEDULE_MAXIMUM_NUMBER_OF_REJECTIONS 1024
+
+/*Order in which the test cases of a fitness function are evaluated. Every test case gives a score
+ *from 0 to maximumTestCaseScore, so after each test case the score of a neural network is bounded by
+ *the score of the evaluated test cases plus the maximum score of the remaining ones. The schedule
+ *counts the test cases that rejected each neural network and moves them to the front, so the
+ *neural networks that can not win are rejected after fewer test cases*/
+typedef struct testCaseSchedule TestCaseSchedule;
+
+/*Evaluation of the test cases of a schedule, usually kept on the stack of the fitness function. The
+ *fields must only be changed through the test case functions. The iteration stops when the upper
+ *bound of the score is not higher than the score to beat, and then the neural network is rejected*/
+typedef struct
+{
+	const TestCaseSchedule *schedule;
+	int scoreToBeat;
+	int score;
+	int numberOfVisitedTestCases;
+	int currentTestCase;
+	bool isRejected;
+} TestCaseIterator;
+
+NeuralNetworkErrorCode createTestCaseSchedule(TestCaseSchedule **mySchedule, int numberOfTestCases, int maximumTestCaseScore);
+NeuralNetworkErrorCode destroyTestCaseSchedule(TestCaseSchedule **mySchedule);
+NeuralNetworkErrorCode startTestCaseIteration(const TestCaseSchedule *mySchedule, int scoreToBeat, TestCaseIterator *myIterator);
+bool getNextTestCase(TestCaseIterator *myIterator, int *testCaseIndex);
+NeuralNetworkErrorCode addTestCaseScore(TestCaseIterator *myIterator, int score);
+int getTestCaseIterationScore(const TestCaseIterator *myIterator);
+NeuralNetworkErrorCode recordTestCaseIteration(TestCaseSchedule *mySchedule, const TestCaseIterator *myIterator);
+NeuralNetworkErrorCode sortTestCaseSchedule(TestCaseSchedule *mySchedule);
+NeuralNetworkErrorCode getTestCaseScheduleState(const TestCaseSchedule *mySchedule, int *orderArray, long long *rejectionCountArray);
+NeuralNetworkErrorCode setTestCaseScheduleState(TestCaseSchedule *mySchedule, const int *orderArray, const long long *rejectionCountArray);
+
+#endif /* LOGIC_TIER_TESTCASESCHEDULE_H_ */
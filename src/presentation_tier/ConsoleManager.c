@@ -11,6 +11,7 @@ NeuralNetworkErrorCode printNeuralNetwork(NeuralNetwork *myNeuralNetwork)
 {
 	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
 
+	const int *hiddenLayerWidthArray=NULL;
 	int numberOfHiddenLayers=0;
 	int hiddenLayerIndex=0;
 
@@ -20,7 +21,7 @@ NeuralNetworkErrorCode printNeuralNetwork(NeuralNetwork *myNeuralNetwork)
 	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
 	{
 		printf("\n----- NEURAL NETWORK -----\n\n");
-		returnValue = getNumberOfHiddenLayers(myNeuralNetwork, &numberOfHiddenLayers);
+		returnValue = getHiddenLayerWidthArray(myNeuralNetwork, &hiddenLayerWidthArray, &numberOfHiddenLayers);
 	}
 
 	//Print input layer
@@ -55,7 +56,7 @@ NeuralNetworkErrorCode printNeuralNetwork(NeuralNetwork *myNeuralNetwork)
 
 		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
 		{
-			printf("Hidden Layer %d: ", hiddenLayerIndex);
+			printf("Hidden Layer %d (%d neurons): ", hiddenLayerIndex, hiddenLayerWidthArray[hiddenLayerIndex]);
 			printNeuralLayer(myHiddenLayer);
 		}
 
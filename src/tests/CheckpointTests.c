@@ -0,0 +1,250 @@
+/*
+ * CheckpointTests.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#include "CheckpointTests.h"
+
+#define NUMBER_OF_INPUTS 4
+#define CHECKPOINT_INTERVAL 100
+#define FITNESS_CACHE_SIZE 1024
+
+#define LINEAGE_JOURNAL_FILE_NAME "tests.journal"
+
+//Copy of the first checkpoint of a training, taken in the middle of the training
+typedef struct
+{
+	void *checkpoint;
+	size_t checkpointSize;
+} TestCheckpoint;
+
+static NeuralNetworkErrorCode keepFirstCheckpoint(const void *checkpoint, size_t checkpointSize, void *checkpointData)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	TestCheckpoint *myCheckpoint = checkpointData;
+
+	if (myCheckpoint->checkpoint==NULL)
+	{
+		myCheckpoint->checkpoint = malloc(checkpointSize);
+
+		if (myCheckpoint->checkpoint==NULL)
+		{
+			returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+		}
+		else
+		{
+			memcpy(myCheckpoint->checkpoint, checkpoint, checkpointSize);
+			myCheckpoint->checkpointSize = checkpointSize;
+		}
+	}
+
+	return returnValue;
+}
+
+/*Copy of the checkpoint taken right after the first restart of a training with a checkpoint after
+ *every generation, when the best neural network is a new random parent and not the neural network of
+ *the last journal entry. The checkpoints are copied until the progress shows the restart*/
+typedef struct
+{
+	TestCheckpoint checkpoint;
+	const TestTrainingResult *result;
+} TestRestartCheckpoint;
+
+static NeuralNetworkErrorCode keepRestartCheckpoint(const void *checkpoint, size_t checkpointSize, void *checkpointData)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	TestRestartCheckpoint *myCheckpoint = checkpointData;
+
+	if (myCheckpoint->result->lastProgress.numberOfRestarts==0)
+	{
+		free(myCheckpoint->checkpoint.checkpoint);
+		myCheckpoint->checkpoint.checkpoint = NULL;
+
+		returnValue = keepFirstCheckpoint(checkpoint, checkpointSize, &(myCheckpoint->checkpoint));
+	}
+
+	return returnValue;
+}
+
+/*Resume a training from a checkpoint taken in the middle of it. The resumed training must give the
+ *same neural network, after the same generations and restarts, as the training that never stopped*/
+static int testCheckpointResume(void)
+{
+	EvolverParameters myParameters;
+	TestTrainingResult myResult;
+	TestTrainingResult myResumedResult;
+	TestCheckpoint myCheckpoint = {NULL, 0};
+
+	NeuralNetwork *myNeuralNetwork = NULL;
+	Evolver *myEvolver = NULL;
+
+	NeuralNetworkErrorCode returnValue = initializeTestTrainingParameters(&myParameters, NUMBER_OF_INPUTS, &myResult);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		myParameters.fitnessCacheSize = FITNESS_CACHE_SIZE;
+		myParameters.checkpointInterval = CHECKPOINT_INTERVAL;
+		myParameters.checkpointFunction = keepFirstCheckpoint;
+		myParameters.checkpointData = &myCheckpoint;
+
+		returnValue = runTestTraining(&myParameters, &myResult);
+	}
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myCheckpoint.checkpoint==NULL))
+		returnValue = NEURAL_NETWORK_CHECKPOINT_ERROR;
+
+	//The resumed evolver is a new evolver with the same parameters
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		myParameters.userData = &myResumedResult;
+
+		returnValue = createTestTrainingNeuralNetwork(&myParameters, &myNeuralNetwork);
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = createEvolver(&myEvolver, &myParameters);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = resumeEvolver(myEvolver, myCheckpoint.checkpoint, myCheckpoint.checkpointSize, myNeuralNetwork, &(myResumedResult.fitnessScore));
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getNeuralNetworkWeightHash(myNeuralNetwork, &(myResumedResult.weightHash));
+
+	if (myEvolver!=NULL)
+		destroyEvolver(&myEvolver);
+
+	if (myNeuralNetwork!=NULL)
+		destroyNeuralNetwork(&myNeuralNetwork);
+
+	free(myCheckpoint.checkpoint);
+
+	return reportTestResult("training resumed from a checkpoint gives the same neural network", (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) &&
+																							  (myResumedResult.fitnessScore==myResult.fitnessScore) &&
+																							  (myResumedResult.weightHash==myResult.weightHash) &&
+																							  (myResumedResult.lastProgress.numberOfRestarts==myResult.lastProgress.numberOfRestarts) &&
+																							  (myResumedResult.lastProgress.numberOfEvaluations==myResult.lastProgress.numberOfEvaluations));
+}
+
+/*Resume a training that keeps a journal from the checkpoint taken after its first restart. The journal
+ *of the whole training stands for a journal that went on after the checkpoint until a crash, so it is
+ *reopened at the state of the checkpoint. Replaying it must give the resumed neural network*/
+static int testCheckpointResumeWithJournal(void)
+{
+	EvolverParameters myParameters;
+	TestTrainingResult myResult;
+	TestTrainingResult myResumedResult;
+	TestRestartCheckpoint myRestartCheckpoint = {{NULL, 0}, &myResult};
+	TestCheckpoint *myCheckpoint = &(myRestartCheckpoint.checkpoint);
+	EvolverJournalState myState;
+	LineageJournal *myJournal = NULL;
+
+	NeuralNetwork *myNeuralNetwork = NULL;
+	Evolver *myEvolver = NULL;
+
+	uint64_t replayedWeightHash = 0;
+	int replayedFitnessScore = INT_MIN;
+
+	NeuralNetworkErrorCode returnValue = initializeTestTrainingParameters(&myParameters, NUMBER_OF_INPUTS, &myResult);
+
+	memset(&myState, 0, sizeof(myState));
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = createTestTrainingNeuralNetwork(&myParameters, &myNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = createLineageJournal(&myJournal, LINEAGE_JOURNAL_FILE_NAME, myNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		myParameters.checkpointInterval = 1;
+		myParameters.checkpointFunction = keepRestartCheckpoint;
+		myParameters.checkpointData = &myRestartCheckpoint;
+		myParameters.journalFunction = writeLineageJournalEntry;
+		myParameters.journalData = myJournal;
+
+		returnValue = runTestTraining(&myParameters, &myResult);
+	}
+
+	if (myJournal!=NULL)
+	{
+		NeuralNetworkErrorCode journalReturnValue = destroyLineageJournal(&myJournal);
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			returnValue = journalReturnValue;
+	}
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myCheckpoint->checkpoint==NULL))
+		returnValue = NEURAL_NETWORK_CHECKPOINT_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getEvolverCheckpointJournalState(myCheckpoint->checkpoint, myCheckpoint->checkpointSize, &myState);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = openLineageJournal(&myJournal, LINEAGE_JOURNAL_FILE_NAME, &myState);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		myParameters.userData = &myResumedResult;
+		myParameters.journalData = myJournal;
+
+		returnValue = createEvolver(&myEvolver, &myParameters);
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = resumeEvolver(myEvolver, myCheckpoint->checkpoint, myCheckpoint->checkpointSize, myNeuralNetwork, &(myResumedResult.fitnessScore));
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getNeuralNetworkWeightHash(myNeuralNetwork, &(myResumedResult.weightHash));
+
+	if (myJournal!=NULL)
+	{
+		NeuralNetworkErrorCode journalReturnValue = destroyLineageJournal(&myJournal);
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			returnValue = journalReturnValue;
+	}
+
+	//The journal is replayed on a new copy of the neural network given to the first evolver
+	if (myNeuralNetwork!=NULL)
+		destroyNeuralNetwork(&myNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = createTestTrainingNeuralNetwork(&myParameters, &myNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = replayLineageJournal(LINEAGE_JOURNAL_FILE_NAME, LINEAGE_JOURNAL_LAST_GENERATION, myNeuralNetwork, &replayedFitnessScore);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getNeuralNetworkWeightHash(myNeuralNetwork, &replayedWeightHash);
+
+	remove(LINEAGE_JOURNAL_FILE_NAME);
+
+	if (myEvolver!=NULL)
+		destroyEvolver(&myEvolver);
+
+	if (myNeuralNetwork!=NULL)
+		destroyNeuralNetwork(&myNeuralNetwork);
+
+	free(myCheckpoint->checkpoint);
+
+	return reportTestResult("journal of a training resumed from a checkpoint replays the resumed neural network", (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) &&
+																												(myState.lastGenerationNumber>=0) &&
+																												(myState.weightHash!=myResult.weightHash) &&
+																												(myResumedResult.weightHash==myResult.weightHash) &&
+																												(replayedFitnessScore==myResumedResult.fitnessScore) &&
+																												(replayedWeightHash==myResumedResult.weightHash));
+}
+
+int runCheckpointTests(void)
+{
+	int numberOfFailedTests = 0;
+
+	numberOfFailedTests += testCheckpointResume();
+	numberOfFailedTests += testCheckpointResumeWithJournal();
+
+	return numberOfFailedTests;
+}
@@ -0,0 +1,17 @@
+/*
+ * CheckpointTests.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#ifndef TESTS_CHECKPOINTTESTS_H_
+#define TESTS_CHECKPOINTTESTS_H_
+
+#include "TestReport.h"
+#include "TestTraining.h"
+#include "../data_tier/LineageJournal.h"
+
+int runCheckpointTests(void);
+
+#endif /* TESTS_CHECKPOINTTESTS_H_ */
@@ -0,0 +1,141 @@
+/*
+ * FitnessCacheTests.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#include "FitnessCacheTests.h"
+
+#define NUMBER_OF_INPUTS 16
+#define NUMBER_OF_HIDDEN_LAYERS 2
+#define NUMBER_OF_OUTPUTS 4
+
+#define NUMBER_OF_MUTATIONS 32
+#define RANDOM_SEED 2026
+
+#define FITNESS_CACHE_SIZE 1024
+
+//Parity training with 2 inputs that restarts after each generation without improving
+#define UPPER_BOUND_NUMBER_OF_INPUTS 2
+#define UPPER_BOUND_NUMBER_OF_GENERATIONS 3000
+
+//getHiddenLayer drops the weight hash, so the hash is computed again from all the weights
+static NeuralNetworkErrorCode getFullWeightHash(NeuralNetwork *myNeuralNetwork, uint64_t *weightHash)
+{
+	NeuralLayer *myHiddenLayer = NULL;
+
+	NeuralNetworkErrorCode returnValue = getHiddenLayer(myNeuralNetwork, 0, &myHiddenLayer);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getNeuralNetworkWeightHash(myNeuralNetwork, weightHash);
+
+	return returnValue;
+}
+
+/*The hash updated by the mutations and restored by their revert must be the hash computed from all
+ *the weights*/
+static int testWeightHash(NeuralNetworkConnectivity connectivity, const char *testName)
+{
+	NeuralNetwork *myNeuralNetwork = NULL;
+
+	uint64_t originalWeightHash = 0;
+	uint64_t mutatedWeightHash = 0;
+	uint64_t fullMutatedWeightHash = 0;
+	uint64_t revertedWeightHash = 0;
+	uint64_t fullRevertedWeightHash = 0;
+
+	NeuralNetworkErrorCode returnValue = createNeuralNetworkWithTopology(&myNeuralNetwork, NUMBER_OF_INPUTS, NUMBER_OF_HIDDEN_LAYERS, NULL, NUMBER_OF_OUTPUTS, connectivity);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = setNeuralNetworkRandomSeed(myNeuralNetwork, RANDOM_SEED);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = randomizeNeuralNetwork(myNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getNeuralNetworkWeightHash(myNeuralNetwork, &originalWeightHash);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = setNeuralNetworkMutationLog(myNeuralNetwork, true);
+
+	for (int i=0; (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (i<NUMBER_OF_MUTATIONS); i++)
+		returnValue = mutateNeuralNetwork(myNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getNeuralNetworkWeightHash(myNeuralNetwork, &mutatedWeightHash);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getFullWeightHash(myNeuralNetwork, &fullMutatedWeightHash);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = revertNeuralNetworkMutation(myNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getNeuralNetworkWeightHash(myNeuralNetwork, &revertedWeightHash);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getFullWeightHash(myNeuralNetwork, &fullRevertedWeightHash);
+
+	if (myNeuralNetwork!=NULL)
+		destroyNeuralNetwork(&myNeuralNetwork);
+
+	return reportTestResult(testName, (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) &&
+									  (mutatedWeightHash!=originalWeightHash) &&
+									  (mutatedWeightHash==fullMutatedWeightHash) &&
+									  (revertedWeightHash==originalWeightHash) &&
+									  (fullRevertedWeightHash==originalWeightHash));
+}
+
+/*The fitness function of the training stops early, so the cache keeps upper bounds of the scores of
+ *the rejected neural networks. The training has so few weights that the same neural networks come
+ *back after the restarts, when the score to beat is lower. A cached score that is not an upper bound,
+ *or an upper bound reused when it could beat the score to beat, rejects a child that the training
+ *without the cache keeps*/
+static int testFitnessCacheUpperBounds(void)
+{
+	EvolverParameters myParameters;
+	TestTrainingResult myResult;
+	TestTrainingResult myCachedResult;
+
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	bool isSameTraining = true;
+
+	for (int i=0; (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (i<2); i++)
+	{
+		TestTrainingResult *currentResult = (i==0) ? &myResult : &myCachedResult;
+
+		returnValue = initializeTestTrainingParameters(&myParameters, UPPER_BOUND_NUMBER_OF_INPUTS, currentResult);
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		{
+			myParameters.maximumNumberOfGenerations = UPPER_BOUND_NUMBER_OF_GENERATIONS;
+			myParameters.maximumNumberOfGenerationsWithoutImproving = 1;
+			myParameters.fitnessCacheSize = (i==0) ? 0 : FITNESS_CACHE_SIZE;
+
+			returnValue = runTestTraining(&myParameters, currentResult);
+		}
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		isSameTraining = (myCachedResult.fitnessScore==myResult.fitnessScore) &&
+						 (myCachedResult.weightHash==myResult.weightHash) &&
+						 (myCachedResult.lastProgress.numberOfRestarts==myResult.lastProgress.numberOfRestarts) &&
+						 (myCachedResult.lastProgress.generationNumber==myResult.lastProgress.generationNumber);
+
+	return reportTestResult("fitness cache with upper bounds gives the same training as no cache", (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) &&
+																								   (myCachedResult.lastProgress.numberOfFitnessCacheHits>0) &&
+																								   isSameTraining);
+}
+
+int runFitnessCacheTests(void)
+{
+	int numberOfFailedTests = 0;
+
+	numberOfFailedTests += testWeightHash(NEURAL_NETWORK_CONNECTIVITY_DENSE, "weight hash of a dense neural network is consistent after a revert");
+	numberOfFailedTests += testWeightHash(NEURAL_NETWORK_CONNECTIVITY_SPARSE, "weight hash of a sparse neural network is consistent after a revert");
+	numberOfFailedTests += testFitnessCacheUpperBounds();
+
+	return numberOfFailedTests;
+}
@@ -0,0 +1,16 @@
+/*
+ * FitnessCacheTests.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#ifndef TESTS_FITNESSCACHETESTS_H_
+#define TESTS_FITNESSCACHETESTS_H_
+
+#include "TestReport.h"
+#include "TestTraining.h"
+
+int runFitnessCacheTests(void);
+
+#endif /* TESTS_FITNESSCACHETESTS_H_ */
@@ -0,0 +1,219 @@
+/*
+ * LineageJournalTests.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#include "LineageJournalTests.h"
+
+#define NUMBER_OF_INPUTS 4
+
+#define LINEAGE_JOURNAL_FILE_NAME "tests.journal"
+
+//Entries kept when the journal is cut, the entries after them stand for a crashed run
+#define NUMBER_OF_KEPT_ENTRIES 3
+
+//Bytes of an entry whose writing was stopped by a crash
+#define TORN_ENTRY_SIZE 5
+
+//Journal that remembers the state reached by its first entries
+typedef struct
+{
+	LineageJournal *journal;
+	int numberOfEntries;
+	int keptFitnessScore;
+	EvolverJournalState keptState;
+} TestLineageJournal;
+
+static NeuralNetworkErrorCode writeTestLineageJournalEntry(const EvolverJournalEntry *myEntry, void *journalData)
+{
+	TestLineageJournal *myTestJournal = (TestLineageJournal *) journalData;
+
+	if (myTestJournal->numberOfEntries < NUMBER_OF_KEPT_ENTRIES)
+	{
+		myTestJournal->keptFitnessScore = myEntry->fitnessScore;
+		myTestJournal->keptState.lastGenerationNumber = myEntry->generationNumber;
+		myTestJournal->keptState.nextGenerationNumber = myEntry->generationNumber + 1;
+		myTestJournal->keptState.weightHash = myEntry->weightHash;
+	}
+
+	myTestJournal->numberOfEntries++;
+
+	return writeLineageJournalEntry(myEntry, myTestJournal->journal);
+}
+
+/*Replay the journal of a training with restarts on a copy of the neural network given to the
+ *evolver. The replayed neural network must be the trained neural network, with the same score*/
+static int testLineageJournalReplay(void)
+{
+	EvolverParameters myParameters;
+	TestTrainingResult myResult;
+	LineageJournal *myJournal = NULL;
+
+	NeuralNetwork *myNeuralNetwork = NULL;
+	NeuralNetwork *myReplayedNeuralNetwork = NULL;
+
+	uint64_t replayedWeightHash = 0;
+	int replayedFitnessScore = INT_MIN;
+
+	NeuralNetworkErrorCode returnValue = initializeTestTrainingParameters(&myParameters, NUMBER_OF_INPUTS, &myResult);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = createTestTrainingNeuralNetwork(&myParameters, &myNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = createTestTrainingNeuralNetwork(&myParameters, &myReplayedNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = createLineageJournal(&myJournal, LINEAGE_JOURNAL_FILE_NAME, myNeuralNetwork);
+
+	//runTestTraining starts from the same neural network as the journal
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		myParameters.journalFunction = writeLineageJournalEntry;
+		myParameters.journalData = myJournal;
+
+		returnValue = runTestTraining(&myParameters, &myResult);
+	}
+
+	if (myJournal!=NULL)
+	{
+		NeuralNetworkErrorCode journalReturnValue = destroyLineageJournal(&myJournal);
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			returnValue = journalReturnValue;
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = replayLineageJournal(LINEAGE_JOURNAL_FILE_NAME, LINEAGE_JOURNAL_LAST_GENERATION, myReplayedNeuralNetwork, &replayedFitnessScore);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getNeuralNetworkWeightHash(myReplayedNeuralNetwork, &replayedWeightHash);
+
+	remove(LINEAGE_JOURNAL_FILE_NAME);
+
+	if (myNeuralNetwork!=NULL)
+		destroyNeuralNetwork(&myNeuralNetwork);
+
+	if (myReplayedNeuralNetwork!=NULL)
+		destroyNeuralNetwork(&myReplayedNeuralNetwork);
+
+	return reportTestResult("lineage journal replay gives the trained neural network", (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) &&
+																					   (myResult.lastProgress.numberOfRestarts>0) &&
+																					   (replayedFitnessScore==myResult.fitnessScore) &&
+																					   (replayedWeightHash==myResult.weightHash));
+}
+
+/*Cut the journal of a training after its first entries and after a torn entry. A journal opened from
+ *another neural network must be refused, the journal opened at the kept entries must replay the
+ *neural network of the last kept entry*/
+static int testLineageJournalRecovery(void)
+{
+	EvolverParameters myParameters;
+	TestTrainingResult myResult;
+	TestLineageJournal myTestJournal;
+	EvolverJournalState myWrongState;
+
+	NeuralNetwork *myNeuralNetwork = NULL;
+	NeuralNetwork *myReplayedNeuralNetwork = NULL;
+
+	const unsigned char tornEntry[TORN_ENTRY_SIZE] = {0};
+	FILE *myFile = NULL;
+
+	NeuralNetworkErrorCode wrongReturnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+	uint64_t replayedWeightHash = 0;
+	int replayedFitnessScore = INT_MIN;
+
+	NeuralNetworkErrorCode returnValue = initializeTestTrainingParameters(&myParameters, NUMBER_OF_INPUTS, &myResult);
+
+	memset(&myTestJournal, 0, sizeof(myTestJournal));
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = createTestTrainingNeuralNetwork(&myParameters, &myNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = createTestTrainingNeuralNetwork(&myParameters, &myReplayedNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getNeuralNetworkWeightHash(myNeuralNetwork, &(myTestJournal.keptState.initialWeightHash));
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = createLineageJournal(&(myTestJournal.journal), LINEAGE_JOURNAL_FILE_NAME, myNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		myParameters.journalFunction = writeTestLineageJournalEntry;
+		myParameters.journalData = &myTestJournal;
+
+		returnValue = runTestTraining(&myParameters, &myResult);
+	}
+
+	if (myTestJournal.journal!=NULL)
+	{
+		NeuralNetworkErrorCode journalReturnValue = destroyLineageJournal(&(myTestJournal.journal));
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			returnValue = journalReturnValue;
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		myFile = fopen(LINEAGE_JOURNAL_FILE_NAME, "ab");
+
+		if ((myFile==NULL) || (fwrite(tornEntry, sizeof(tornEntry), 1, myFile)!=1))
+			returnValue = NEURAL_NETWORK_FILE_SAVE_ERROR;
+
+		if ((myFile!=NULL) && (fclose(myFile)==EOF))
+			returnValue = NEURAL_NETWORK_FILE_SAVE_ERROR;
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		myWrongState = myTestJournal.keptState;
+		myWrongState.initialWeightHash++;
+
+		wrongReturnValue = openLineageJournal(&(myTestJournal.journal), LINEAGE_JOURNAL_FILE_NAME, &myWrongState);
+
+		returnValue = openLineageJournal(&(myTestJournal.journal), LINEAGE_JOURNAL_FILE_NAME, &(myTestJournal.keptState));
+	}
+
+	if (myTestJournal.journal!=NULL)
+	{
+		NeuralNetworkErrorCode journalReturnValue = destroyLineageJournal(&(myTestJournal.journal));
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			returnValue = journalReturnValue;
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = replayLineageJournal(LINEAGE_JOURNAL_FILE_NAME, LINEAGE_JOURNAL_LAST_GENERATION, myReplayedNeuralNetwork, &replayedFitnessScore);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getNeuralNetworkWeightHash(myReplayedNeuralNetwork, &replayedWeightHash);
+
+	remove(LINEAGE_JOURNAL_FILE_NAME);
+
+	if (myNeuralNetwork!=NULL)
+		destroyNeuralNetwork(&myNeuralNetwork);
+
+	if (myReplayedNeuralNetwork!=NULL)
+		destroyNeuralNetwork(&myReplayedNeuralNetwork);
+
+	return reportTestResult("lineage journal opened after a crash keeps the entries before it", (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) &&
+																								(wrongReturnValue==NEURAL_NETWORK_JOURNAL_ERROR) &&
+																								(myTestJournal.numberOfEntries > NUMBER_OF_KEPT_ENTRIES) &&
+																								(replayedFitnessScore==myTestJournal.keptFitnessScore) &&
+																								(replayedWeightHash==myTestJournal.keptState.weightHash) &&
+																								(replayedWeightHash!=myResult.weightHash));
+}
+
+int runLineageJournalTests(void)
+{
+	int numberOfFailedTests = 0;
+
+	numberOfFailedTests += testLineageJournalReplay();
+	numberOfFailedTests += testLineageJournalRecovery();
+
+	return numberOfFailedTests;
+}
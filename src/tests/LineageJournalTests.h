@@ -0,0 +1,17 @@
+/*
+ * LineageJournalTests.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#ifndef TESTS_LINEAGEJOURNALTESTS_H_
+#define TESTS_LINEAGEJOURNALTESTS_H_
+
+#include "TestReport.h"
+#include "TestTraining.h"
+#include "../data_tier/LineageJournal.h"
+
+int runLineageJournalTests(void);
+
+#endif /* TESTS_LINEAGEJOURNALTESTS_H_ */
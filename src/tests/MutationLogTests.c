@@ -0,0 +1,125 @@
+/*
+ * MutationLogTests.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#include "MutationLogTests.h"
+
+#define NUMBER_OF_INPUTS 16
+#define NUMBER_OF_HIDDEN_LAYERS 2
+#define NUMBER_OF_OUTPUTS 4
+
+#define NUMBER_OF_MUTATIONS 32
+#define RANDOM_SEED 2026
+
+static NeuralNetworkErrorCode countChangedWeights(NeuralNetwork *myNeuralNetwork, NeuralNetwork *referenceNeuralNetwork, int *numberOfChangedWeights)
+{
+	return getNeuralNetworkWeightFlips(myNeuralNetwork, referenceNeuralNetwork, NULL, 0, numberOfChangedWeights);
+}
+
+static NeuralNetworkErrorCode mutateSeveralTimes(NeuralNetwork *myNeuralNetwork)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	for (int i=0; (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (i<NUMBER_OF_MUTATIONS); i++)
+		returnValue = mutateNeuralNetwork(myNeuralNetwork);
+
+	return returnValue;
+}
+
+/*Revert the mutations of a neural network, then mutate it again and commit the mutations, which
+ *must survive a later revert. The weights are compared with copies of the neural network*/
+static int testMutationLog(NeuralNetworkConnectivity connectivity, const char *revertTestName, const char *commitTestName)
+{
+	NeuralNetwork *myNeuralNetwork = NULL;
+	NeuralNetwork *myOriginalNeuralNetwork = NULL;
+	NeuralNetwork *myMutatedNeuralNetwork = NULL;
+
+	int numberOfMutatedWeights = 0;
+	int numberOfRevertedWeights = -1;
+	int numberOfCommittedWeights = -1;
+	int numberOfDifferentWeights = 0;
+	int numberOfFailedTests = 0;
+
+	NeuralNetworkErrorCode returnValue = createNeuralNetworkWithTopology(&myNeuralNetwork, NUMBER_OF_INPUTS, NUMBER_OF_HIDDEN_LAYERS, NULL, NUMBER_OF_OUTPUTS, connectivity);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = createNeuralNetworkWithTopology(&myOriginalNeuralNetwork, NUMBER_OF_INPUTS, NUMBER_OF_HIDDEN_LAYERS, NULL, NUMBER_OF_OUTPUTS, connectivity);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = createNeuralNetworkWithTopology(&myMutatedNeuralNetwork, NUMBER_OF_INPUTS, NUMBER_OF_HIDDEN_LAYERS, NULL, NUMBER_OF_OUTPUTS, connectivity);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = setNeuralNetworkRandomSeed(myNeuralNetwork, RANDOM_SEED);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = randomizeNeuralNetwork(myNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = cloneNeuralNetwork(myNeuralNetwork, myOriginalNeuralNetwork);
+
+	//Mutate and revert
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = setNeuralNetworkMutationLog(myNeuralNetwork, true);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = mutateSeveralTimes(myNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = countChangedWeights(myNeuralNetwork, myOriginalNeuralNetwork, &numberOfMutatedWeights);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = revertNeuralNetworkMutation(myNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = countChangedWeights(myNeuralNetwork, myOriginalNeuralNetwork, &numberOfRevertedWeights);
+
+	numberOfFailedTests += reportTestResult(revertTestName, (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (numberOfMutatedWeights>0) && (numberOfRevertedWeights==0));
+
+	//Mutate and commit, the revert after the commit must not change anything
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = mutateSeveralTimes(myNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = cloneNeuralNetwork(myNeuralNetwork, myMutatedNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = commitNeuralNetworkMutation(myNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = revertNeuralNetworkMutation(myNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = countChangedWeights(myNeuralNetwork, myMutatedNeuralNetwork, &numberOfCommittedWeights);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = countChangedWeights(myNeuralNetwork, myOriginalNeuralNetwork, &numberOfDifferentWeights);
+
+	numberOfFailedTests += reportTestResult(commitTestName, (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (numberOfCommittedWeights==0) && (numberOfDifferentWeights>0));
+
+	if (myNeuralNetwork!=NULL)
+		destroyNeuralNetwork(&myNeuralNetwork);
+
+	if (myOriginalNeuralNetwork!=NULL)
+		destroyNeuralNetwork(&myOriginalNeuralNetwork);
+
+	if (myMutatedNeuralNetwork!=NULL)
+		destroyNeuralNetwork(&myMutatedNeuralNetwork);
+
+	return numberOfFailedTests;
+}
+
+int runMutationLogTests(void)
+{
+	int numberOfFailedTests = 0;
+
+	numberOfFailedTests += testMutationLog(NEURAL_NETWORK_CONNECTIVITY_DENSE, "mutation log reverts the mutations of a dense neural network",
+										   "mutation log keeps the committed mutations of a dense neural network");
+
+	numberOfFailedTests += testMutationLog(NEURAL_NETWORK_CONNECTIVITY_SPARSE, "mutation log reverts the mutations of a sparse neural network",
+										   "mutation log keeps the committed mutations of a sparse neural network");
+
+	return numberOfFailedTests;
+}
@@ -0,0 +1,15 @@
+/*
+ * MutationLogTests.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#ifndef TESTS_MUTATIONLOGTESTS_H_
+#define TESTS_MUTATIONLOGTESTS_H_
+
+#include "TestReport.h"
+
+int runMutationLogTests(void);
+
+#endif /* TESTS_MUTATIONLOGTESTS_H_ */
@@ -0,0 +1,30 @@
+/*
+ * RunTests.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#include "MutationLogTests.h"
+#include "FitnessCacheTests.h"
+#include "CheckpointTests.h"
+#include "LineageJournalTests.h"
+
+#include <stdlib.h>
+
+int main(void)
+{
+	int numberOfFailedTests = 0;
+
+	numberOfFailedTests += runMutationLogTests();
+	numberOfFailedTests += runFitnessCacheTests();
+	numberOfFailedTests += runCheckpointTests();
+	numberOfFailedTests += runLineageJournalTests();
+
+	if (numberOfFailedTests > 0)
+		printf("\n%d TESTS FAILED\n", numberOfFailedTests);
+	else
+		printf("\nALL TESTS PASSED\n");
+
+	return (numberOfFailedTests > 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,16 @@
+/*
+ * TestReport.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#include "TestReport.h"
+
+//Print the result of a test, the number of failed tests is returned so the results can be added up
+int reportTestResult(const char *testName, bool isPassed)
+{
+	printf("%s: %s\n", isPassed ? "PASSED" : "FAILED", testName);
+
+	return isPassed ? 0 : 1;
+}
@@ -0,0 +1,17 @@
+/*
+ * TestReport.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#ifndef TESTS_TESTREPORT_H_
+#define TESTS_TESTREPORT_H_
+
+#include "../logic_tier/NeuralNetwork.h"
+
+#include <stdio.h>
+
+int reportTestResult(const char *testName, bool isPassed);
+
+#endif /* TESTS_TESTREPORT_H_ */
@@ -0,0 +1,157 @@
+/*
+ * TestTraining.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#include "TestTraining.h"
+
+#define NUMBER_OF_HIDDEN_LAYERS 1
+#define NUMBER_OF_OUTPUTS 1
+
+/*The target score is higher than the number of test cases, so every training runs all its
+ *generations and goes through several restarts, which lower the score to beat again*/
+#define MAXIMUM_NUMBER_OF_GENERATIONS 300
+#define MAXIMUM_NUMBER_OF_GENERATIONS_WITHOUT_IMPROVING 25
+
+#define NUMBER_OF_PARENTS 2
+#define NUMBER_OF_CHILDREN 4
+#define NUMBER_OF_THREADS 2
+#define RANDOM_SEED 2026
+
+/*Each combination of the inputs is a test case, which scores one point if the output is the parity
+ *of the inputs. The test case iterator stops as soon as the neural network can not beat the score
+ *to beat, so the score of a rejected neural network is only the score of the evaluated test cases*/
+static NeuralNetworkErrorCode evaluateParity(NeuralNetwork *myNeuralNetwork, int scoreToBeat, TestCaseIterator *myTestCaseIterator, void *userData, int *fitnessScore)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	NeuronData *myInputLayer;
+	NeuronData *neuralNetworkOutput;
+
+	int numberOfInputs = 0;
+	int numberOfOutputs = 0;
+	int testCaseIndex = 0;
+
+	(void) scoreToBeat;
+	(void) userData;
+
+	if ((myNeuralNetwork==NULL) || (myTestCaseIterator==NULL) || (fitnessScore==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else
+		returnValue = getInputLayer(myNeuralNetwork, &myInputLayer, &numberOfInputs);
+
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (getNextTestCase(myTestCaseIterator, &testCaseIndex)))
+	{
+		int parity = 0;
+
+		for (int i=0; (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (i<numberOfInputs); i++)
+		{
+			parity ^= (testCaseIndex >> i) & 1;
+
+			returnValue = setNeuralNetworkInput(myNeuralNetwork, i, (testCaseIndex >> i) & 1);
+		}
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			returnValue = computeNeuralNetworkOutput(myNeuralNetwork, &neuralNetworkOutput, &numberOfOutputs);
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			returnValue = addTestCaseScore(myTestCaseIterator, (neuralNetworkOutput[0]==parity) ? 1 : 0);
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		*fitnessScore = getTestCaseIterationScore(myTestCaseIterator);
+
+	return returnValue;
+}
+
+//The user data is the result of the training, which keeps the last progress
+static void storeProgress(const EvolverProgress *myProgress, void *userData)
+{
+	TestTrainingResult *myResult = userData;
+
+	myResult->lastProgress = *myProgress;
+}
+
+/*Evolver parameters of a parity training with the given number of inputs, a training with the same
+ *parameters always gives the same neural network*/
+NeuralNetworkErrorCode initializeTestTrainingParameters(EvolverParameters *myParameters, int numberOfInputs, TestTrainingResult *myResult)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myParameters==NULL) || (myResult==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else
+		returnValue = initializeEvolverParameters(myParameters, numberOfInputs, NUMBER_OF_HIDDEN_LAYERS, NUMBER_OF_OUTPUTS);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		memset(myResult, 0, sizeof(TestTrainingResult));
+
+		myParameters->numberOfParents = NUMBER_OF_PARENTS;
+		myParameters->numberOfChildren = NUMBER_OF_CHILDREN;
+		myParameters->numberOfThreads = NUMBER_OF_THREADS;
+		myParameters->numberOfTestCases = 1 << numberOfInputs;
+		myParameters->targetFitnessScore = myParameters->numberOfTestCases + 1;
+		myParameters->maximumNumberOfGenerations = MAXIMUM_NUMBER_OF_GENERATIONS;
+		myParameters->maximumNumberOfGenerationsWithoutImproving = MAXIMUM_NUMBER_OF_GENERATIONS_WITHOUT_IMPROVING;
+		myParameters->randomSeed = RANDOM_SEED;
+		myParameters->fitnessFunction = evaluateParity;
+		myParameters->progressFunction = storeProgress;
+		myParameters->userData = myResult;
+	}
+
+	return returnValue;
+}
+
+//Create the neural network given to the evolver, with the topology and the random seed of the parameters
+NeuralNetworkErrorCode createTestTrainingNeuralNetwork(const EvolverParameters *myParameters, NeuralNetwork **myNeuralNetwork)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if ((myParameters==NULL) || (myNeuralNetwork==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else
+		returnValue = createNeuralNetworkWithTopology(myNeuralNetwork, myParameters->numberOfInputs, myParameters->numberOfHiddenLayers, myParameters->hiddenLayerWidthArray,
+													  myParameters->numberOfOutputs, myParameters->connectivity);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = setNeuralNetworkRandomSeed(*myNeuralNetwork, myParameters->randomSeed);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = randomizeNeuralNetwork(*myNeuralNetwork);
+
+	return returnValue;
+}
+
+//Train a neural network with the given parameters and keep its score and its weight hash in the result
+NeuralNetworkErrorCode runTestTraining(const EvolverParameters *myParameters, TestTrainingResult *myResult)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	NeuralNetwork *myNeuralNetwork = NULL;
+	Evolver *myEvolver = NULL;
+
+	if ((myParameters==NULL) || (myResult==NULL))
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else
+		returnValue = createTestTrainingNeuralNetwork(myParameters, &myNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = createEvolver(&myEvolver, myParameters);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = runEvolver(myEvolver, myNeuralNetwork, &(myResult->fitnessScore));
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getNeuralNetworkWeightHash(myNeuralNetwork, &(myResult->weightHash));
+
+	if (myEvolver!=NULL)
+		destroyEvolver(&myEvolver);
+
+	if (myNeuralNetwork!=NULL)
+		destroyNeuralNetwork(&myNeuralNetwork);
+
+	return returnValue;
+}
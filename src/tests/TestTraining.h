@@ -0,0 +1,26 @@
+/*
+ * TestTraining.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#ifndef TESTS_TESTTRAINING_H_
+#define TESTS_TESTTRAINING_H_
+
+#include "../logic_tier/NeuralNetwork.h"
+#include "../logic_tier/Evolver.h"
+
+//Result of a training, the weight hash identifies the weights of the trained neural network
+typedef struct
+{
+	int fitnessScore;
+	uint64_t weightHash;
+	EvolverProgress lastProgress;
+} TestTrainingResult;
+
+NeuralNetworkErrorCode initializeTestTrainingParameters(EvolverParameters *myParameters, int numberOfInputs, TestTrainingResult *myResult);
+NeuralNetworkErrorCode createTestTrainingNeuralNetwork(const EvolverParameters *myParameters, NeuralNetwork **myNeuralNetwork);
+NeuralNetworkErrorCode runTestTraining(const EvolverParameters *myParameters, TestTrainingResult *myResult);
+
+#endif /* TESTS_TESTTRAINING_H_ */
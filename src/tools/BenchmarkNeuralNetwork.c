@@ -0,0 +1,577 @@
+/*
+ ============================================================================
+ Name        : BenchmarkNeuralNetwork
+ Author      : Kenshiro
+ Copyright   : GNU General Public License (GPLv3)
+ Description : Time the core operations of the library over a grid of sizes
+ ============================================================================
+ */
+
+#include "../data_tier/DataManager.h"
+#include "BenchmarkStatistics.h"
+
+#define BENCHMARK_DEFAULT_WARMUPS 3
+#define BENCHMARK_DEFAULT_REPETITIONS 21
+#define BENCHMARK_DEFAULT_OUTPUT_FILE "/dev/stdout"
+#define BENCHMARK_DEFAULT_LABEL ""
+#define BENCHMARK_DEFAULT_SEED 1
+
+//Saving and loading are skipped for neural networks above this size, a json file takes 3 bytes per weight
+#define BENCHMARK_DEFAULT_MAXIMUM_FILE_WEIGHTS (1 << 25)
+
+#define BENCHMARK_MAXIMUM_NUMBER_OF_SIZES 16
+#define BENCHMARK_MAXIMUM_NUMBER_OF_OUTPUTS 8
+#define BENCHMARK_MAXIMUM_PATH_LENGTH 4096
+
+/*Fast operations are repeated inside each sample until the sample lasts this long, so the timer
+ *resolution does not distort the result*/
+#define BENCHMARK_MINIMUM_SAMPLE_NANOSECONDS 1000000.0
+#define BENCHMARK_MAXIMUM_ITERATIONS_PER_SAMPLE 1000000
+
+#define BENCHMARK_NANOSECONDS_PER_SECOND 1000000000.0
+
+typedef struct
+{
+	NeuralNetwork *myNeuralNetwork;
+	NeuralNetwork *myNeuralNetworkClone;
+	int numberOfInputs;
+	int numberOfHiddenLayers;
+	int numberOfOutputs;
+	char jsonFilePath[BENCHMARK_MAXIMUM_PATH_LENGTH];
+	char binaryFilePath[BENCHMARK_MAXIMUM_PATH_LENGTH];
+} BenchmarkState;
+
+typedef NeuralNetworkErrorCode (*BenchmarkFunction)(BenchmarkState *myState);
+
+typedef struct
+{
+	const char *name;
+	BenchmarkFunction function;
+	bool isFileOperation;
+} BenchmarkOperation;
+
+typedef struct
+{
+	int inputArray[BENCHMARK_MAXIMUM_NUMBER_OF_SIZES];
+	int numberOfInputSizes;
+	int hiddenLayerArray[BENCHMARK_MAXIMUM_NUMBER_OF_SIZES];
+	int numberOfHiddenLayerSizes;
+	int warmups;
+	int repetitions;
+	long long maximumFileWeights;
+	uint64_t seed;
+	const char *outputFilePath;
+	const char *label;
+} BenchmarkParameters;
+
+static const int defaultInputArray[] = {8, 64, 512, 4096};
+static const int defaultHiddenLayerArray[] = {1, 8, 64};
+
+static const char *engineNameArray[] = {"integer", "binary", "bitSliced"};
+static const char *kernelNameArray[] = {"scalar", "sse4.2", "avx2", "avx512"};
+
+static inline double getNanoseconds(void)
+{
+	struct timespec myTime;
+
+	clock_gettime(CLOCK_MONOTONIC, &myTime);
+
+	return (double) myTime.tv_sec * BENCHMARK_NANOSECONDS_PER_SECOND + (double) myTime.tv_nsec;
+}
+
+//Operations
+
+static NeuralNetworkErrorCode benchmarkComputeOutput(BenchmarkState *myState)
+{
+	NeuronData *outputArray;
+	int numberOfOutputs;
+
+	return computeNeuralNetworkOutput(myState->myNeuralNetwork, &outputArray, &numberOfOutputs);
+}
+
+static NeuralNetworkErrorCode benchmarkClone(BenchmarkState *myState)
+{
+	return cloneNeuralNetwork(myState->myNeuralNetwork, myState->myNeuralNetworkClone);
+}
+
+static NeuralNetworkErrorCode benchmarkMutate(BenchmarkState *myState)
+{
+	return mutateNeuralNetwork(myState->myNeuralNetwork);
+}
+
+static NeuralNetworkErrorCode benchmarkCreateDestroy(BenchmarkState *myState)
+{
+	NeuralNetwork *myNeuralNetwork = NULL;
+
+	NeuralNetworkErrorCode returnValue = createNeuralNetwork(&myNeuralNetwork, myState->numberOfInputs, myState->numberOfHiddenLayers, myState->numberOfOutputs);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = destroyNeuralNetwork(&myNeuralNetwork);
+
+	return returnValue;
+}
+
+static NeuralNetworkErrorCode benchmarkSaveJson(BenchmarkState *myState)
+{
+	return saveNeuralNetwork(myState->jsonFilePath, myState->myNeuralNetwork);
+}
+
+//The loaded neural network is destroyed inside the timed operation
+static NeuralNetworkErrorCode loadAndDestroy(char *filePath)
+{
+	NeuralNetwork *myNeuralNetwork = NULL;
+
+	NeuralNetworkErrorCode returnValue = loadNeuralNetwork(filePath, &myNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = destroyNeuralNetwork(&myNeuralNetwork);
+
+	return returnValue;
+}
+
+static NeuralNetworkErrorCode benchmarkLoadJson(BenchmarkState *myState)
+{
+	return loadAndDestroy(myState->jsonFilePath);
+}
+
+static NeuralNetworkErrorCode benchmarkSaveBinary(BenchmarkState *myState)
+{
+	return saveNeuralNetwork(myState->binaryFilePath, myState->myNeuralNetwork);
+}
+
+static NeuralNetworkErrorCode benchmarkLoadBinary(BenchmarkState *myState)
+{
+	return loadAndDestroy(myState->binaryFilePath);
+}
+
+//The save operations come first, so each load reads the file written by its save
+static const BenchmarkOperation operationArray[] =
+{
+	{"computeNeuralNetworkOutput", benchmarkComputeOutput, false},
+	{"cloneNeuralNetwork", benchmarkClone, false},
+	{"mutateNeuralNetwork", benchmarkMutate, false},
+	{"createDestroyNeuralNetwork", benchmarkCreateDestroy, false},
+	{"saveNeuralNetworkJson", benchmarkSaveJson, true},
+	{"loadNeuralNetworkJson", benchmarkLoadJson, true},
+	{"saveNeuralNetworkBinary", benchmarkSaveBinary, true},
+	{"loadNeuralNetworkBinary", benchmarkLoadBinary, true}
+};
+
+#define BENCHMARK_NUMBER_OF_OPERATIONS ((int) (sizeof(operationArray) / sizeof(operationArray[0])))
+
+//Report
+
+static NeuralNetworkErrorCode addResult(JsonWriter *myJsonWriter, const BenchmarkOperation *myOperation, const BenchmarkState *myState,
+										long long numberOfWeights, int iterationsPerSample, double *sampleArray, int numberOfSamples)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	BenchmarkStatistics myStatistics;
+
+	computeBenchmarkStatistics(sampleArray, numberOfSamples, &myStatistics);
+
+	fprintf(stderr, "%-28s %5d inputs %3d hidden layers: %14.1f ns\n", myOperation->name, myState->numberOfInputs, myState->numberOfHiddenLayers, myStatistics.median);
+
+	returnValue = beginJsonObject(myJsonWriter);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonStringMember(myJsonWriter, "operation", myOperation->name);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonIntegerMember(myJsonWriter, "numberOfInputs", myState->numberOfInputs);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonIntegerMember(myJsonWriter, "numberOfHiddenLayers", myState->numberOfHiddenLayers);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonIntegerMember(myJsonWriter, "numberOfOutputs", myState->numberOfOutputs);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonIntegerMember(myJsonWriter, "numberOfWeights", numberOfWeights);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonIntegerMember(myJsonWriter, "iterationsPerSample", iterationsPerSample);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonRealMember(myJsonWriter, "minimumNanoseconds", myStatistics.minimum);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonRealMember(myJsonWriter, "medianNanoseconds", myStatistics.median);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonRealMember(myJsonWriter, "percentile90Nanoseconds", myStatistics.percentile90);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonRealMember(myJsonWriter, "percentile99Nanoseconds", myStatistics.percentile99);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonRealMember(myJsonWriter, "maximumNanoseconds", myStatistics.maximum);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonRealMember(myJsonWriter, "meanNanoseconds", myStatistics.mean);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonRealMember(myJsonWriter, "operationsPerSecond", BENCHMARK_NANOSECONDS_PER_SECOND / myStatistics.median);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonRealMember(myJsonWriter, "weightsPerSecond", (double) numberOfWeights * BENCHMARK_NANOSECONDS_PER_SECOND / myStatistics.median);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = endJsonObject(myJsonWriter);
+
+	return returnValue;
+}
+
+//Measurement
+
+/*Each sample is the mean time of iterationsPerSample calls, which is chosen after the warmups so
+ *that a sample lasts at least BENCHMARK_MINIMUM_SAMPLE_NANOSECONDS*/
+static NeuralNetworkErrorCode measureOperation(const BenchmarkOperation *myOperation, BenchmarkState *myState, const BenchmarkParameters *myParameters,
+											   double *sampleArray, int *iterationsPerSample)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	double startTime;
+	double elapsedTime = 0;
+
+	for (int i=0; (i<myParameters->warmups) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK); i++)
+		returnValue = myOperation->function(myState);
+
+	//Calibrate
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		startTime = getNanoseconds();
+		returnValue = myOperation->function(myState);
+		elapsedTime = getNanoseconds() - startTime;
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		double iterations = (elapsedTime > 0) ? BENCHMARK_MINIMUM_SAMPLE_NANOSECONDS / elapsedTime : BENCHMARK_MAXIMUM_ITERATIONS_PER_SAMPLE;
+
+		if (iterations < 1)
+			*iterationsPerSample = 1;
+		else if (iterations > BENCHMARK_MAXIMUM_ITERATIONS_PER_SAMPLE)
+			*iterationsPerSample = BENCHMARK_MAXIMUM_ITERATIONS_PER_SAMPLE;
+		else
+			*iterationsPerSample = (int) iterations;
+	}
+
+	for (int i=0; (i<myParameters->repetitions) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK); i++)
+	{
+		startTime = getNanoseconds();
+
+		for (int j=0; (j<*iterationsPerSample) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK); j++)
+			returnValue = myOperation->function(myState);
+
+		sampleArray[i] = (getNanoseconds() - startTime) / *iterationsPerSample;
+	}
+
+	return returnValue;
+}
+
+//Create the neural networks of a size of the grid, with random weights and random inputs
+static NeuralNetworkErrorCode prepareState(BenchmarkState *myState, int numberOfInputs, int numberOfHiddenLayers, uint64_t seed)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	RandomGenerator myGenerator;
+
+	myState->numberOfInputs = numberOfInputs;
+	myState->numberOfHiddenLayers = numberOfHiddenLayers;
+	myState->numberOfOutputs = (numberOfInputs < BENCHMARK_MAXIMUM_NUMBER_OF_OUTPUTS) ? numberOfInputs : BENCHMARK_MAXIMUM_NUMBER_OF_OUTPUTS;
+
+	seedRandomGenerator(&myGenerator, seed);
+
+	returnValue = createNeuralNetwork(&(myState->myNeuralNetwork), numberOfInputs, numberOfHiddenLayers, myState->numberOfOutputs);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = createNeuralNetwork(&(myState->myNeuralNetworkClone), numberOfInputs, numberOfHiddenLayers, myState->numberOfOutputs);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = setNeuralNetworkRandomSeed(myState->myNeuralNetwork, seed);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = randomizeNeuralNetwork(myState->myNeuralNetwork);
+
+	for (int i=0; (i<numberOfInputs) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK); i++)
+		returnValue = setNeuralNetworkInput(myState->myNeuralNetwork, i, (NeuronData) getRandomInteger(&myGenerator, 2));
+
+	return returnValue;
+}
+
+static void releaseState(BenchmarkState *myState)
+{
+	if (myState->myNeuralNetwork!=NULL)
+		destroyNeuralNetwork(&(myState->myNeuralNetwork));
+
+	if (myState->myNeuralNetworkClone!=NULL)
+		destroyNeuralNetwork(&(myState->myNeuralNetworkClone));
+}
+
+static NeuralNetworkErrorCode runSize(JsonWriter *myJsonWriter, BenchmarkState *myState, const BenchmarkParameters *myParameters,
+									  int numberOfInputs, int numberOfHiddenLayers, double *sampleArray)
+{
+	NeuralNetworkErrorCode returnValue = prepareState(myState, numberOfInputs, numberOfHiddenLayers, myParameters->seed);
+
+	long long numberOfWeights = ((long long) numberOfHiddenLayers * numberOfInputs + myState->numberOfOutputs) * numberOfInputs;
+
+	for (int i=0; (i<BENCHMARK_NUMBER_OF_OPERATIONS) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK); i++)
+	{
+		const BenchmarkOperation *myOperation = &operationArray[i];
+
+		if ((!myOperation->isFileOperation) || (numberOfWeights<=myParameters->maximumFileWeights))
+		{
+			int iterationsPerSample = 1;
+
+			returnValue = measureOperation(myOperation, myState, myParameters, sampleArray, &iterationsPerSample);
+
+			if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+				returnValue = addResult(myJsonWriter, myOperation, myState, numberOfWeights, iterationsPerSample, sampleArray, myParameters->repetitions);
+		}
+	}
+
+	releaseState(myState);
+
+	return returnValue;
+}
+
+static NeuralNetworkErrorCode addHeader(JsonWriter *myJsonWriter, const BenchmarkParameters *myParameters)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	NeuralNetwork *myNeuralNetwork = NULL;
+	NeuralNetworkEngine myEngine = NEURAL_NETWORK_ENGINE_BINARY;
+	NeuronKernel myKernel = NEURON_KERNEL_SCALAR;
+
+	//The engine and the kernel are the defaults of a new neural network
+	returnValue = createNeuralNetwork(&myNeuralNetwork, NEURAL_NETWORK_MINIMUM_NUMBER_OF_INPUTS, NEURAL_NETWORK_MINIMUM_NUMBER_OF_HIDDEN_LAYERS, NEURAL_NETWORK_MINIMUM_NUMBER_OF_NEURONS_PER_LAYER);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getNeuralNetworkEngine(myNeuralNetwork, &myEngine);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getNeuralNetworkKernel(myNeuralNetwork, &myKernel);
+
+	if (myNeuralNetwork!=NULL)
+		destroyNeuralNetwork(&myNeuralNetwork);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonStringMember(myJsonWriter, "label", myParameters->label);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonIntegerMember(myJsonWriter, "timestamp", (long long) time(NULL));
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonStringMember(myJsonWriter, "engine", engineNameArray[myEngine]);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonStringMember(myJsonWriter, "kernel", kernelNameArray[myKernel]);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonIntegerMember(myJsonWriter, "warmups", myParameters->warmups);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonIntegerMember(myJsonWriter, "repetitions", myParameters->repetitions);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonIntegerMember(myJsonWriter, "maximumFileWeights", myParameters->maximumFileWeights);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonIntegerMember(myJsonWriter, "seed", (long long) myParameters->seed);
+
+	return returnValue;
+}
+
+static NeuralNetworkErrorCode runBenchmark(const BenchmarkParameters *myParameters)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	BenchmarkState myState = {0};
+	JsonWriter *myJsonWriter = NULL;
+	double *sampleArray = NULL;
+
+	const char *temporaryDirectory = getenv("TMPDIR");
+
+	if ((temporaryDirectory==NULL) || (temporaryDirectory[0]=='\0'))
+		temporaryDirectory = "/tmp";
+
+	snprintf(myState.jsonFilePath, BENCHMARK_MAXIMUM_PATH_LENGTH, "%s/T-Rex-benchmark-%ld.json", temporaryDirectory, (long) getpid());
+	snprintf(myState.binaryFilePath, BENCHMARK_MAXIMUM_PATH_LENGTH, "%s/T-Rex-benchmark-%ld%s", temporaryDirectory, (long) getpid(), BINARY_FORMAT_FILE_EXTENSION);
+
+	sampleArray = malloc(sizeof(double) * myParameters->repetitions);
+
+	if (sampleArray==NULL)
+		returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = createJsonWriter(&myJsonWriter, myParameters->outputFilePath);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = beginJsonObject(myJsonWriter);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addHeader(myJsonWriter, myParameters);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = setJsonMemberName(myJsonWriter, "results");
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = beginJsonArray(myJsonWriter);
+
+	for (int i=0; (i<myParameters->numberOfInputSizes) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK); i++)
+	{
+		for (int j=0; (j<myParameters->numberOfHiddenLayerSizes) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK); j++)
+			returnValue = runSize(myJsonWriter, &myState, myParameters, myParameters->inputArray[i], myParameters->hiddenLayerArray[j], sampleArray);
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = endJsonArray(myJsonWriter);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = endJsonObject(myJsonWriter);
+
+	if (myJsonWriter!=NULL)
+	{
+		NeuralNetworkErrorCode result = destroyJsonWriter(&myJsonWriter);
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			returnValue = result;
+	}
+
+	releaseState(&myState);
+
+	remove(myState.jsonFilePath);
+	remove(myState.binaryFilePath);
+
+	free(sampleArray);
+
+	return returnValue;
+}
+
+//Parameters
+
+static bool parseInteger(const char *text, long long minimumValue, long long maximumValue, long long *value)
+{
+	char *end;
+
+	errno = 0;
+	*value = strtoll(text, &end, 10);
+
+	return (errno==0) && (end!=text) && (*end=='\0') && (*value>=minimumValue) && (*value<=maximumValue);
+}
+
+//Parse a comma separated list of integers
+static bool parseIntegerList(const char *text, long long minimumValue, long long maximumValue, int *valueArray, int *numberOfValues)
+{
+	char buffer[BENCHMARK_MAXIMUM_PATH_LENGTH];
+	bool isValid = (strlen(text) < sizeof(buffer));
+
+	*numberOfValues = 0;
+
+	if (isValid)
+	{
+		char *savePointer = NULL;
+
+		strcpy(buffer, text);
+
+		for (char *token = strtok_r(buffer, ",", &savePointer); (token!=NULL) && (isValid); token = strtok_r(NULL, ",", &savePointer))
+		{
+			long long value;
+
+			isValid = (*numberOfValues < BENCHMARK_MAXIMUM_NUMBER_OF_SIZES) && (parseInteger(token, minimumValue, maximumValue, &value));
+
+			if (isValid)
+				valueArray[(*numberOfValues)++] = (int) value;
+		}
+	}
+
+	return (isValid) && (*numberOfValues > 0);
+}
+
+static bool parseParameters(int argc, char *argv[], BenchmarkParameters *myParameters)
+{
+	bool isValid = true;
+
+	myParameters->numberOfInputSizes = (int) (sizeof(defaultInputArray) / sizeof(defaultInputArray[0]));
+	memcpy(myParameters->inputArray, defaultInputArray, sizeof(defaultInputArray));
+
+	myParameters->numberOfHiddenLayerSizes = (int) (sizeof(defaultHiddenLayerArray) / sizeof(defaultHiddenLayerArray[0]));
+	memcpy(myParameters->hiddenLayerArray, defaultHiddenLayerArray, sizeof(defaultHiddenLayerArray));
+
+	myParameters->warmups = BENCHMARK_DEFAULT_WARMUPS;
+	myParameters->repetitions = BENCHMARK_DEFAULT_REPETITIONS;
+	myParameters->maximumFileWeights = BENCHMARK_DEFAULT_MAXIMUM_FILE_WEIGHTS;
+	myParameters->seed = BENCHMARK_DEFAULT_SEED;
+	myParameters->outputFilePath = BENCHMARK_DEFAULT_OUTPUT_FILE;
+	myParameters->label = BENCHMARK_DEFAULT_LABEL;
+
+	for (int i=1; (i<argc) && (isValid); i+=2)
+	{
+		long long value = 0;
+
+		if (i + 1 == argc)
+			isValid = false;
+		else if (strcmp(argv[i], "--inputs")==0)
+			isValid = parseIntegerList(argv[i + 1], NEURAL_NETWORK_MINIMUM_NUMBER_OF_INPUTS, INT_MAX, myParameters->inputArray, &myParameters->numberOfInputSizes);
+		else if (strcmp(argv[i], "--hidden-layers")==0)
+			isValid = parseIntegerList(argv[i + 1], NEURAL_NETWORK_MINIMUM_NUMBER_OF_HIDDEN_LAYERS, INT_MAX, myParameters->hiddenLayerArray, &myParameters->numberOfHiddenLayerSizes);
+		else if (strcmp(argv[i], "--warmups")==0)
+		{
+			isValid = parseInteger(argv[i + 1], 0, INT_MAX, &value);
+			myParameters->warmups = (int) value;
+		}
+		else if (strcmp(argv[i], "--repetitions")==0)
+		{
+			isValid = parseInteger(argv[i + 1], 1, INT_MAX, &value);
+			myParameters->repetitions = (int) value;
+		}
+		else if (strcmp(argv[i], "--maximum-file-weights")==0)
+		{
+			isValid = parseInteger(argv[i + 1], 0, LLONG_MAX, &value);
+			myParameters->maximumFileWeights = value;
+		}
+		else if (strcmp(argv[i], "--seed")==0)
+		{
+			isValid = parseInteger(argv[i + 1], 0, LLONG_MAX, &value);
+			myParameters->seed = (uint64_t) value;
+		}
+		else if (strcmp(argv[i], "--output")==0)
+			myParameters->outputFilePath = argv[i + 1];
+		else if (strcmp(argv[i], "--label")==0)
+			myParameters->label = argv[i + 1];
+		else
+			isValid = false;
+	}
+
+	return isValid;
+}
+
+int main(int argc, char *argv[])
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	BenchmarkParameters myParameters;
+
+	if (!parseParameters(argc, argv, &myParameters))
+	{
+		printf("Usage: %s [OPTION VALUE]...\n\n", argv[0]);
+		printf("  --inputs LIST                numbers of inputs, separated by commas (default 8,64,512,4096)\n");
+		printf("  --hidden-layers LIST         numbers of hidden layers, separated by commas (default 1,8,64)\n");
+		printf("  --warmups N                  calls before the measure of each operation (default %d)\n", BENCHMARK_DEFAULT_WARMUPS);
+		printf("  --repetitions N              samples of each operation (default %d)\n", BENCHMARK_DEFAULT_REPETITIONS);
+		printf("  --maximum-file-weights N     largest neural network that is saved and loaded (default %d)\n", BENCHMARK_DEFAULT_MAXIMUM_FILE_WEIGHTS);
+		printf("  --seed N                     seed of the weights and the inputs (default %d)\n", BENCHMARK_DEFAULT_SEED);
+		printf("  --output FILE                json report (default standard output)\n");
+		printf("  --label TEXT                 name of the run, such as the library version\n");
+
+		return EXIT_FAILURE;
+	}
+
+	returnValue = runBenchmark(&myParameters);
+
+	if (returnValue!=NEURAL_NETWORK_RETURN_VALUE_OK)
+		fprintf(stderr, "\nNEURAL NETWORK ERROR CODE: %d\n", returnValue);
+
+	return (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
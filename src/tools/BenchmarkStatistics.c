@@ -0,0 +1,86 @@
+/*
+ * BenchmarkStatistics.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#include "BenchmarkStatistics.h"
+
+static int compareSamples(const void *first, const void *second)
+{
+	double firstSample = *(const double *) first;
+	double secondSample = *(const double *) second;
+
+	return (firstSample > secondSample) - (firstSample < secondSample);
+}
+
+static double getPercentile(const double *sampleArray, int numberOfSamples, int percent)
+{
+	int rank = (percent * numberOfSamples + 99) / 100;
+
+	if (rank < 1)
+		rank = 1;
+
+	return sampleArray[rank - 1];
+}
+
+//The samples are sorted in place, a distribution without samples is all zeros
+void computeBenchmarkStatistics(double *sampleArray, int numberOfSamples, BenchmarkStatistics *myStatistics)
+{
+	memset(myStatistics, 0, sizeof(BenchmarkStatistics));
+
+	if (numberOfSamples > 0)
+	{
+		double sum = 0;
+
+		qsort(sampleArray, numberOfSamples, sizeof(double), compareSamples);
+
+		for (int i=0; i<numberOfSamples; i++)
+			sum += sampleArray[i];
+
+		myStatistics->minimum = sampleArray[0];
+		myStatistics->median = getPercentile(sampleArray, numberOfSamples, 50);
+		myStatistics->percentile90 = getPercentile(sampleArray, numberOfSamples, 90);
+		myStatistics->percentile99 = getPercentile(sampleArray, numberOfSamples, 99);
+		myStatistics->maximum = sampleArray[numberOfSamples - 1];
+		myStatistics->mean = sum / numberOfSamples;
+	}
+}
+
+//Add the distribution as an object member of the current json object
+NeuralNetworkErrorCode addBenchmarkStatistics(JsonWriter *myJsonWriter, const char *memberName, const BenchmarkStatistics *myStatistics)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	if (myStatistics==NULL)
+		returnValue = NEURAL_NETWORK_NULL_POINTER_ERROR;
+	else
+		returnValue = setJsonMemberName(myJsonWriter, memberName);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = beginJsonObject(myJsonWriter);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonRealMember(myJsonWriter, "minimum", myStatistics->minimum);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonRealMember(myJsonWriter, "median", myStatistics->median);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonRealMember(myJsonWriter, "percentile90", myStatistics->percentile90);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonRealMember(myJsonWriter, "percentile99", myStatistics->percentile99);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonRealMember(myJsonWriter, "maximum", myStatistics->maximum);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonRealMember(myJsonWriter, "mean", myStatistics->mean);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = endJsonObject(myJsonWriter);
+
+	return returnValue;
+}
@@ -0,0 +1,27 @@
+/*
+ * BenchmarkStatistics.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: kenshiro
+ */
+
+#ifndef SRC_TOOLS_BENCHMARKSTATISTICS_H_
+#define SRC_TOOLS_BENCHMARKSTATISTICS_H_
+
+#include "../data_tier/JsonWriter.h"
+
+//Distribution of the samples of a measure, the percentiles are nearest-rank
+typedef struct
+{
+	double minimum;
+	double median;
+	double percentile90;
+	double percentile99;
+	double maximum;
+	double mean;
+} BenchmarkStatistics;
+
+void computeBenchmarkStatistics(double *sampleArray, int numberOfSamples, BenchmarkStatistics *myStatistics);
+NeuralNetworkErrorCode addBenchmarkStatistics(JsonWriter *myJsonWriter, const char *memberName, const BenchmarkStatistics *myStatistics);
+
+#endif /* SRC_TOOLS_BENCHMARKSTATISTICS_H_ */
@@ -0,0 +1,590 @@
+/*
+ ============================================================================
+ Name        : BenchmarkTraining
+ Author      : Kenshiro
+ Copyright   : GNU General Public License (GPLv3)
+ Description : Time how long the evolution of the examples takes to reach
+               the target score over many fixed seeds
+ ============================================================================
+ */
+
+#include "../examples/XorExample.h"
+#include "../examples/TicTacToe.h"
+#include "../examples/EightQueensPuzzle.h"
+#include "../logic_tier/PortfolioEvolver.h"
+#include "BenchmarkStatistics.h"
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#define TRAINING_BENCHMARK_DEFAULT_NUMBER_OF_SEEDS 10
+#define TRAINING_BENCHMARK_DEFAULT_FIRST_SEED 1
+#define TRAINING_BENCHMARK_DEFAULT_MAXIMUM_NUMBER_OF_GENERATIONS 100000
+#define TRAINING_BENCHMARK_DEFAULT_OUTPUT_FILE "/dev/stdout"
+#define TRAINING_BENCHMARK_DEFAULT_LABEL ""
+
+#define TRAINING_BENCHMARK_MAXIMUM_LIST_LENGTH 256
+#define TRAINING_BENCHMARK_NANOSECONDS_PER_SECOND 1000000000.0
+
+typedef NeuralNetworkErrorCode (*ExampleParametersFunction)(EvolverParameters *myParameters);
+
+typedef struct
+{
+	const char *name;
+	ExampleParametersFunction parametersFunction;
+} TrainingExample;
+
+static const TrainingExample exampleArray[] =
+{
+	{"xor", initializeXorExampleParameters},
+	{"tictactoe", initializeTicTacToeParameters},
+	{"eightqueens", initializeEightQueensPuzzleParameters}
+};
+
+#define TRAINING_BENCHMARK_NUMBER_OF_EXAMPLES ((int) (sizeof(exampleArray) / sizeof(exampleArray[0])))
+
+/*Result of the training of an example with a seed. The generations of all the evolutionary
+ *branches are added up, without the evaluation of the initial parents of each branch*/
+typedef struct
+{
+	NeuralNetworkErrorCode returnValue;
+	bool isSolved;
+	int fitnessScore;
+	long long numberOfGenerations;
+	long long numberOfEvaluations;
+	long long numberOfFitnessCacheHits;
+	long long numberOfFitnessCacheMisses;
+	int numberOfRestarts;
+	double wallNanoseconds;
+	long peakResidentSetKilobytes;
+} TrainingRun;
+
+typedef struct
+{
+	bool isExampleSelectedArray[TRAINING_BENCHMARK_NUMBER_OF_EXAMPLES];
+	int numberOfSeeds;
+	uint64_t firstSeed;
+	int maximumNumberOfGenerations;
+	int numberOfChildren;
+	int numberOfThreads;
+	int numberOfBranches;
+	int fitnessCacheSize;
+	const char *outputFilePath;
+	const char *label;
+} TrainingBenchmarkParameters;
+
+static inline double getNanoseconds(void)
+{
+	struct timespec myTime;
+
+	clock_gettime(CLOCK_MONOTONIC, &myTime);
+
+	return (double) myTime.tv_sec * TRAINING_BENCHMARK_NANOSECONDS_PER_SECOND + (double) myTime.tv_nsec;
+}
+
+//Training
+
+static void recordProgress(const EvolverProgress *myProgress, void *userData)
+{
+	TrainingRun *myRun = userData;
+
+	if (myProgress->generationNumber > 0)
+		myRun->numberOfGenerations++;
+
+	myRun->numberOfEvaluations = myProgress->numberOfEvaluations;
+	myRun->numberOfFitnessCacheHits = myProgress->numberOfFitnessCacheHits;
+	myRun->numberOfFitnessCacheMisses = myProgress->numberOfFitnessCacheMisses;
+	myRun->numberOfRestarts = myProgress->numberOfRestarts;
+}
+
+static NeuralNetworkErrorCode trainExample(const TrainingExample *myExample, const TrainingBenchmarkParameters *myParameters, uint64_t seed, TrainingRun *myRun)
+{
+	EvolverParameters myEvolverParameters;
+
+	NeuralNetwork *myNeuralNetwork = NULL;
+	Evolver *myEvolver = NULL;
+
+	double startTime = 0;
+
+	NeuralNetworkErrorCode returnValue = myExample->parametersFunction(&myEvolverParameters);
+
+	//The example runs headless with the seed of the run
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		myEvolverParameters.randomSeed = seed;
+		myEvolverParameters.maximumNumberOfGenerations = myParameters->maximumNumberOfGenerations;
+		myEvolverParameters.progressFunction = recordProgress;
+		myEvolverParameters.userData = myRun;
+
+		if (myParameters->numberOfChildren > 0)
+			myEvolverParameters.numberOfChildren = myParameters->numberOfChildren;
+
+		if (myParameters->numberOfThreads > 0)
+			myEvolverParameters.numberOfThreads = myParameters->numberOfThreads;
+
+		if (myParameters->fitnessCacheSize>=0)
+			myEvolverParameters.fitnessCacheSize = myParameters->fitnessCacheSize;
+
+		returnValue = createNeuralNetworkWithTopology(&myNeuralNetwork, myEvolverParameters.numberOfInputs, myEvolverParameters.numberOfHiddenLayers,
+													  myEvolverParameters.hiddenLayerWidthArray, myEvolverParameters.numberOfOutputs, myEvolverParameters.connectivity);
+	}
+
+	//The starting neural network also takes its weights from the seed, so every run can be repeated
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = setNeuralNetworkRandomSeed(myNeuralNetwork, seed);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = randomizeNeuralNetwork(myNeuralNetwork);
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (myParameters->numberOfBranches==0))
+		returnValue = createEvolver(&myEvolver, &myEvolverParameters);
+
+	//With branches the wall time is the time of the first branch that reaches the target score
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		startTime = getNanoseconds();
+
+		if (myParameters->numberOfBranches==0)
+			returnValue = runEvolver(myEvolver, myNeuralNetwork, &(myRun->fitnessScore));
+		else
+			returnValue = runPortfolioEvolver(&myEvolverParameters, myParameters->numberOfBranches, myNeuralNetwork, &(myRun->fitnessScore));
+
+		myRun->wallNanoseconds = getNanoseconds() - startTime;
+		myRun->isSolved = (myRun->fitnessScore>=myEvolverParameters.targetFitnessScore);
+	}
+
+	if (myEvolver!=NULL)
+		destroyEvolver(&myEvolver);
+
+	if (myNeuralNetwork!=NULL)
+		destroyNeuralNetwork(&myNeuralNetwork);
+
+	return returnValue;
+}
+
+/*Each run is trained in a child process, so the peak resident set size of the run is not mixed up
+ *with the previous runs. The child sends its result through a pipe*/
+static NeuralNetworkErrorCode runTrainingProcess(const TrainingExample *myExample, const TrainingBenchmarkParameters *myParameters, uint64_t seed, TrainingRun *myRun)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	int pipeArray[2];
+	pid_t childProcess = -1;
+
+	memset(myRun, 0, sizeof(TrainingRun));
+
+	if (pipe(pipeArray)!=0)
+		returnValue = NEURAL_NETWORK_THREAD_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		fflush(NULL);
+
+		childProcess = fork();
+
+		if (childProcess<0)
+		{
+			close(pipeArray[0]);
+			close(pipeArray[1]);
+
+			returnValue = NEURAL_NETWORK_THREAD_ERROR;
+		}
+	}
+
+	if (childProcess==0)
+	{
+		close(pipeArray[0]);
+
+		myRun->returnValue = trainExample(myExample, myParameters, seed, myRun);
+
+		_exit((write(pipeArray[1], myRun, sizeof(TrainingRun))==(ssize_t) sizeof(TrainingRun)) ? EXIT_SUCCESS : EXIT_FAILURE);
+	}
+
+	if (childProcess>0)
+	{
+		struct rusage myUsage;
+		int status = 0;
+
+		memset(&myUsage, 0, sizeof(myUsage));
+
+		close(pipeArray[1]);
+
+		ssize_t result = read(pipeArray[0], myRun, sizeof(TrainingRun));
+
+		close(pipeArray[0]);
+
+		if ((wait4(childProcess, &status, 0, &myUsage)!=childProcess) || (!WIFEXITED(status)) || (WEXITSTATUS(status)!=EXIT_SUCCESS) ||
+			(result!=(ssize_t) sizeof(TrainingRun)))
+
+			returnValue = NEURAL_NETWORK_THREAD_ERROR;
+		else
+			returnValue = myRun->returnValue;
+
+		//The size is in kilobytes on Linux
+		myRun->peakResidentSetKilobytes = myUsage.ru_maxrss;
+	}
+
+	return returnValue;
+}
+
+//Report
+
+static NeuralNetworkErrorCode addRun(JsonWriter *myJsonWriter, uint64_t seed, const TrainingRun *myRun)
+{
+	NeuralNetworkErrorCode returnValue = beginJsonObject(myJsonWriter);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonIntegerMember(myJsonWriter, "seed", (long long) seed);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonBooleanMember(myJsonWriter, "isSolved", myRun->isSolved);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonIntegerMember(myJsonWriter, "fitnessScore", myRun->fitnessScore);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonIntegerMember(myJsonWriter, "generations", myRun->numberOfGenerations);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonIntegerMember(myJsonWriter, "evaluations", myRun->numberOfEvaluations);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonIntegerMember(myJsonWriter, "fitnessCacheHits", myRun->numberOfFitnessCacheHits);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonIntegerMember(myJsonWriter, "fitnessCacheMisses", myRun->numberOfFitnessCacheMisses);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonIntegerMember(myJsonWriter, "restarts", myRun->numberOfRestarts);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonRealMember(myJsonWriter, "wallNanoseconds", myRun->wallNanoseconds);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonIntegerMember(myJsonWriter, "peakResidentSetKilobytes", myRun->peakResidentSetKilobytes);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = endJsonObject(myJsonWriter);
+
+	return returnValue;
+}
+
+/*The distributions of generations, evaluations and wall time only include the solved runs, the
+ *peak resident set size includes all of them*/
+static NeuralNetworkErrorCode addDistributions(JsonWriter *myJsonWriter, const TrainingRun *runArray, int numberOfRuns, double *sampleArray)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	BenchmarkStatistics myStatistics;
+
+	int numberOfSolvedRuns = 0;
+	int i;
+
+	for (i=0; i<numberOfRuns; i++)
+	{
+		if (runArray[i].isSolved)
+			sampleArray[numberOfSolvedRuns++] = (double) runArray[i].numberOfGenerations;
+	}
+
+	computeBenchmarkStatistics(sampleArray, numberOfSolvedRuns, &myStatistics);
+	returnValue = addBenchmarkStatistics(myJsonWriter, "generations", &myStatistics);
+
+	for (i=0, numberOfSolvedRuns=0; i<numberOfRuns; i++)
+	{
+		if (runArray[i].isSolved)
+			sampleArray[numberOfSolvedRuns++] = (double) runArray[i].numberOfEvaluations;
+	}
+
+	computeBenchmarkStatistics(sampleArray, numberOfSolvedRuns, &myStatistics);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addBenchmarkStatistics(myJsonWriter, "evaluations", &myStatistics);
+
+	for (i=0, numberOfSolvedRuns=0; i<numberOfRuns; i++)
+	{
+		if (runArray[i].isSolved)
+			sampleArray[numberOfSolvedRuns++] = runArray[i].wallNanoseconds;
+	}
+
+	computeBenchmarkStatistics(sampleArray, numberOfSolvedRuns, &myStatistics);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addBenchmarkStatistics(myJsonWriter, "wallNanoseconds", &myStatistics);
+
+	for (i=0; i<numberOfRuns; i++)
+		sampleArray[i] = (double) runArray[i].peakResidentSetKilobytes;
+
+	computeBenchmarkStatistics(sampleArray, numberOfRuns, &myStatistics);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addBenchmarkStatistics(myJsonWriter, "peakResidentSetKilobytes", &myStatistics);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonIntegerMember(myJsonWriter, "solvedRuns", numberOfSolvedRuns);
+
+	return returnValue;
+}
+
+static NeuralNetworkErrorCode benchmarkExample(JsonWriter *myJsonWriter, const TrainingExample *myExample, const TrainingBenchmarkParameters *myParameters,
+											   TrainingRun *runArray, double *sampleArray)
+{
+	NeuralNetworkErrorCode returnValue = beginJsonObject(myJsonWriter);
+
+	int i;
+
+	for (i=0; (i<myParameters->numberOfSeeds) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK); i++)
+	{
+		uint64_t seed = myParameters->firstSeed + (uint64_t) i;
+
+		returnValue = runTrainingProcess(myExample, myParameters, seed, &runArray[i]);
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		{
+			fprintf(stderr, "%-12s seed %-6llu %-8s %10lld generations %14.3f s %8ld KiB\n", myExample->name, (unsigned long long) seed,
+					runArray[i].isSolved ? "solved" : "unsolved", runArray[i].numberOfGenerations,
+					runArray[i].wallNanoseconds / TRAINING_BENCHMARK_NANOSECONDS_PER_SECOND, runArray[i].peakResidentSetKilobytes);
+		}
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonStringMember(myJsonWriter, "example", myExample->name);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonIntegerMember(myJsonWriter, "runs", myParameters->numberOfSeeds);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addDistributions(myJsonWriter, runArray, myParameters->numberOfSeeds, sampleArray);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = setJsonMemberName(myJsonWriter, "runArray");
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = beginJsonArray(myJsonWriter);
+
+	for (i=0; (i<myParameters->numberOfSeeds) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK); i++)
+		returnValue = addRun(myJsonWriter, myParameters->firstSeed + (uint64_t) i, &runArray[i]);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = endJsonArray(myJsonWriter);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = endJsonObject(myJsonWriter);
+
+	return returnValue;
+}
+
+static NeuralNetworkErrorCode runTrainingBenchmark(const TrainingBenchmarkParameters *myParameters)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	JsonWriter *myJsonWriter = NULL;
+
+	TrainingRun *runArray = malloc(sizeof(TrainingRun) * myParameters->numberOfSeeds);
+	double *sampleArray = malloc(sizeof(double) * myParameters->numberOfSeeds);
+
+	if ((runArray==NULL) || (sampleArray==NULL))
+		returnValue = NEURAL_NETWORK_MEMORY_ALLOCATION_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = createJsonWriter(&myJsonWriter, myParameters->outputFilePath);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = beginJsonObject(myJsonWriter);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonStringMember(myJsonWriter, "label", myParameters->label);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonIntegerMember(myJsonWriter, "timestamp", (long long) time(NULL));
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonIntegerMember(myJsonWriter, "firstSeed", (long long) myParameters->firstSeed);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonIntegerMember(myJsonWriter, "maximumNumberOfGenerations", myParameters->maximumNumberOfGenerations);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonIntegerMember(myJsonWriter, "numberOfChildren", myParameters->numberOfChildren);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonIntegerMember(myJsonWriter, "numberOfThreads", myParameters->numberOfThreads);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = addJsonIntegerMember(myJsonWriter, "numberOfBranches", myParameters->numberOfBranches);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = setJsonMemberName(myJsonWriter, "exampleArray");
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = beginJsonArray(myJsonWriter);
+
+	for (int i=0; (i<TRAINING_BENCHMARK_NUMBER_OF_EXAMPLES) && (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK); i++)
+	{
+		if (myParameters->isExampleSelectedArray[i])
+			returnValue = benchmarkExample(myJsonWriter, &exampleArray[i], myParameters, runArray, sampleArray);
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = endJsonArray(myJsonWriter);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = endJsonObject(myJsonWriter);
+
+	if (myJsonWriter!=NULL)
+	{
+		NeuralNetworkErrorCode result = destroyJsonWriter(&myJsonWriter);
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			returnValue = result;
+	}
+
+	free(runArray);
+	free(sampleArray);
+
+	return returnValue;
+}
+
+//Parameters
+
+static bool parseInteger(const char *text, long long minimumValue, long long maximumValue, long long *value)
+{
+	char *end;
+
+	errno = 0;
+	*value = strtoll(text, &end, 10);
+
+	return (errno==0) && (end!=text) && (*end=='\0') && (*value>=minimumValue) && (*value<=maximumValue);
+}
+
+//Parse a comma separated list of example names
+static bool parseExampleList(const char *text, bool *isExampleSelectedArray)
+{
+	char buffer[TRAINING_BENCHMARK_MAXIMUM_LIST_LENGTH];
+	bool isValid = (strlen(text) < sizeof(buffer));
+
+	memset(isExampleSelectedArray, 0, sizeof(bool) * TRAINING_BENCHMARK_NUMBER_OF_EXAMPLES);
+
+	if (isValid)
+	{
+		char *savePointer = NULL;
+
+		strcpy(buffer, text);
+
+		for (char *token = strtok_r(buffer, ",", &savePointer); (token!=NULL) && (isValid); token = strtok_r(NULL, ",", &savePointer))
+		{
+			int exampleIndex = 0;
+
+			while ((exampleIndex<TRAINING_BENCHMARK_NUMBER_OF_EXAMPLES) && (strcmp(token, exampleArray[exampleIndex].name)!=0))
+				exampleIndex++;
+
+			isValid = (exampleIndex<TRAINING_BENCHMARK_NUMBER_OF_EXAMPLES);
+
+			if (isValid)
+				isExampleSelectedArray[exampleIndex] = true;
+		}
+	}
+
+	return isValid;
+}
+
+static bool parseParameters(int argc, char *argv[], TrainingBenchmarkParameters *myParameters)
+{
+	bool isValid = true;
+
+	for (int i=0; i<TRAINING_BENCHMARK_NUMBER_OF_EXAMPLES; i++)
+		myParameters->isExampleSelectedArray[i] = true;
+
+	myParameters->numberOfSeeds = TRAINING_BENCHMARK_DEFAULT_NUMBER_OF_SEEDS;
+	myParameters->firstSeed = TRAINING_BENCHMARK_DEFAULT_FIRST_SEED;
+	myParameters->maximumNumberOfGenerations = TRAINING_BENCHMARK_DEFAULT_MAXIMUM_NUMBER_OF_GENERATIONS;
+	myParameters->numberOfChildren = 0;
+	myParameters->numberOfThreads = 0;
+	myParameters->numberOfBranches = 0;
+	myParameters->fitnessCacheSize = -1;
+	myParameters->outputFilePath = TRAINING_BENCHMARK_DEFAULT_OUTPUT_FILE;
+	myParameters->label = TRAINING_BENCHMARK_DEFAULT_LABEL;
+
+	for (int i=1; (i<argc) && (isValid); i+=2)
+	{
+		long long value = 0;
+
+		if (i + 1 == argc)
+			isValid = false;
+		else if (strcmp(argv[i], "--examples")==0)
+			isValid = parseExampleList(argv[i + 1], myParameters->isExampleSelectedArray);
+		else if (strcmp(argv[i], "--seeds")==0)
+		{
+			isValid = parseInteger(argv[i + 1], 1, INT_MAX, &value);
+			myParameters->numberOfSeeds = (int) value;
+		}
+		else if (strcmp(argv[i], "--first-seed")==0)
+		{
+			isValid = parseInteger(argv[i + 1], 0, LLONG_MAX, &value);
+			myParameters->firstSeed = (uint64_t) value;
+		}
+		else if (strcmp(argv[i], "--maximum-generations")==0)
+		{
+			isValid = parseInteger(argv[i + 1], 0, INT_MAX, &value);
+			myParameters->maximumNumberOfGenerations = (int) value;
+		}
+		else if (strcmp(argv[i], "--children")==0)
+		{
+			isValid = parseInteger(argv[i + 1], EVOLVER_MINIMUM_NUMBER_OF_CHILDREN, INT_MAX, &value);
+			myParameters->numberOfChildren = (int) value;
+		}
+		else if (strcmp(argv[i], "--threads")==0)
+		{
+			isValid = parseInteger(argv[i + 1], EVOLVER_MINIMUM_NUMBER_OF_THREADS, INT_MAX, &value);
+			myParameters->numberOfThreads = (int) value;
+		}
+		else if (strcmp(argv[i], "--branches")==0)
+		{
+			isValid = parseInteger(argv[i + 1], 0, PORTFOLIO_EVOLVER_MAXIMUM_NUMBER_OF_BRANCHES, &value);
+			myParameters->numberOfBranches = (int) value;
+		}
+		else if (strcmp(argv[i], "--fitness-cache")==0)
+		{
+			isValid = parseInteger(argv[i + 1], 0, INT_MAX, &value);
+			myParameters->fitnessCacheSize = (int) value;
+		}
+		else if (strcmp(argv[i], "--output")==0)
+			myParameters->outputFilePath = argv[i + 1];
+		else if (strcmp(argv[i], "--label")==0)
+			myParameters->label = argv[i + 1];
+		else
+			isValid = false;
+	}
+
+	return isValid;
+}
+
+int main(int argc, char *argv[])
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	TrainingBenchmarkParameters myParameters;
+
+	if (!parseParameters(argc, argv, &myParameters))
+	{
+		printf("Usage: %s [OPTION VALUE]...\n\n", argv[0]);
+		printf("  --examples LIST              examples separated by commas: xor, tictactoe, eightqueens (default all)\n");
+		printf("  --seeds N                    runs of each example, one per seed (default %d)\n", TRAINING_BENCHMARK_DEFAULT_NUMBER_OF_SEEDS);
+		printf("  --first-seed N               seed of the first run, the next runs use the next seeds (default %d)\n", TRAINING_BENCHMARK_DEFAULT_FIRST_SEED);
+		printf("  --maximum-generations N      generations before a run is given up, 0 means no limit (default %d)\n", TRAINING_BENCHMARK_DEFAULT_MAXIMUM_NUMBER_OF_GENERATIONS);
+		printf("  --children N                 children per generation (default one per processor)\n");
+		printf("  --threads N                  threads of the evolver (default one per processor)\n");
+		printf("  --branches N                 race N evolutionary branches, generations and evaluations of the first one (default 0, one evolver)\n");
+		printf("  --fitness-cache N            fitness scores kept by the evolver, 0 disables the cache (default of each example)\n");
+		printf("  --output FILE                json report (default standard output)\n");
+		printf("  --label TEXT                 name of the run, such as the library version\n");
+
+		return EXIT_FAILURE;
+	}
+
+	returnValue = runTrainingBenchmark(&myParameters);
+
+	if (returnValue!=NEURAL_NETWORK_RETURN_VALUE_OK)
+		fprintf(stderr, "\nNEURAL NETWORK ERROR CODE: %d\n", returnValue);
+
+	return (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
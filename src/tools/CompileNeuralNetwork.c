@@ -0,0 +1,374 @@
+/*
+ ============================================================================
+ Name        : CompileNeuralNetwork
+ Author      : Kenshiro
+ Copyright   : GNU General Public License (GPLv3)
+ Description : Generate a standalone C source file that computes the output of a trained neural network
+ ============================================================================
+ */
+
+#include "../data_tier/DataManager.h"
+
+#include <inttypes.h>
+#include <ctype.h>
+
+#define MINIMUM_NUMBER_OF_ARGUMENTS 3
+#define MAXIMUM_NUMBER_OF_ARGUMENTS 4
+
+#define DEFAULT_FUNCTION_PREFIX "model"
+#define MAXIMUM_FUNCTION_PREFIX_LENGTH 64
+
+#define VARIABLE_NAME_SIZE 32
+
+//The prefix of the generated functions must be a C identifier
+static bool isValidFunctionPrefix(const char *functionPrefix)
+{
+	size_t length = strlen(functionPrefix);
+	bool isValid = (length>0) && (length<=MAXIMUM_FUNCTION_PREFIX_LENGTH) && (!isdigit((unsigned char) functionPrefix[0]));
+
+	for (size_t i=0; (i<length) && (isValid); i++)
+		isValid = isalnum((unsigned char) functionPrefix[i]) || (functionPrefix[i]=='_');
+
+	return isValid;
+}
+
+//The terms of a sum of masked popcounts are separated by " + ", an empty sum is 0
+static void writeMaskedPopcount(FILE *myFile, const char *functionPrefix, const char *arrayName, int wordIndex, uint64_t mask, bool *isFirstTerm)
+{
+	fprintf(myFile, "%s%s_popcount(%s[%d]", (*isFirstTerm) ? "" : " + ", functionPrefix, arrayName, wordIndex);
+
+	if (mask!=UINT64_MAX)
+		fprintf(myFile, " & UINT64_C(0x%016" PRIx64 ")", mask);
+
+	fprintf(myFile, ")");
+
+	*isFirstTerm = false;
+}
+
+/*A neuron is written as one statement that sets its output bit. The words without positive weights
+ *are left out of the sum, and a neuron that can never be active is not written at all, because the
+ *output words start cleared*/
+static NeuralNetworkErrorCode writeNeuron(FILE *myFile, const char *functionPrefix, Neuron *myNeuron, int neuronIndex, const char *inputName, const char *outputName,
+								  bool *isWritten)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	uint64_t *packedWeightArray = NULL;
+	const uint64_t *connectionMask = NULL;
+
+	int numberOfInputs = 0;
+	int numberOfWords = 0;
+
+	NeuronErrorCode result = getNumberOfInputs(myNeuron, &numberOfInputs);
+
+	if (result==NEURON_RETURN_VALUE_OK)
+		result = getNeuronPackedWeights(myNeuron, &packedWeightArray, &numberOfWords);
+
+	if (result==NEURON_RETURN_VALUE_OK)
+		result = getNeuronConnectionMask(myNeuron, &connectionMask);
+
+	if (result!=NEURON_RETURN_VALUE_OK)
+		returnValue = NEURAL_NETWORK_NEURON_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		int numberOfInputWords = NEURON_DATA_NUMBER_OF_WORDS(numberOfInputs);
+		bool hasPositiveWeights = false;
+		bool isFirstTerm = true;
+
+		for (int i=0; i<numberOfInputWords; i++)
+			hasPositiveWeights = hasPositiveWeights || (packedWeightArray[i]!=0);
+
+		if (hasPositiveWeights)
+		{
+			fprintf(myFile, "\t\t%s[%d] |= (uint64_t) (2*(", outputName, neuronIndex / NEURON_DATA_BITS_PER_WORD);
+
+			for (int i=0; i<numberOfInputWords; i++)
+			{
+				if (packedWeightArray[i]!=0)
+					writeMaskedPopcount(myFile, functionPrefix, inputName, i, packedWeightArray[i], &isFirstTerm);
+			}
+
+			fprintf(myFile, ") > ");
+
+			//A dense neuron uses the active inputs of the layer, a sparse neuron only counts its connected inputs
+			if (connectionMask==NULL)
+			{
+				fprintf(myFile, "activeInputs");
+			}
+			else
+			{
+				isFirstTerm = true;
+
+				fprintf(myFile, "(");
+
+				for (int i=0; i<numberOfInputWords; i++)
+				{
+					if (connectionMask[i]!=0)
+						writeMaskedPopcount(myFile, functionPrefix, inputName, i, connectionMask[i], &isFirstTerm);
+				}
+
+				fprintf(myFile, ")");
+			}
+
+			fprintf(myFile, ") << %d;\n", neuronIndex % NEURON_DATA_BITS_PER_WORD);
+		}
+
+		*isWritten = hasPositiveWeights;
+	}
+
+	return returnValue;
+}
+
+static NeuralNetworkErrorCode writeNeuralLayer(FILE *myFile, const char *functionPrefix, NeuralLayer *myNeuralLayer, const char *layerName,
+											   int numberOfInputs, bool isSparse, const char *inputName, const char *outputName)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	int numberOfNeurons = 0;
+	int neuronIndex = 0;
+
+	bool isAnyNeuronWritten = false;
+
+	if (getNumberOfNeurons(myNeuralLayer, &numberOfNeurons)!=NEURON_RETURN_VALUE_OK)
+		returnValue = NEURAL_NETWORK_NEURON_ERROR;
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		fprintf(myFile, "\t//%s: %d inputs, %d neurons\n", layerName, numberOfInputs, numberOfNeurons);
+		fprintf(myFile, "\t{\n");
+
+		//The bits after the last input are ignored
+		if (!isSparse)
+		{
+			int numberOfInputWords = NEURON_DATA_NUMBER_OF_WORDS(numberOfInputs);
+			int lastWordBits = numberOfInputs % NEURON_DATA_BITS_PER_WORD;
+			bool isFirstTerm = true;
+
+			fprintf(myFile, "\t\tconst int activeInputs = ");
+
+			for (int i=0; i<numberOfInputWords; i++)
+			{
+				uint64_t mask = ((i==numberOfInputWords - 1) && (lastWordBits!=0)) ? (UINT64_C(1) << lastWordBits) - 1 : UINT64_MAX;
+
+				writeMaskedPopcount(myFile, functionPrefix, inputName, i, mask, &isFirstTerm);
+			}
+
+			fprintf(myFile, ";\n\n");
+		}
+	}
+
+	while ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (neuronIndex<numberOfNeurons))
+	{
+		Neuron *myNeuron = NULL;
+		bool isWritten = false;
+
+		if (getNeuron(myNeuralLayer, neuronIndex, &myNeuron)!=NEURON_RETURN_VALUE_OK)
+			returnValue = NEURAL_NETWORK_NEURON_ERROR;
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			returnValue = writeNeuron(myFile, functionPrefix, myNeuron, neuronIndex, inputName, outputName, &isWritten);
+
+		isAnyNeuronWritten = isAnyNeuronWritten || isWritten;
+		neuronIndex++;
+	}
+
+	//A layer whose neurons are never active does not read its input, which must not trigger unused variable warnings
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (!isAnyNeuronWritten))
+		fprintf(myFile, "\t\t(void) %s;\n", isSparse ? inputName : "activeInputs");
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		fprintf(myFile, "\t}\n");
+
+	return returnValue;
+}
+
+/*The generated file only needs stdint.h. Each neural layer is unrolled into one statement per neuron
+ *with its weights as constant masks, so the inference has no loops, no branches and no data to load*/
+static NeuralNetworkErrorCode writeSourceFile(FILE *myFile, NeuralNetwork *myNeuralNetwork, const char *modelFilePath, const char *functionPrefix)
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	NeuralNetworkConnectivity connectivity = NEURAL_NETWORK_CONNECTIVITY_DENSE;
+	NeuralLayer *myNeuralLayer = NULL;
+	NeuronData *dummy = NULL;
+
+	const int *hiddenLayerWidthArray = NULL;
+
+	int numberOfInputs = 0;
+	int numberOfHiddenLayers = 0;
+	int numberOfOutputs = 0;
+	int numberOfLayerInputs = 0;
+
+	char layerName[VARIABLE_NAME_SIZE];
+	char inputName[VARIABLE_NAME_SIZE];
+	char outputName[VARIABLE_NAME_SIZE];
+
+	returnValue = getInputLayer(myNeuralNetwork, &dummy, &numberOfInputs);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getHiddenLayerWidthArray(myNeuralNetwork, &hiddenLayerWidthArray, &numberOfHiddenLayers);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getNeuralNetworkNumberOfOutputs(myNeuralNetwork, &numberOfOutputs);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getNeuralNetworkConnectivity(myNeuralNetwork, &connectivity);
+
+	//Header, popcount and function signature
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		fprintf(myFile, "/*\n");
+		fprintf(myFile, " * Generated by compileNeuralNetwork from %s\n", modelFilePath);
+		fprintf(myFile, " *\n");
+		fprintf(myFile, " * %s_infer computes the output of the neural network. Input i is bit i %% 64 of in[i / 64], with\n", functionPrefix);
+		fprintf(myFile, " * %d inputs in %d 64-bit word(s), and output i is bit i %% 64 of out[i / 64], with %d outputs in %d word(s).\n",
+				numberOfInputs, NEURON_DATA_NUMBER_OF_WORDS(numberOfInputs), numberOfOutputs, NEURON_DATA_NUMBER_OF_WORDS(numberOfOutputs));
+		fprintf(myFile, " * The bits after the last input are ignored and the bits after the last output are cleared.\n");
+		fprintf(myFile, " * Build this file with -mpopcnt or -march=native so the popcounts use the popcnt instruction.\n");
+		fprintf(myFile, " */\n\n");
+
+		fprintf(myFile, "#include <stdint.h>\n\n");
+
+		fprintf(myFile, "void %s_infer(const uint64_t *in, uint64_t *out);\n\n", functionPrefix);
+
+		fprintf(myFile, "static inline int %s_popcount(uint64_t word)\n{\n", functionPrefix);
+		fprintf(myFile, "#ifdef __GNUC__\n");
+		fprintf(myFile, "\treturn __builtin_popcountll(word);\n");
+		fprintf(myFile, "#else\n");
+		fprintf(myFile, "\tword = word - ((word >> 1) & UINT64_C(0x5555555555555555));\n");
+		fprintf(myFile, "\tword = (word & UINT64_C(0x3333333333333333)) + ((word >> 2) & UINT64_C(0x3333333333333333));\n");
+		fprintf(myFile, "\tword = (word + (word >> 4)) & UINT64_C(0x0F0F0F0F0F0F0F0F);\n\n");
+		fprintf(myFile, "\treturn (int) ((word * UINT64_C(0x0101010101010101)) >> 56);\n");
+		fprintf(myFile, "#endif\n");
+		fprintf(myFile, "}\n\n");
+
+		fprintf(myFile, "void %s_infer(const uint64_t *in, uint64_t *out)\n{\n", functionPrefix);
+
+		for (int i=0; i<numberOfHiddenLayers; i++)
+			fprintf(myFile, "\tuint64_t layer%d[%d] = {0};\n", i + 1, NEURON_DATA_NUMBER_OF_WORDS(hiddenLayerWidthArray[i]));
+
+		fprintf(myFile, "\n");
+
+		for (int i=0; i<NEURON_DATA_NUMBER_OF_WORDS(numberOfOutputs); i++)
+			fprintf(myFile, "\tout[%d] = 0;\n", i);
+
+		fprintf(myFile, "\n");
+	}
+
+	//Hidden layers, each one fed by the previous one
+	numberOfLayerInputs = numberOfInputs;
+
+	for (int i=0; (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (i<numberOfHiddenLayers); i++)
+	{
+		returnValue = getHiddenLayer(myNeuralNetwork, i, &myNeuralLayer);
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		{
+			snprintf(layerName, sizeof(layerName), "Hidden layer %d", i + 1);
+			if (i==0)
+				snprintf(inputName, sizeof(inputName), "in");
+			else
+				snprintf(inputName, sizeof(inputName), "layer%d", i);
+
+			snprintf(outputName, sizeof(outputName), "layer%d", i + 1);
+
+			returnValue = writeNeuralLayer(myFile, functionPrefix, myNeuralLayer, layerName, numberOfLayerInputs,
+										   connectivity==NEURAL_NETWORK_CONNECTIVITY_SPARSE, inputName, outputName);
+		}
+
+		if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+			fprintf(myFile, "\n");
+
+		numberOfLayerInputs = hiddenLayerWidthArray[i];
+	}
+
+	//Output layer
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = getOutputLayer(myNeuralNetwork, &myNeuralLayer, &numberOfOutputs);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		snprintf(inputName, sizeof(inputName), "layer%d", numberOfHiddenLayers);
+
+		returnValue = writeNeuralLayer(myFile, functionPrefix, myNeuralLayer, "Output layer", numberOfLayerInputs,
+									   connectivity==NEURAL_NETWORK_CONNECTIVITY_SPARSE, inputName, "out");
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		fprintf(myFile, "}\n");
+
+	return returnValue;
+}
+
+int main(int argc, char *argv[])
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	NeuralNetwork *myNeuralNetwork = NULL;
+	FILE *myFile = NULL;
+
+	const char *functionPrefix = DEFAULT_FUNCTION_PREFIX;
+
+	int errorLine = 0;
+	int errorColumn = 0;
+
+	if ((argc<MINIMUM_NUMBER_OF_ARGUMENTS) || (argc>MAXIMUM_NUMBER_OF_ARGUMENTS))
+	{
+		printf("Usage: %s MODEL_FILE SOURCE_FILE [FUNCTION_PREFIX]\n\n", argv[0]);
+		printf("Generate a C source file with the function FUNCTION_PREFIX_infer (default: %s_infer), which computes\n", DEFAULT_FUNCTION_PREFIX);
+		printf("the output of the neural network of MODEL_FILE with its weights as constants\n");
+
+		returnValue = NEURAL_NETWORK_FILE_LOAD_ERROR;
+	}
+	else if (argc==MAXIMUM_NUMBER_OF_ARGUMENTS)
+	{
+		functionPrefix = argv[3];
+	}
+
+	if ((returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) && (!isValidFunctionPrefix(functionPrefix)))
+	{
+		printf("The function prefix must be a C identifier of up to %d characters\n", MAXIMUM_FUNCTION_PREFIX_LENGTH);
+
+		returnValue = NEURAL_NETWORK_FILE_SAVE_ERROR;
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = loadNeuralNetworkWithErrorPosition(argv[1], &myNeuralNetwork, &errorLine, &errorColumn);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		myFile = fopen(argv[2], "w");
+
+		if (myFile==NULL)
+			returnValue = NEURAL_NETWORK_FILE_SAVE_ERROR;
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = writeSourceFile(myFile, myNeuralNetwork, argv[1], functionPrefix);
+
+	//The write errors are reported by ferror and fclose
+	if (myFile!=NULL)
+	{
+		bool isWriteOk = (ferror(myFile)==0);
+
+		if ((fclose(myFile)!=0) || (!isWriteOk))
+		{
+			if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+				returnValue = NEURAL_NETWORK_FILE_SAVE_ERROR;
+		}
+	}
+
+	if (myNeuralNetwork!=NULL)
+		destroyNeuralNetwork(&myNeuralNetwork);
+
+	if (returnValue!=NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		printf("\nNEURAL NETWORK ERROR CODE: %d\n", returnValue);
+
+		if (errorLine>0)
+			printf("%s: line %d, column %d\n", argv[1], errorLine, errorColumn);
+	}
+
+	return (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,49 @@
+/*
+ ============================================================================
+ Name        : ConvertNeuralNetwork
+ Author      : Kenshiro
+ Copyright   : GNU General Public License (GPLv3)
+ Description : Convert a neural network file between the json and the binary formats
+ ============================================================================
+ */
+
+#include "../data_tier/DataManager.h"
+
+#define NUMBER_OF_ARGUMENTS 3
+
+int main(int argc, char *argv[])
+{
+	NeuralNetworkErrorCode returnValue = NEURAL_NETWORK_RETURN_VALUE_OK;
+
+	NeuralNetwork *myNeuralNetwork = NULL;
+
+	int errorLine = 0;
+	int errorColumn = 0;
+
+	if (argc!=NUMBER_OF_ARGUMENTS)
+	{
+		printf("Usage: %s SOURCE_FILE DESTINATION_FILE\n\n", argv[0]);
+		printf("The format of each file is selected by its extension: %s files are binary, any other file is json\n", BINARY_FORMAT_FILE_EXTENSION);
+
+		returnValue = NEURAL_NETWORK_FILE_LOAD_ERROR;
+	}
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = loadNeuralNetworkWithErrorPosition(argv[1], &myNeuralNetwork, &errorLine, &errorColumn);
+
+	if (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK)
+		returnValue = saveNeuralNetwork(argv[2], myNeuralNetwork);
+
+	if (myNeuralNetwork!=NULL)
+		destroyNeuralNetwork(&myNeuralNetwork);
+
+	if (returnValue!=NEURAL_NETWORK_RETURN_VALUE_OK)
+	{
+		printf("\nNEURAL NETWORK ERROR CODE: %d\n", returnValue);
+
+		if (errorLine>0)
+			printf("%s: line %d, column %d\n", argv[1], errorLine, errorColumn);
+	}
+
+	return (returnValue==NEURAL_NETWORK_RETURN_VALUE_OK) ? EXIT_SUCCESS : EXIT_FAILURE;
+}